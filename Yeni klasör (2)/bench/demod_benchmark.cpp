@@ -0,0 +1,113 @@
+// Çok kanallı demodülasyon verim ölçümü
+//
+// Kullanım: demod_benchmark [milyon örnek]
+// 40 MS/s IQ kaydı üzerinde 1, 8, 32 ve 128 kanal için DemodulatorBank ile
+// kanal başına ayrı Demodulator (her biri tam hızdan kanallaştırır)
+// karşılaştırılır. Verim giriş MS/s ve gerçek zamana oranla yazdırılır.
+
+#include "demodulatorbank.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+std::vector<DemodulatorBank::Channel> makeChannels(int count, double sampleRate)
+{
+    // Kanallar bandın %90'ına rastgele (ama tekrarlanabilir) dağıtılır
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> offset(-0.45 * sampleRate, 0.45 * sampleRate);
+
+    std::vector<DemodulatorBank::Channel> channels(count);
+    for (int i = 0; i < count; ++i) {
+        channels[i].offset = offset(rng);
+        channels[i].bandwidth = 10e3;
+        channels[i].mode = i % 2 ? Demodulator::Mode::FM : Demodulator::Mode::AM;
+    }
+    return channels;
+}
+
+template <typename Fn>
+double measure(Fn&& fn)
+{
+    fn();  // Isınma
+    const int runs = 3;
+    const auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < runs; ++r) {
+        fn();
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / runs;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    const long long samples = (argc > 1 ? std::atoll(argv[1]) : 4) * 1000000LL;
+    const double sampleRate = 40e6;
+    const int blockSize = 16384;
+
+    // Gürültü içinde birkaç taşıyıcı
+    std::vector<std::complex<float>> iq(samples);
+    std::mt19937 rng(1234);
+    std::normal_distribution<float> noise(0.0f, 0.01f);
+    for (long long i = 0; i < samples; ++i) {
+        double re = noise(rng), im = noise(rng);
+        for (double f : {-12.3e6, 1.0e6, 7.7e6}) {
+            const double phase = 2.0 * M_PI * f * i / sampleRate;
+            re += std::cos(phase);
+            im += std::sin(phase);
+        }
+        iq[i] = std::complex<float>(static_cast<float>(re), static_cast<float>(im));
+    }
+
+    const double realtime = samples / sampleRate;
+    std::printf("%lld örnek (%.2f s @ 40 MS/s), %d örneklik bloklar, 10 kHz kanallar\n",
+                samples, realtime, blockSize);
+    std::printf("%8s %8s %14s %12s %14s %12s\n", "kanal", "altbant",
+                "banka MS/s", "banka xRT", "ayrı MS/s", "ayrı xRT");
+
+    for (int count : {1, 8, 32, 128}) {
+        const auto channels = makeChannels(count, sampleRate);
+
+        DemodulatorBank bank;
+        bank.setSampleRate(sampleRate);
+        bank.setChannels(channels);
+
+        const double bankSeconds = measure([&] {
+            for (long long i = 0; i < samples; i += blockSize) {
+                bank.process(iq.data() + i, static_cast<int>(std::min<long long>(blockSize, samples - i)));
+            }
+        });
+
+        // Karşılaştırma: kanal başına bağımsız tam hızlı Demodulator
+        std::vector<std::unique_ptr<Demodulator>> separate;
+        for (const auto& ch : channels) {
+            auto demod = std::make_unique<Demodulator>();
+            demod->setSampleRate(sampleRate);
+            demod->setMode(ch.mode);
+            demod->setBandwidth(ch.bandwidth);
+            demod->setFrequency(ch.offset);
+            separate.push_back(std::move(demod));
+        }
+        std::vector<float> audio(separate.front()->maxAudioSamples(blockSize));
+
+        const double separateSeconds = measure([&] {
+            for (long long i = 0; i < samples; i += blockSize) {
+                const int n = static_cast<int>(std::min<long long>(blockSize, samples - i));
+                for (auto& demod : separate) {
+                    demod->demodulate(iq.data() + i, n, audio.data());
+                }
+            }
+        });
+
+        std::printf("%8d %8d %14.1f %12.2f %14.1f %12.2f\n", count, bank.filterbankBins(),
+                    samples / bankSeconds / 1e6, realtime / bankSeconds,
+                    samples / separateSeconds / 1e6, realtime / separateSeconds);
+    }
+
+    return 0;
+}
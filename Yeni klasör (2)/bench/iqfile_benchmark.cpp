@@ -0,0 +1,128 @@
+// Belleğe eşlenmiş IQ kaydı tarama hızı
+//
+// Kullanım: iqfile_benchmark [GB] [dosya]
+// Dosya verilmezse geçerli dizinde istenen boyutta (varsayılan 20 GB)
+// bir IQ kaydı yazılır, ölçümden sonra silinir. IQFileReader ile dosya
+// 1 M örneklik pencerelerle baştan sona taranır (her örneğin gücü
+// toplanır), ardından rastgele konumlardan 64 K örneklik pencereler
+// okunur. Kayıt RAM'den büyükse tarama disk hızını ölçer; küçükse
+// ikinci ve sonraki çalıştırmalar sayfa önbelleğinden okur.
+
+#include "iqfilereader.h"
+#include <QFile>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool writeCapture(const QString& filename, quint64 sampleCount)
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    IQFileHeader header;
+    header.sampleRate = 40e6;
+    header.centerFreq = 1e9;
+    header.sampleCount = sampleCount;
+    char bytes[IQFileHeader::SIZE];
+    header.write(bytes);
+    if (file.write(bytes, sizeof(bytes)) != qint64(sizeof(bytes)))
+        return false;
+
+    // 8 MB'lık blok tekrar tekrar yazılır; içerik taramayı etkilemez
+    std::vector<std::complex<float>> chunk(1 << 20);
+    for (size_t i = 0; i < chunk.size(); ++i) {
+        chunk[i] = std::complex<float>(static_cast<float>(i & 1023) * 1e-3f, -1e-3f);
+    }
+    for (quint64 written = 0; written < sampleCount;) {
+        const qint64 count = qint64(std::min<quint64>(chunk.size(), sampleCount - written));
+        const qint64 bytesToWrite = count * qint64(sizeof(std::complex<float>));
+        if (file.write(reinterpret_cast<const char*>(chunk.data()), bytesToWrite) != bytesToWrite)
+            return false;
+        written += quint64(count);
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    const double gigabytes = argc > 1 ? std::atof(argv[1]) : 20.0;
+    const bool ownFile = argc <= 2;
+    const QString filename = ownFile ? QString("iqfile_benchmark.iq") : QString(argv[2]);
+    const double bytesPerSample = sizeof(std::complex<float>);
+
+    if (ownFile) {
+        const quint64 sampleCount = quint64(gigabytes * 1e9 / bytesPerSample);
+        std::printf("%.1f GB kayıt yazılıyor...\n", gigabytes);
+        const auto start = std::chrono::steady_clock::now();
+        if (!writeCapture(filename, sampleCount)) {
+            std::printf("Yazılamadı: %s\n", qPrintable(filename));
+            QFile::remove(filename);
+            return 1;
+        }
+        std::printf("yazma: %.2f GB/s\n", sampleCount * bytesPerSample / secondsSince(start) / 1e9);
+    }
+
+    IQFileReader reader;
+    if (!reader.open(filename)) {
+        std::printf("Açılamadı: %s\n", qPrintable(reader.errorString()));
+        return 1;
+    }
+    const quint64 total = reader.sampleCount();
+    std::printf("%llu örnek (%.2f GB), %.1f MS/s\n", static_cast<unsigned long long>(total),
+                total * bytesPerSample / 1e9, reader.sampleRate() / 1e6);
+
+    // Sıralı tarama
+    {
+        constexpr qint64 window = 1 << 20;
+        double power = 0.0;
+        const auto start = std::chrono::steady_clock::now();
+        for (quint64 first = 0; first < total; first += window) {
+            const IQFileReader::Span span = reader.samples(first, window);
+            float sum = 0.0f;
+            for (qint64 i = 0; i < span.count; ++i) {
+                sum += std::norm(span.data[i]);
+            }
+            power += sum;
+        }
+        const double seconds = secondsSince(start);
+        std::printf("sıralı tarama: %.2f s, %.2f GB/s, %.0f MS/s (ortalama güç %.3g)\n",
+                    seconds, total * bytesPerSample / seconds / 1e9, total / seconds / 1e6,
+                    total ? power / total : 0.0);
+    }
+
+    // Rastgele pencereler
+    {
+        constexpr qint64 window = 1 << 16;
+        constexpr int reads = 2000;
+        std::mt19937_64 rng(1);
+        double power = 0.0;
+        const auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < reads && total > 0; ++r) {
+            const IQFileReader::Span span = reader.samples(rng() % total, window);
+            for (qint64 i = 0; i < span.count; ++i) {
+                power += std::norm(span.data[i]);
+            }
+        }
+        const double seconds = secondsSince(start);
+        std::printf("rastgele %d x %lld örnek: %.1f ms/pencere (%.3g)\n", reads,
+                    static_cast<long long>(window), seconds / reads * 1e3, power);
+    }
+
+    reader.close();
+    if (ownFile) {
+        QFile::remove(filename);
+    }
+    return 0;
+}
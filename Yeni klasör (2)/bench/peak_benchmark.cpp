@@ -0,0 +1,106 @@
+// Spur/tepe arama süresi
+//
+// Kullanım: peak_benchmark [bin sayısı] [tekrar]
+// Gürültü tabanı eğimli, içinde tonlar bulunan bir trace üzerinde
+// PeakDetector farklı ayarlarla çalıştırılır. Karşılaştırma için eski
+// findSpurs döngüsü (her tepe için max_element) küçük bir trace'te
+// ölçülür; bin sayısıyla karesel büyüdüğü için büyük trace'te çalıştırılmaz.
+
+#include "peakdetector.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+std::vector<double> makeTrace(int bins)
+{
+    std::vector<double> trace(bins);
+    std::mt19937 rng(1234);
+    std::normal_distribution<double> noise(0.0, 2.0);
+    for (int i = 0; i < bins; ++i) {
+        trace[i] = -100.0 + 10.0 * i / bins + noise(rng);
+    }
+    // Her ~10000 binde bir ton, genlikleri farklı
+    for (int i = 5000, k = 0; i < bins; i += 10007, ++k) {
+        trace[i] = -60.0 + (k % 40);
+    }
+    return trace;
+}
+
+// Eski Analyzer::findSpurs: her yerel maksimum için global max yeniden aranır
+int legacySpurCount(const std::vector<double>& amps, double threshold)
+{
+    int count = 0;
+    double sink = 0.0;
+    for (size_t i = 1; i + 1 < amps.size(); ++i) {
+        if (amps[i] > threshold && amps[i] > amps[i - 1] && amps[i] > amps[i + 1]) {
+            sink += amps[i] - *std::max_element(amps.begin(), amps.end());
+            ++count;
+        }
+    }
+    return sink > 0.0 ? -1 : count;
+}
+
+template <typename F>
+double timeRuns(int runs, F&& f)
+{
+    f();  // Isınma (tamponlar hazırlanır)
+    const auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < runs; ++r) {
+        f();
+    }
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count() / runs;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    const int bins = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    const int runs = argc > 2 ? std::atoi(argv[2]) : 20;
+    const std::vector<double> trace = makeTrace(bins);
+    PeakDetector detector;
+
+    struct Case {
+        const char* name;
+        PeakSearchSettings settings;
+    };
+    std::vector<Case> cases(4);
+    cases[0].name = "yerel maks.";
+    cases[1].name = "excursion 6 dB";
+    cases[1].settings.excursion = 6.0;
+    cases[2].name = "taban + 20 dB, K=50";
+    cases[2].settings.relativeToFloor = true;
+    cases[2].settings.floorOffset = 20.0;
+    cases[2].settings.maxPeaks = 50;
+    cases[3].name = "yerel, mesafe 64, K=100";
+    cases[3].settings.minDistance = 64;
+    cases[3].settings.maxPeaks = 100;
+
+    std::printf("%d bin, %d tekrar\n", bins, runs);
+    std::printf("%-26s %10s %10s\n", "ayar", "ms", "tepe");
+    for (const Case& c : cases) {
+        const double ms = timeRuns(runs, [&] {
+            detector.find(trace.data(), bins, c.settings);
+        });
+        std::printf("%-26s %10.3f %10zu\n", c.name, ms, detector.peaks().size());
+    }
+
+    // Eski döngü: yalnızca küçük trace'te
+    const int smallBins = std::min(bins, 16384);
+    const std::vector<double> small(trace.begin(), trace.begin() + smallBins);
+    PeakSearchSettings local;
+    local.threshold = -200.0;
+    int legacyPeaks = 0;
+    const double legacyMs = timeRuns(1, [&] { legacyPeaks = legacySpurCount(small, -200.0); });
+    const double newMs = timeRuns(runs, [&] { detector.find(small.data(), smallBins, local); });
+    std::printf("\n%d bin, eski findSpurs: %.3f ms (%d tepe), PeakDetector: %.3f ms (%zu tepe)\n",
+                smallBins, legacyMs, legacyPeaks, newMs, detector.peaks().size());
+
+    return 0;
+}
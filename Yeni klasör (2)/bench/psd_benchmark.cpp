@@ -0,0 +1,67 @@
+// Çok thread'li Welch PSD ölçeklenme ölçümü
+//
+// Kullanım: psd_benchmark [milyon örnek] [maks thread]
+// Her thread sayısı için aynı kayıt üzerinde PSD hesaplanır; verim,
+// 1 thread'e göre hızlanma ve sonucun bit düzeyinde aynı olup olmadığı
+// yazdırılır.
+
+#include "analyzer.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+int main(int argc, char *argv[])
+{
+    const long long samples = (argc > 1 ? std::atoll(argv[1]) : 32) * 1000000LL;
+    const int maxThreads = argc > 2 ? std::atoi(argv[2]) : 16;
+    const double sampleRate = 40e6;
+
+    // Gürültü içinde tek ton
+    std::vector<std::complex<float>> iq(samples);
+    std::mt19937 rng(1234);
+    std::normal_distribution<float> noise(0.0f, 0.01f);
+    for (long long i = 0; i < samples; ++i) {
+        const double phase = 2.0 * M_PI * 1.25e6 * i / sampleRate;
+        iq[i] = std::complex<float>(static_cast<float>(std::cos(phase)) + noise(rng),
+                                    static_cast<float>(std::sin(phase)) + noise(rng));
+    }
+
+    Analyzer analyzer;
+    QVector<double> reference;
+    double baseline = 0.0;
+
+    std::printf("%lld örnek, FFT 4096, Hann, %%50 örtüşme\n", samples);
+    std::printf("%8s %12s %10s %10s\n", "thread", "MS/s", "hızlanma", "aynı");
+
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        analyzer.setThreadCount(threads);
+        QVector<double> psd;
+
+        // Isınma (plan, pencere ve tamponlar hazırlanır)
+        analyzer.calculatePSD(iq.data(), iq.size(), sampleRate, psd);
+
+        const int runs = 3;
+        const auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < runs; ++r) {
+            analyzer.calculatePSD(iq.data(), iq.size(), sampleRate, psd);
+        }
+        const double seconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count() / runs;
+
+        if (threads == 1) {
+            reference = psd;
+            baseline = seconds;
+        }
+        const bool identical = psd.size() == reference.size()
+            && std::memcmp(psd.constData(), reference.constData(),
+                           sizeof(double) * psd.size()) == 0;
+
+        std::printf("%8d %12.1f %10.2f %10s\n", threads, samples / seconds / 1e6,
+                    baseline / seconds, identical ? "evet" : "HAYIR");
+    }
+
+    return 0;
+}
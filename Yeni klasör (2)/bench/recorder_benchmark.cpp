@@ -0,0 +1,110 @@
+// Sürekli IQ kaydı: sürdürülebilir hız ve atlanan bloklar
+//
+// Kullanım: recorder_benchmark [saniye] [dizin] [direct|buffered] [cf32|ci16|ci8]
+// Kayıt sırasındaki IQ akış döngüsünü (AcquisitionWorker, araya sweep
+// girmeden) taklit eden döngü IQRecorder'a bitişik 16384 örneklik
+// blokları önce cihazın gerçek zamanlı 40 MS/s hızında (320 MB/s),
+// ardından beklemeden olabildiğince hızlı verir. Her aşamada diske yazılan hız,
+// atlanan bloklar ve en uzun submit() süresi yazdırılır; submit()
+// diski beklemediğinden en uzun süre blok kopyası mertebesinde kalmalıdır.
+// "direct" verilirse veri dosyası O_DIRECT ile açılır. ci16/ci8 kompakt
+// kaydı (en hızlı kullanılabilir sıkıştırmayla) seçer; "disk MB/s"
+// sütunu cf32 hızıyla ("MB/s") karşılaştırılarak kazanç görülür. Kayıt
+// dosyaları ölçümden sonra silinir.
+
+#include "iqrecorder.h"
+#include <QFile>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int BLOCK_SIZE = 16384;
+constexpr double SAMPLE_RATE = 40e6;
+
+struct Result {
+    double seconds{0.0};
+    double maxSubmit{0.0};
+};
+
+// pace: true ise bloklar örnekleme hızında verilir
+Result feed(IQRecorder& recorder, const std::vector<std::complex<float>>& block,
+            double seconds, bool pace)
+{
+    using Clock = std::chrono::steady_clock;
+    const auto blockTime = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(BLOCK_SIZE / SAMPLE_RATE));
+    const auto start = Clock::now();
+    const auto end = start + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(seconds));
+
+    Result result;
+    auto next = start;
+    while (Clock::now() < end) {
+        if (pace) {
+            next += blockTime;
+            std::this_thread::sleep_until(next);
+        }
+        const auto before = Clock::now();
+        recorder.submit(block.data(), BLOCK_SIZE);
+        result.maxSubmit = std::max(result.maxSubmit,
+            std::chrono::duration<double>(Clock::now() - before).count());
+    }
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    const double seconds = argc > 1 ? std::atof(argv[1]) : 10.0;
+    const QString directory = argc > 2 ? QString(argv[2]) : QString(".");
+    IQRecorderOptions options;
+    options.directIO = argc > 3 && std::strcmp(argv[3], "direct") == 0;
+    if (argc > 4 && std::strcmp(argv[4], "cf32") != 0) {
+        options.encoding.format = std::strcmp(argv[4], "ci8") == 0 ? IQSampleFormat::CI8
+                                                                   : IQSampleFormat::CI16;
+        options.encoding.compression = IQCodec::isAvailable(IQCompression::LZ4)
+            ? IQCompression::LZ4 : IQCompression::DeltaVarint;
+    }
+    options.description = QStringLiteral("recorder_benchmark");
+
+    std::vector<std::complex<float>> block(BLOCK_SIZE);
+    for (int i = 0; i < BLOCK_SIZE; ++i) {
+        block[i] = std::complex<float>(static_cast<float>(i) * 1e-4f, -1e-3f);
+    }
+
+    std::printf("%-14s %8s %10s %10s %10s %10s %12s\n", "aşama", "süre s", "MS/s", "MB/s",
+                "disk MB/s", "atlanan", "en uzun µs");
+    for (const bool pace : {true, false}) {
+        const QString base = directory + QStringLiteral("/recorder_benchmark");
+        IQRecorder recorder;
+        if (!recorder.startRecording(base, SAMPLE_RATE, 1e9, options)) {
+            std::printf("Kayıt başlatılamadı: %s\n", qPrintable(recorder.errorString()));
+            return 1;
+        }
+        const Result result = feed(recorder, block, seconds, pace);
+        recorder.stopRecording();
+
+        // Yazma süresi durdurma sırasındaki son tamponları da içerir
+        const double samples = double(recorder.samplesWritten());
+        std::printf("%-14s %8.2f %10.1f %10.1f %10.1f %10llu %12.1f%s\n",
+                    pace ? "40 MS/s" : "sınırsız", result.seconds,
+                    samples / result.seconds / 1e6,
+                    samples * sizeof(std::complex<float>) / result.seconds / 1e6,
+                    double(recorder.bytesWritten()) / result.seconds / 1e6,
+                    static_cast<unsigned long long>(recorder.blocksDropped()),
+                    result.maxSubmit * 1e6, recorder.isDirectIO() ? " (O_DIRECT)" : "");
+
+        QFile::remove(recorder.dataPath());
+        QFile::remove(base + QStringLiteral(".sigmf-meta"));
+    }
+
+    return 0;
+}
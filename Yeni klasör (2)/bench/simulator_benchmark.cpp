@@ -0,0 +1,96 @@
+// Sinyal simülatörü üretim hızı
+//
+// Kullanım: simulator_benchmark [blok örnek sayısı] [tekrar]
+// SignalSimulator'ın tek çekirdekte ürettiği örnek hızı (MS/s) üç sahne
+// için ölçülür: yalnız gürültü, varsayılan sahne faz gürültüsüz ve faz
+// gürültülü. Gerçek zamanlı çalışma için 40 MS/s'in üstünde olmalıdır.
+// Ardından cihaz arayüzünün IQ ve sweep hızları (simülatör + FFT +
+// birleştirme) yazdırılır. Cihaz IQ'yu örnekleme hızında verdiğinden
+// bb_fetch_iq_data satırı ayarlı hıza (varsayılan 40 MS/s) eşit çıkmalı;
+// altındaysa simülatör gerçek zamana yetişmiyordur.
+
+#include "bb_api.h"
+#include "signalsimulator.h"
+#include "sweep.h"
+#include "sweepplanner.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+double measureScene(const SimulatorScene& scene, std::vector<std::complex<float>>& buffer, int runs)
+{
+    constexpr double sampleRate = 40e6;
+    SignalSimulator simulator;
+    simulator.setScene(scene);
+    simulator.generate(1e9, sampleRate, buffer.data(), static_cast<int>(buffer.size()));  // Isınma
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < runs; ++r) {
+        simulator.generate(1e9, sampleRate, buffer.data(), static_cast<int>(buffer.size()));
+    }
+    return runs * static_cast<double>(buffer.size()) / secondsSince(start);
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    const int blockSize = argc > 1 ? std::atoi(argv[1]) : 1 << 20;
+    const int runs = argc > 2 ? std::atoi(argv[2]) : 20;
+    std::vector<std::complex<float>> buffer(blockSize);
+
+    SimulatorScene noiseOnly;
+    noiseOnly.phaseNoiseEnabled = false;
+    SimulatorScene withoutPhaseNoise = SimulatorScene::defaultScene();
+    withoutPhaseNoise.phaseNoiseEnabled = false;
+    const SimulatorScene full = SimulatorScene::defaultScene();
+
+    std::printf("%-30s %10s\n", "sahne", "MS/s");
+    std::printf("%-30s %10.1f\n", "yalnız gürültü",
+                measureScene(noiseOnly, buffer, runs) / 1e6);
+    std::printf("%-30s %10.1f\n", "varsayılan, faz gürültüsüz",
+                measureScene(withoutPhaseNoise, buffer, runs) / 1e6);
+    std::printf("%-30s %10.1f\n", "varsayılan, faz gürültülü",
+                measureScene(full, buffer, runs) / 1e6);
+
+    BbDeviceInterface device;
+    device.connect();
+
+    {
+        std::vector<std::complex<float>> iq(BbDeviceInterface::IQ_BLOCK_SIZE);
+        const int blocks = 1000;
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < blocks; ++i) {
+            device.bb_fetch_iq_data(iq.data(), static_cast<int>(iq.size()));
+        }
+        std::printf("\nbb_fetch_iq_data: %.1f MS/s\n",
+                    blocks * static_cast<double>(iq.size()) / secondsSince(start) / 1e6);
+    }
+
+    const double spans[] = {20e6, 100e6, 1e9, 6e9};
+    std::printf("\n%10s %10s %6s %9s %10s\n", "span MHz", "RBW kHz", "segm.", "bin", "sweep ms");
+    for (double span : spans) {
+        device.setCenterFrequency(span / 2 + 9e3);
+        device.setSpan(span);
+        const SweepPlan plan = device.getSweepPlan();
+        device.bb_fetch_sweep();  // Isınma
+
+        const int sweeps = 5;
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < sweeps; ++i) {
+            device.bb_fetch_sweep();
+        }
+        std::printf("%10.1f %10.1f %6d %9d %10.2f\n", span / 1e6, plan.rbw / 1e3,
+                    plan.segmentCount(), plan.outputBins, secondsSince(start) / sweeps * 1e3);
+    }
+
+    return 0;
+}
@@ -0,0 +1,179 @@
+// Sweep aktarımında sweep başına bellek ayırma sayımı
+//
+// Kullanım: sweep_benchmark [sweep sayısı]
+// Eski yol (her sweep için yeni QVector trace, deque kuyruğu ve GUI
+// tarafında genlik kopyası) ile havuzlu SweepPtr yolu (bb_fetch_sweep,
+// sabit halka kuyruk, tutamaçla tüketim) aynı tüketici işiyle
+// karşılaştırılır. glibc'de malloc sarmalanır ve Qt'nin kendi ayırmaları
+// da sayılır; diğer platformlarda yalnızca operator new sayılır.
+
+#include "bb_api.h"
+#include "sweep.h"
+#include "tracedecimator.h"
+#include <QCoreApplication>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <new>
+
+namespace {
+
+std::atomic<long long> allocations{0};
+
+} // namespace
+
+#if defined(__GLIBC__)
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+
+void* malloc(size_t size) noexcept
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) noexcept
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) noexcept
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_realloc(ptr, size);
+}
+}
+static const char* COUNTING = "malloc (Qt dahil)";
+#else
+void* operator new(size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+static const char* COUNTING = "operator new";
+#endif
+
+namespace {
+
+constexpr int QUEUE_CAPACITY = 4;
+constexpr int PLOT_COLUMNS = 1600;
+
+// Eski AcquisitionWorker::SweepData
+struct LegacySweep {
+    quint64 index{0};
+    FrequencyAxisPtr axis;
+    QVector<double> amplitudes;
+};
+
+// Tüketici: GUI'nin sweep başına yaptığı çizim hazırlığı
+double consume(TraceDecimator& decimator, const FrequencyAxis& axis,
+               const QVector<double>& amplitudes)
+{
+    decimator.decimate(axis.values().constData(), amplitudes.constData(),
+                       amplitudes.size(), axis.start(), axis.stop(), PLOT_COLUMNS);
+    return decimator.values().empty() ? 0.0 : decimator.values().front();
+}
+
+template <typename Fn>
+void report(const char* name, int sweeps, Fn&& run)
+{
+    run(sweeps / 10);  // Isınma: havuzlar ve tamponlar dolar
+
+    const long long before = allocations.load();
+    const auto start = std::chrono::steady_clock::now();
+    run(sweeps);
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const long long count = allocations.load() - before;
+
+    std::printf("%-24s %14.3f %14.1f\n", name,
+                static_cast<double>(count) / sweeps, sweeps / seconds);
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    const int sweeps = argc > 1 ? std::atoi(argv[1]) : 20000;
+
+    BbDeviceInterface device;
+    device.connect();
+    // Tek segmentlik span: segment birleştirme değil aktarım yolu ölçülür
+    device.setSpan(20e6);
+
+    TraceDecimator decimator;
+    volatile double sink = 0.0;
+
+    std::printf("%d sweep, %d nokta, kuyruk %d, sayılan: %s\n", sweeps,
+                device.getFrequencyAxis()->size(), QUEUE_CAPACITY, COUNTING);
+    std::printf("%-24s %14s %14s\n", "yol", "ayırma/sweep", "sweep/s");
+
+    // Eski yol: cihaz her sweep için yeni bir trace döndürür, kuyruk
+    // deque'dur, GUI genlikleri kendi QVector'üne alır
+    std::deque<LegacySweep> legacyQueue;
+    QVector<double> amplitudes;
+    report("QVector + deque (eski)", sweeps, [&](int n) {
+        for (int i = 0; i < n; ++i) {
+            LegacySweep sweep;
+            sweep.amplitudes = device.bb_fetch_trace(sweep.axis);
+            sweep.index = i;
+            if (static_cast<int>(legacyQueue.size()) >= QUEUE_CAPACITY) {
+                legacyQueue.pop_front();
+            }
+            legacyQueue.push_back(std::move(sweep));
+
+            // GUI her ikinci sweep'te yetişir
+            if (i % 2) {
+                amplitudes = legacyQueue.back().amplitudes;
+                sink = sink + consume(decimator, *legacyQueue.back().axis, amplitudes);
+                legacyQueue.clear();
+            }
+        }
+    });
+
+    // Yeni yol: havuzlu sweep, sabit halka, tutamaçla tüketim
+    std::vector<SweepPtr> ring(QUEUE_CAPACITY);
+    int head = 0, queued = 0;
+    SweepPtr current;
+    report("SweepPtr + havuz (yeni)", sweeps, [&](int n) {
+        for (int i = 0; i < n; ++i) {
+            SweepPtr sweep = device.bb_fetch_sweep();
+            if (queued >= QUEUE_CAPACITY) {
+                ring[head].reset();
+                head = (head + 1) % QUEUE_CAPACITY;
+                --queued;
+            }
+            ring[(head + queued) % QUEUE_CAPACITY] = std::move(sweep);
+            ++queued;
+
+            if (i % 2) {
+                for (int k = 0; k < queued - 1; ++k) {
+                    ring[(head + k) % QUEUE_CAPACITY].reset();
+                }
+                current = std::move(ring[(head + queued - 1) % QUEUE_CAPACITY]);
+                head = 0;
+                queued = 0;
+                sink = sink + consume(decimator, *current->axis(), current->amplitudes());
+            }
+        }
+    });
+
+    return 0;
+}
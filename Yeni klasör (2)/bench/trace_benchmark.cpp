@@ -0,0 +1,53 @@
+// Trace matematiği süresi
+//
+// Kullanım: trace_benchmark [tekrar]
+// Üç trace (max hold, üstel güç ortalaması, blok log ortalaması) aynı
+// anda etkinken farklı bin sayılarında sweep başına işlem süresi ve bu
+// sürenin 100 sweep/s'lik bütçedeki payı yazdırılır.
+
+#include "traceprocessor.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+int main(int argc, char *argv[])
+{
+    const int runs = argc > 1 ? std::atoi(argv[1]) : 200;
+
+    TraceProcessor processor;
+    TraceProcessor::TraceSettings settings;
+    settings.mode = TraceProcessor::Mode::MaxHold;
+    processor.setTraceSettings(0, settings);
+    settings.mode = TraceProcessor::Mode::PowerAverage;
+    processor.setTraceSettings(1, settings);
+    settings.mode = TraceProcessor::Mode::LogAverage;
+    settings.averaging = TraceProcessor::Averaging::Block;
+    processor.setTraceSettings(2, settings);
+
+    std::mt19937 rng(1234);
+    std::normal_distribution<double> noise(-90.0, 5.0);
+
+    std::printf("%10s %12s %14s\n", "bin", "ms/sweep", "100/s payı");
+    for (int bins : {1001, 10001, 100001, 1000001}) {
+        std::vector<double> sweep(bins);
+        for (double& v : sweep) {
+            v = noise(rng);
+        }
+
+        // Isınma: eksen değişimiyle tamponlar boyutlanır
+        processor.process(sweep.data(), bins, static_cast<quint64>(bins));
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < runs; ++r) {
+            processor.process(sweep.data(), bins, static_cast<quint64>(bins));
+        }
+        const double ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count() / runs;
+
+        std::printf("%10d %12.4f %13.2f%%\n", bins, ms, ms / 10.0 * 100.0);
+    }
+
+    return 0;
+}
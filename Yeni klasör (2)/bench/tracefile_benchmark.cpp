@@ -0,0 +1,133 @@
+// İkili trace oturum dosyası: yazma, açılış, rastgele erişim ve tam tarama
+//
+// Kullanım: tracefile_benchmark [sweep sayısı] [nokta sayısı] [dizin]
+// Varsayılan 100000 sweep x 1001 nokta (~400 MB) yazılır. Açılış yalnız
+// başlık, son ek ve indeksi okur; rastgele erişim sweep(k) görünümünün,
+// tam tarama her genliğe dokunan okumanın süresidir (ikinci kez sayfa
+// önbelleğinden). Karşılaştırma için tek trace'in eski JSON biçimindeki
+// boyutu ve ayrıştırma süresi de yazdırılır. Dosya ölçümden sonra silinir.
+
+#include "tracefile.h"
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Tüm sweep'lerin tüm genliklerine dokunur
+double scanAll(TraceFileReader& reader)
+{
+    double sum = 0.0;
+    for (int k = 0; k < reader.sweepCount(); ++k) {
+        const TraceFileReader::Record record = reader.sweep(k);
+        for (int i = 0; i < record.count; ++i) {
+            sum += record.amplitudes[i];
+        }
+    }
+    return sum;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    const int sweeps = argc > 1 ? std::atoi(argv[1]) : 100000;
+    const int points = argc > 2 ? std::atoi(argv[2]) : 1001;
+    const QString filename = (argc > 3 ? QString(argv[3]) : QString("."))
+        + QStringLiteral("/tracefile_benchmark.trace");
+
+    const double start = 950e6;
+    const double step = 100e6 / (points - 1);
+    std::vector<double> amplitudes(points);
+    for (int i = 0; i < points; ++i) {
+        amplitudes[i] = -90.0 + 0.01 * (i % 1000);
+    }
+
+    {
+        TraceFileWriter writer;
+        auto begin = std::chrono::steady_clock::now();
+        if (!writer.open(filename, BBSettings(), 0)) {
+            std::printf("Dosya açılamadı: %s\n", qPrintable(writer.errorString()));
+            return 1;
+        }
+        for (int k = 0; k < sweeps; ++k) {
+            amplitudes[k % points] += 1.0;
+            writer.append(qint64(k) * 10, start, step, amplitudes.data(), points);
+        }
+        const quint64 bytes = writer.bytesWritten();
+        writer.close();
+        const double seconds = secondsSince(begin);
+        std::printf("yazma: %d sweep, %.1f MB, %.2f s (%.0f sweep/s, %.0f MB/s)\n",
+                    sweeps, bytes / 1e6, seconds, sweeps / seconds, bytes / seconds / 1e6);
+    }
+
+    TraceFileReader reader;
+    auto begin = std::chrono::steady_clock::now();
+    if (!reader.open(filename)) {
+        std::printf("Dosya okunamadı: %s\n", qPrintable(reader.errorString()));
+        return 1;
+    }
+    std::printf("açılış: %.2f ms (%d sweep)\n", secondsSince(begin) * 1e3, reader.sweepCount());
+
+    std::mt19937 random(1);
+    std::uniform_int_distribution<int> pick(0, sweeps - 1);
+    const int lookups = 10000;
+    double sum = 0.0;
+    begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < lookups; ++i) {
+        const TraceFileReader::Record record = reader.sweep(pick(random));
+        sum += record.amplitudes[record.count / 2];
+    }
+    std::printf("rastgele sweep(k): %.2f µs\n", secondsSince(begin) / lookups * 1e6);
+
+    begin = std::chrono::steady_clock::now();
+    sum += scanAll(reader);
+    std::printf("tam tarama (ilk): %.2f s\n", secondsSince(begin));
+    begin = std::chrono::steady_clock::now();
+    sum += scanAll(reader);
+    std::printf("tam tarama (önbellek): %.2f s\n", secondsSince(begin));
+
+    begin = std::chrono::steady_clock::now();
+    const int found = reader.sweepAt(qint64(sweeps / 2) * 10 + 5);
+    std::printf("sweepAt: %d (%.2f µs)\n", found, secondsSince(begin) * 1e6);
+    reader.close();
+    QFile::remove(filename);
+
+    // Eski biçim: tek trace JSON olarak
+    QJsonArray freqArray;
+    QJsonArray ampArray;
+    for (int i = 0; i < points; ++i) {
+        freqArray.append(start + i * step);
+        ampArray.append(amplitudes[i]);
+    }
+    QJsonObject root;
+    root["version"] = 1;
+    root["size"] = points;
+    root["frequencies"] = freqArray;
+    root["amplitudes"] = ampArray;
+    const QByteArray json = QJsonDocument(root).toJson();
+    const int parses = 100;
+    begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < parses; ++i) {
+        sum += QJsonDocument::fromJson(json).object()["size"].toDouble();
+    }
+    const double parseSeconds = secondsSince(begin) / parses;
+    std::printf("JSON trace: %.1f KB/sweep (ikili %.1f KB), ayrıştırma %.2f ms/sweep"
+                " -> %d sweep için ~%.0f s\n",
+                json.size() / 1e3,
+                (TraceFileHeader::RECORD_HEADER_SIZE + 4.0 * points) / 1e3,
+                parseSeconds * 1e3, sweeps, parseSeconds * sweeps);
+
+    return sum == 0.0 ? 1 : 0;
+}
@@ -0,0 +1,149 @@
+// Waterfall çizim verimi ölçümü (1920x1080)
+//
+// Kullanım: waterfall_benchmark [bin sayısı]
+// Eski yol (her addData'da tüm geçmişin piksel başına QPainter::drawPoint
+// ile yeniden çizilmesi) ile WaterfallPlot'un scanLine + LUT yolu aynı dolu
+// geçmiş üzerinde karşılaştırılır. Ekransız çalışır (offscreen platform).
+// Ölçümden önce genlik aralığı değişince sabit bir genliğin renginin de
+// değiştiği doğrulanır; değişmiyorsa çıkış kodu 1'dir.
+
+#include "waterfallplot.h"
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QPainter>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+namespace {
+
+constexpr int WIDTH = 1920;
+constexpr int HEIGHT = 1080;
+
+// Eski WaterfallPlot::amplitudeToColor
+QColor legacyColor(double amplitude, double minAmp, double maxAmp)
+{
+    double normalized = (amplitude - minAmp) / (maxAmp - minAmp);
+    normalized = qBound(0.0, normalized, 1.0);
+
+    if (normalized < 0.25)
+        return QColor(0, 0, int(255 * normalized * 4));
+    else if (normalized < 0.5)
+        return QColor(0, int(255 * (normalized - 0.25) * 4), 255);
+    else if (normalized < 0.75)
+        return QColor(int(255 * (normalized - 0.5) * 4), 255, int(255 * (1 - (normalized - 0.5) * 4)));
+    else
+        return QColor(255, int(255 * (1 - (normalized - 0.75) * 4)), 0);
+}
+
+// Eski WaterfallPlot::updateBuffer
+void legacyUpdateBuffer(QImage& buffer, const QVector<QVector<double>>& history,
+                        double minAmp, double maxAmp)
+{
+    buffer.fill(Qt::black);
+
+    QPainter painter(&buffer);
+    for (int y = 0; y < history.size() && y < buffer.height(); ++y) {
+        const QVector<double>& spectrum = history[y];
+        for (int x = 0; x < spectrum.size() && x < buffer.width(); ++x) {
+            painter.setPen(legacyColor(spectrum[x], minAmp, maxAmp));
+            painter.drawPoint(x, y);
+        }
+    }
+}
+
+QVector<double> makeSpectrum(int bins, std::mt19937& rng)
+{
+    std::normal_distribution<double> noise(-95.0, 4.0);
+    QVector<double> spectrum(bins);
+    for (int i = 0; i < bins; ++i) {
+        spectrum[i] = noise(rng);
+    }
+    spectrum[bins / 3] = -20.0;  // Tek binlik spur
+    return spectrum;
+}
+
+// Sabit genlikli geçmişi iki farklı üst sınırla çizer; renk değişmeli.
+// Alt sınır aynı kaldığından eski LUT ölçeğiyle çizilen satır aynı renkte
+// kalırdı.
+bool amplitudeRangeRecolors()
+{
+    WaterfallPlot plot;
+    plot.resize(64, 16);
+    plot.setHistorySize(16);
+    plot.setAmplitudeRange(-120.0, 0.0);
+    plot.show();
+    QApplication::processEvents();
+    for (int i = 0; i < 16; ++i) {
+        plot.addData(QVector<double>(64, -90.0));
+    }
+
+    const QRgb before = plot.grab().toImage().pixel(32, 8);
+    plot.setMaxLevel(-60.0);
+    const QRgb after = plot.grab().toImage().pixel(32, 8);
+    if (before == after) {
+        std::printf("Genlik aralığı değişti, renk değişmedi: #%06x\n", before & 0xffffff);
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+
+    if (!amplitudeRangeRecolors())
+        return 1;
+
+    const int bins = argc > 1 ? std::atoi(argv[1]) : WIDTH;
+    std::mt19937 rng(1234);
+
+    // Dolu geçmiş: ekran yüksekliği kadar satır
+    QVector<QVector<double>> history;
+    for (int i = 0; i < HEIGHT; ++i) {
+        history.append(makeSpectrum(bins, rng));
+    }
+    const QVector<double> next = makeSpectrum(bins, rng);
+
+    std::printf("%dx%d, %d bin, %d satır geçmiş\n", WIDTH, HEIGHT, bins, HEIGHT);
+
+    // Eski yol: her karede tüm geçmiş yeniden çizilir
+    QImage legacy(WIDTH, HEIGHT, QImage::Format_RGB32);
+    const int legacyFrames = 3;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < legacyFrames; ++i) {
+        legacyUpdateBuffer(legacy, history, -120.0, 0.0);
+    }
+    const double legacyFps = legacyFrames / (timer.nsecsElapsed() / 1e9);
+
+    // Yeni yol: görüntü kaydırılır, yalnızca yeni satır çizilir
+    WaterfallPlot plot;
+    plot.resize(WIDTH, HEIGHT);
+    plot.setHistorySize(HEIGHT);
+    plot.setAmplitudeRange(-120.0, 0.0);
+    plot.show();
+    QApplication::processEvents();
+    for (const auto& row : history) {
+        plot.addData(row);
+    }
+
+    const int frames = 2000;
+    timer.restart();
+    for (int i = 0; i < frames; ++i) {
+        plot.addData(next);
+    }
+    const double fps = frames / (timer.nsecsElapsed() / 1e9);
+
+    std::printf("%-28s %12.1f kare/s\n", "drawPoint (eski)", legacyFps);
+    std::printf("%-28s %12.1f kare/s\n", "scanLine + LUT (yeni)", fps);
+    std::printf("%-28s %12.1fx\n", "hızlanma", fps / legacyFps);
+
+    return 0;
+}
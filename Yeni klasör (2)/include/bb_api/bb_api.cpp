@@ -1,11 +1,86 @@
 #include "bb_api.h"
-#include <random>
+#include "frequencyaxis.h"
+#include "sweep.h"
+#include "sweepplanner.h"
+#include "sweepstitcher.h"
+#include "signalsimulator.h"
+#include <QDateTime>
+#include <QMutex>
+#include <QMutexLocker>
+#include <algorithm>
 #include <chrono>
+#include <thread>
+
+namespace {
+
+// IQ akışında tüketici bu kadar geride kalırsa yakalar; daha fazlası
+// (araya sweep girdi, akış durdu) akışın yeniden başlaması sayılır
+constexpr std::chrono::milliseconds IQ_STREAM_SLACK{20};
+
+} // namespace
 
 // PIMPL implementation
 struct BbDeviceInterface::Impl {
-    std::mt19937 rng{std::random_device{}()};
-    std::normal_distribution<double> noise{-90.0, 5.0};  // Gürültü seviyesi
+    // GUI thread ayar değiştirirken acquisition thread'i okuyabilir
+    mutable QMutex mutex;
+
+    // Son eksen; yalnızca yapılandırma değiştiğinde yeniden hesaplanır
+    FrequencyAxisPtr axis;
+
+    // Son LO adım planı; merkez/span/RBW değişince yeniden hesaplanır
+    SweepPlanner::Config plannerConfig;
+    std::shared_ptr<const SweepPlan> plan;
+    BBSettings planSettings;
+
+    // mutex tutulurken çağrılır
+    const std::shared_ptr<const SweepPlan>& planFor(const BBSettings& settings)
+    {
+        if (!plan || settings.centerFreq != planSettings.centerFreq
+            || settings.span != planSettings.span || settings.rbw != planSettings.rbw
+            || settings.sampleRate != planSettings.sampleRate) {
+            plannerConfig.sampleRate = settings.sampleRate;
+            plan = std::make_shared<const SweepPlan>(SweepPlanner::plan(
+                settings.centerFreq - settings.span / 2, settings.centerFreq + settings.span / 2,
+                settings.rbw, plannerConfig));
+            planSettings = settings;
+        }
+        return plan;
+    }
+
+    // Eksen planın çıkış ızgarasıdır (mutex tutulurken çağrılır)
+    const FrequencyAxisPtr& axisFor(const BBSettings& settings)
+    {
+        const SweepPlan& p = *planFor(settings);
+        if (!axis || !axis->matches(p.startFreq, p.stopFreq(), p.outputBins)) {
+            axis = FrequencyAxis::create(p.startFreq, p.stopFreq(), p.outputBins);
+        }
+        return axis;
+    }
+
+    // Sweep'ler ve genlik tamponları geri dönüştürülür
+    SweepPool sweepPool;
+    quint64 sweepSequence{0};
+
+    // Simülatörü kullanan her şey (sweep'ler, IQ) sweepMutex altında
+    // yürür; sweep sırasında ayar kilidi bırakılır. Simülatör stitcher'ın
+    // yakalama tarafında çağrılır.
+    mutable QMutex sweepMutex;
+    SweepStitcher stitcher;
+    SignalSimulator simulator;
+    // Sıradaki IQ bloğunun örnekleme saatine göre hazır olacağı an
+    std::chrono::steady_clock::time_point iqReady;
+
+    // Trace simülatör IQ'sundan gerçek FFT yoluyla elde edilir
+    // (sweepMutex tutulurken, mutex tutulmadan çağrılır)
+    void measureTrace(const SweepPlan& plan, double* trace)
+    {
+        stitcher.run(plan,
+            [this, &plan](double centerFreq, std::complex<float>* iq, int count) {
+                simulator.generate(centerFreq, plan.sampleRate, iq, count);
+                return count;
+            },
+            trace);
+    }
 };
 
 BbDeviceInterface::BbDeviceInterface(QObject *parent)
@@ -45,6 +120,7 @@ QString BbDeviceInterface::getLastError() const
 
 void BbDeviceInterface::setCenterFrequency(double freq)
 {
+    QMutexLocker locker(&pimpl->mutex);
     settings.centerFreq = freq;
     if (connected) {
         configureDevice();
@@ -53,6 +129,7 @@ void BbDeviceInterface::setCenterFrequency(double freq)
 
 void BbDeviceInterface::setSpan(double span)
 {
+    QMutexLocker locker(&pimpl->mutex);
     settings.span = span;
     if (connected) {
         configureDevice();
@@ -61,6 +138,7 @@ void BbDeviceInterface::setSpan(double span)
 
 void BbDeviceInterface::setRBW(int rbw)
 {
+    QMutexLocker locker(&pimpl->mutex);
     settings.rbw = rbw;
     if (connected) {
         configureDevice();
@@ -69,6 +147,7 @@ void BbDeviceInterface::setRBW(int rbw)
 
 void BbDeviceInterface::setVBW(int vbw)
 {
+    QMutexLocker locker(&pimpl->mutex);
     settings.vbw = vbw;
     if (connected) {
         configureDevice();
@@ -77,6 +156,7 @@ void BbDeviceInterface::setVBW(int vbw)
 
 void BbDeviceInterface::setRefLevel(double level)
 {
+    QMutexLocker locker(&pimpl->mutex);
     settings.refLevel = level;
     if (connected) {
         configureDevice();
@@ -85,36 +165,71 @@ void BbDeviceInterface::setRefLevel(double level)
 
 double BbDeviceInterface::getSampleRate() const
 {
+    QMutexLocker locker(&pimpl->mutex);
     return settings.sampleRate;
 }
 
+BBSettings BbDeviceInterface::getSettings() const
+{
+    QMutexLocker locker(&pimpl->mutex);
+    return settings;
+}
+
+std::shared_ptr<const FrequencyAxis> BbDeviceInterface::getFrequencyAxis() const
+{
+    QMutexLocker locker(&pimpl->mutex);
+    return pimpl->axisFor(settings);
+}
+
+SweepPlan BbDeviceInterface::getSweepPlan() const
+{
+    QMutexLocker locker(&pimpl->mutex);
+    return *pimpl->planFor(settings);
+}
+
 QVector<double> BbDeviceInterface::bb_fetch_trace()
+{
+    std::shared_ptr<const FrequencyAxis> axis;
+    return bb_fetch_trace(axis);
+}
+
+QVector<double> BbDeviceInterface::bb_fetch_trace(std::shared_ptr<const FrequencyAxis>& axis)
 {
     if (!connected) {
         return QVector<double>();
     }
 
-    // Simüle edilmiş spektrum verisi
-    const int numPoints = 1001;
-    QVector<double> trace(numPoints);
+    QMutexLocker sweepLocker(&pimpl->sweepMutex);
+    QMutexLocker locker(&pimpl->mutex);
+    axis = pimpl->axisFor(settings);
+    const std::shared_ptr<const SweepPlan> plan = pimpl->plan;
+    locker.unlock();
 
-    double startFreq = settings.centerFreq - settings.span/2;
-    double stopFreq = settings.centerFreq + settings.span/2;
-    double freqStep = settings.span / (numPoints - 1);
+    QVector<double> trace(axis->size());
+    pimpl->measureTrace(*plan, trace.data());
+    return trace;
+}
 
-    // Temel sinyal ve harmonikler
-    for (int i = 0; i < numPoints; ++i) {
-        double freq = startFreq + i * freqStep;
-        double amp = pimpl->noise(pimpl->rng);  // Gürültü tabanı
+std::shared_ptr<const Sweep> BbDeviceInterface::bb_fetch_sweep()
+{
+    if (!connected) {
+        return nullptr;
+    }
 
-        // Ana sinyal
-        double mainSignal = -20.0 * std::pow((freq - settings.centerFreq)/(settings.span/10), 2);
-        amp = std::max(amp, mainSignal);
+    QMutexLocker sweepLocker(&pimpl->sweepMutex);
+    QMutexLocker locker(&pimpl->mutex);
 
-        trace[i] = amp;
-    }
+    // Havuzdan alınan sweep yerinde doldurulur; kararlı durumda bellek ayrılmaz
+    std::shared_ptr<Sweep> sweep = pimpl->sweepPool.acquire();
+    sweep->prepare(++pimpl->sweepSequence, QDateTime::currentMSecsSinceEpoch(),
+                   pimpl->axisFor(settings), settings);
+    const std::shared_ptr<const SweepPlan> plan = pimpl->plan;
 
-    return trace;
+    // Sweep uzun sürebilir: ayar kilidi bırakılır, sweep başladığı
+    // ayarlarla (sweep->settings()) tamamlanır
+    locker.unlock();
+    pimpl->measureTrace(*plan, sweep->amplitudeData());
+    return sweep;
 }
 
 QVector<std::complex<float>> BbDeviceInterface::bb_fetch_iq_data()
@@ -123,20 +238,56 @@ QVector<std::complex<float>> BbDeviceInterface::bb_fetch_iq_data()
         return QVector<std::complex<float>>();
     }
 
-    // Simüle edilmiş IQ verisi
-    const int numSamples = 16384;
-    QVector<std::complex<float>> iqData(numSamples);
+    QVector<std::complex<float>> iqData(IQ_BLOCK_SIZE);
+    iqData.resize(bb_fetch_iq_data(iqData.data(), iqData.size()));
+    return iqData;
+}
+
+int BbDeviceInterface::bb_fetch_iq_data(std::complex<float>* buffer, int maxSamples)
+{
+    if (!connected || !buffer) {
+        return 0;
+    }
+
+    QMutexLocker sweepLocker(&pimpl->sweepMutex);
+    double centerFreq;
+    double sampleRate;
+    {
+        QMutexLocker locker(&pimpl->mutex);
+        centerFreq = settings.centerFreq;
+        sampleRate = settings.sampleRate;
+    }
 
-    std::normal_distribution<float> i_noise(0.0f, 0.1f);
-    std::normal_distribution<float> q_noise(0.0f, 0.1f);
+    // Simüle edilmiş IQ verisi: sahne geçerli LO'ya göre
+    const int numSamples = std::clamp(maxSamples, 0, IQ_BLOCK_SIZE);
 
-    for (int i = 0; i < numSamples; ++i) {
-        float i_val = i_noise(pimpl->rng);
-        float q_val = q_noise(pimpl->rng);
-        iqData[i] = std::complex<float>(i_val, q_val);
+    // Gerçek cihaz gibi örnekleme hızında verilir: blok, öncekinin
+    // bitişinden numSamples / sampleRate sonra hazır olur. Simülatör
+    // CPU'nun izin verdiği hızda üretseydi kayıtlar örnekleme hızıyla
+    // duvar saatini tutmazdı.
+    if (sampleRate > 0.0) {
+        const auto now = std::chrono::steady_clock::now();
+        if (pimpl->iqReady < now - IQ_STREAM_SLACK) {
+            pimpl->iqReady = now;
+        }
+        pimpl->iqReady += std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(numSamples / sampleRate));
+        std::this_thread::sleep_until(pimpl->iqReady);
     }
+    pimpl->simulator.generate(centerFreq, sampleRate, buffer, numSamples);
+    return numSamples;
+}
 
-    return iqData;
+void BbDeviceInterface::setSimulatorScene(const SimulatorScene& scene)
+{
+    QMutexLocker sweepLocker(&pimpl->sweepMutex);
+    pimpl->simulator.setScene(scene);
+}
+
+SimulatorScene BbDeviceInterface::simulatorScene() const
+{
+    QMutexLocker sweepLocker(&pimpl->sweepMutex);
+    return pimpl->simulator.scene();
 }
 
 void BbDeviceInterface::initializeDevice()
@@ -8,6 +8,11 @@
 #include <string>
 #include <QString>
 
+class FrequencyAxis;
+class Sweep;
+struct SweepPlan;
+struct SimulatorScene;
+
 // BB60C cihazı için temel ayarlar
 struct BBSettings {
     double centerFreq{1e9};     // 1 GHz
@@ -37,10 +42,35 @@ public:
     void setVBW(int vbw);
     void setRefLevel(double level);
     double getSampleRate() const;
+    BBSettings getSettings() const;
+    // Geçerli ayarların frekans ekseni. Merkez/span/RBW ya da bin sayısı
+    // değişmedikçe aynı (aynı sürümlü) nesne döner.
+    std::shared_ptr<const FrequencyAxis> getFrequencyAxis() const;
+    // Geçerli span/RBW'nin LO adım planı ve sweep süresi tahmini. Span
+    // anlık IF bant genişliğini aşınca sweep'ler bu planla segment segment
+    // yakalanıp birleştirilir.
+    SweepPlan getSweepPlan() const;
+    // Simüle edilen sinyaller, gürültü tabanı ve faz gürültüsü. Tüm
+    // trace/sweep/IQ verisi bu sahneden FFT yoluyla üretilir.
+    void setSimulatorScene(const SimulatorScene& scene);
+    SimulatorScene simulatorScene() const;
 
-    // Veri toplama
+    // Veri toplama (ayar değişiklikleriyle eşzamanlı olarak
+    // acquisition thread'inden çağrılabilir)
     QVector<double> bb_fetch_trace();
+    // Trace ile onu üreten eksen aynı kilit altında alınır; arada ayar
+    // değişse bile genlikler ve frekanslar birbirini tutar
+    QVector<double> bb_fetch_trace(std::shared_ptr<const FrequencyAxis>& axis);
+    // Eksen, genlikler, zaman damgası ve ayar görüntüsüyle değişmez sweep.
+    // Sweep'ler iç havuzdan gelir; tüm referanslar bırakılınca yeniden
+    // kullanılır. Bağlı değilse nullptr.
+    std::shared_ptr<const Sweep> bb_fetch_sweep();
     QVector<std::complex<float>> bb_fetch_iq_data();
+    // Çağıranın tamponuna (örn. IQRingBuffer bloğu) doğrudan yazar,
+    // yazılan örnek sayısını döndürür. Bloklar örnekleme hızında verilir:
+    // arka arkaya çağrılar blok süresi kadar bekler.
+    int bb_fetch_iq_data(std::complex<float>* buffer, int maxSamples);
+    static constexpr int IQ_BLOCK_SIZE = 16384;
 
 private:
     struct Impl;
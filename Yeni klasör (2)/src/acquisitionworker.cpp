@@ -0,0 +1,191 @@
+#include "acquisitionworker.h"
+#include "bb_api.h"
+#include "iqrecorder.h"
+#include "iqringbuffer.h"
+#include "measurementengine.h"
+#include "tracefile.h"
+#include "traceprocessor.h"
+#include <QMutexLocker>
+#include <algorithm>
+
+AcquisitionWorker::AcquisitionWorker(BbDeviceInterface* device, QObject *parent)
+    : QThread(parent)
+    , device(device)
+    , sweepQueue(queueCapacity)
+{
+}
+
+AcquisitionWorker::~AcquisitionWorker()
+{
+    stop();
+}
+
+void AcquisitionWorker::setQueueCapacity(int capacity)
+{
+    QMutexLocker locker(&queueMutex);
+    queueCapacity = std::max(capacity, 1);
+    sweepQueue.assign(queueCapacity, nullptr);
+    queueHead = 0;
+    queueCount = 0;
+}
+
+void AcquisitionWorker::setIQRingBuffer(IQRingBuffer* ring)
+{
+    iqRing = ring;
+}
+
+void AcquisitionWorker::setIQRecorder(IQRecorder* recorder)
+{
+    iqRecorder = recorder;
+}
+
+void AcquisitionWorker::setMeasurementEngine(MeasurementEngine* engine)
+{
+    measurementEngine = engine;
+}
+
+void AcquisitionWorker::setTraceProcessor(TraceProcessor* processor)
+{
+    traceProcessor = processor;
+}
+
+void AcquisitionWorker::setTraceWriter(TraceFileWriter* writer)
+{
+    traceWriter = writer;
+}
+
+void AcquisitionWorker::stop()
+{
+    stopRequested.store(true);
+    if (isRunning()) {
+        wait();
+    }
+}
+
+bool AcquisitionWorker::takeLatest(SweepPtr& sweep)
+{
+    QMutexLocker locker(&queueMutex);
+    notifyPending = false;
+
+    if (queueCount == 0) {
+        return false;
+    }
+
+    // Ekran yetişemediyse aradaki sweep'ler atlanır ve sayılır; bırakılan
+    // tutamaçlar sweep'leri cihaz havuzuna geri verir
+    dropped.fetch_add(queueCount - 1, std::memory_order_relaxed);
+    const int capacity = static_cast<int>(sweepQueue.size());
+    for (int i = 0; i < queueCount - 1; ++i) {
+        sweepQueue[(queueHead + i) % capacity].reset();
+    }
+    sweep = std::move(sweepQueue[(queueHead + queueCount - 1) % capacity]);
+    queueHead = 0;
+    queueCount = 0;
+    displayed.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+int AcquisitionWorker::sweepsQueued() const
+{
+    QMutexLocker locker(&queueMutex);
+    return queueCount;
+}
+
+void AcquisitionWorker::run()
+{
+    bool streaming = false;
+    bool traceFailed = false;
+    while (!stopRequested.load()) {
+        try {
+            // Kayıt sürerken cihaz IQ akış modundadır: bloklar araya sweep
+            // girmeden arka arkaya çekilir, kayıt zaman içinde bitişik kalır.
+            // Sweep, ölçüm ve trace oturumu kayıt bitene kadar durur.
+            if (iqRing && iqRecorder && iqRecorder->isRecording()) {
+                streaming = fetchIQBlock(streaming) > 0;
+                if (!streaming) {
+                    // Cihaz bağlı değil; sonraki blok yeni segment başlatır
+                    msleep(10);
+                }
+                continue;
+            }
+            streaming = false;
+
+            SweepPtr sweep = device->bb_fetch_sweep();
+            if (!sweep) {
+                // Cihaz bağlı değil, boşa dönme
+                msleep(10);
+                continue;
+            }
+
+            acquired.fetch_add(1, std::memory_order_relaxed);
+            if (traceProcessor) {
+                // GUI sweep'i aldığında trace'ler onu zaten içerir
+                traceProcessor->process(*sweep);
+            }
+            if (measurementEngine) {
+                measurementEngine->submit(sweep);
+            }
+            if (traceWriter) {
+                // Oturum kapalıyken çağrı hemen döner; açık oturumdaki hata
+                // yalnızca ilk seferinde bildirilir
+                const bool failed = !traceWriter->append(*sweep) && traceWriter->isOpen();
+                if (failed && !traceFailed) {
+                    emit traceWriteError(traceWriter->errorString());
+                }
+                traceFailed = failed;
+            }
+            pushSweep(std::move(sweep));
+
+            if (iqRing) {
+                // Sweep cihazı başka LO'larda sürdü: blok öncekinin devamı değil
+                fetchIQBlock(false);
+            }
+        } catch (const std::exception& e) {
+            emit acquisitionError(QString::fromLocal8Bit(e.what()));
+            break;
+        }
+    }
+}
+
+int AcquisitionWorker::fetchIQBlock(bool contiguous)
+{
+    // Ara kopya yok: cihaz bloğu halkaya yazar
+    std::complex<float>* block = iqRing->beginWrite();
+    const int count = device->bb_fetch_iq_data(block, iqRing->blockSize());
+    iqRing->commitWrite(count);
+    // Tek yazıcı bu thread olduğundan blok bir sonraki beginWrite()'a
+    // kadar değişmez
+    if (iqRecorder && count > 0) {
+        if (!contiguous) {
+            iqRecorder->markDiscontinuity();
+        }
+        iqRecorder->submit(block, count);
+    }
+    return count;
+}
+
+void AcquisitionWorker::pushSweep(SweepPtr&& sweep)
+{
+    bool notify = false;
+    {
+        QMutexLocker locker(&queueMutex);
+
+        // Kuyruk doluysa en eskiyi at; yakalama tarafı asla beklemez
+        if (queueCount >= queueCapacity) {
+            sweepQueue[queueHead].reset();
+            queueHead = (queueHead + 1) % queueCapacity;
+            --queueCount;
+            dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+        sweepQueue[(queueHead + queueCount) % queueCapacity] = std::move(sweep);
+        ++queueCount;
+
+        // GUI okuyana kadar tek bir bildirim yeterli
+        notify = !notifyPending;
+        notifyPending = true;
+    }
+
+    if (notify) {
+        emit sweepReady();
+    }
+}
@@ -0,0 +1,95 @@
+#ifndef ACQUISITIONWORKER_H
+#define ACQUISITIONWORKER_H
+
+#include <QThread>
+#include <QMutex>
+#include <QVector>
+#include <atomic>
+#include <vector>
+#include "sweep.h"
+
+class BbDeviceInterface;
+class IQRecorder;
+class IQRingBuffer;
+class MeasurementEngine;
+class TraceFileWriter;
+class TraceProcessor;
+
+// Cihazdan olabildiğince hızlı veri çeken thread. Sweep'ler sınırlı bir
+// kuyruğa yazılır; kuyruk doluysa en eski sweep atılır, yakalama asla
+// GUI'yi beklemez. Kuyrukta yalnızca SweepPtr tutamaçları dolaşır.
+class AcquisitionWorker : public QThread {
+    Q_OBJECT
+public:
+    explicit AcquisitionWorker(BbDeviceInterface* device, QObject *parent = nullptr);
+    ~AcquisitionWorker() override;
+
+    // Ayarlar (start() öncesinde çağrılmalı)
+    void setQueueCapacity(int capacity);
+    // IQ blokları cihazdan doğrudan bu halkaya yazılır (nullptr: IQ kapalı)
+    void setIQRingBuffer(IQRingBuffer* ring);
+    // Halkaya yazılan her IQ bloğu kaydediciye de verilir (nullptr: kapalı);
+    // kaydedici diski beklemez. Kayıt sürerken sweep çekilmez, IQ blokları
+    // bitişik akış olarak arka arkaya çekilir.
+    void setIQRecorder(IQRecorder* recorder);
+    // Her sweep ekran atlasa da ölçüm motoruna verilir (nullptr: kapalı)
+    void setMeasurementEngine(MeasurementEngine* engine);
+    // Trace matematiği her sweep'te bu thread'de uygulanır (nullptr: kapalı)
+    void setTraceProcessor(TraceProcessor* processor);
+    // Her sweep açık oturum dosyasına bu thread'de, eşzamanlı eklenir
+    // (nullptr: kapalı). Kayıt 32 + 4 * nokta bayttır ve tek write() ile
+    // sayfa önbelleğine gider: 1001 noktalı sweep ~4 KB'tır, ama geniş
+    // span'de (en çok SweepPlanner::Config::maxOutputBins = 1M nokta)
+    // ~4 MB olur; önbellek dolduğunda yavaş diskte acquisition yazma
+    // kadar bekler. Yazma hatası traceWriteError ile bir kez bildirilir.
+    void setTraceWriter(TraceFileWriter* writer);
+
+    void stop();
+
+    // GUI tarafı: kuyruktaki en yeni sweep'i al, eskileri atla
+    bool takeLatest(SweepPtr& sweep);
+
+    // Sayaçlar: acquired == displayed + dropped + queued
+    quint64 sweepsAcquired() const { return acquired.load(std::memory_order_relaxed); }
+    quint64 sweepsDisplayed() const { return displayed.load(std::memory_order_relaxed); }
+    quint64 sweepsDropped() const { return dropped.load(std::memory_order_relaxed); }
+    int sweepsQueued() const;
+
+signals:
+    // Kuyrukta okunmamış veri varken tekrar yayınlanmaz
+    void sweepReady();
+    void acquisitionError(const QString& message);
+    // Trace oturumuna yazılamadı; sonraki sweep'ler eklenmez
+    void traceWriteError(const QString& message);
+
+protected:
+    void run() override;
+
+private:
+    BbDeviceInterface* device;
+    int queueCapacity{4};
+    IQRingBuffer* iqRing{nullptr};
+    IQRecorder* iqRecorder{nullptr};
+    MeasurementEngine* measurementEngine{nullptr};
+    TraceProcessor* traceProcessor{nullptr};
+    TraceFileWriter* traceWriter{nullptr};
+
+    mutable QMutex queueMutex;
+    // Sabit kapasiteli halka; push/pop bellek ayırmaz
+    std::vector<SweepPtr> sweepQueue;
+    int queueHead{0};   // En eski sweep
+    int queueCount{0};
+    bool notifyPending{false};
+
+    std::atomic<bool> stopRequested{false};
+    std::atomic<quint64> acquired{0};
+    std::atomic<quint64> displayed{0};
+    std::atomic<quint64> dropped{0};
+
+    void pushSweep(SweepPtr&& sweep);
+    // Halkaya ve kayda bir IQ bloğu; contiguous false ise kayıtta yeni
+    // capture segmenti başlar. Çekilen örnek sayısını döndürür.
+    int fetchIQBlock(bool contiguous);
+};
+
+#endif // ACQUISITIONWORKER_H
@@ -1,15 +1,78 @@
 #include "analyzer.h"
+#include "powerkernels.h"
+#include "sweep.h"
+#include <QThread>
+#include <QThreadPool>
 #include <cmath>
 #include <algorithm>
 #include <numeric>
+#include <atomic>
 
 // PIMPL implementation
 struct Analyzer::Impl {
     // FFT için parametreler
     static constexpr int FFT_SIZE = 4096;
-    static constexpr int WINDOW_TYPE = 1;  // Hanning
+    static constexpr WindowType WINDOW_TYPE = WindowType::Hann;
+    static constexpr double OVERLAP = 0.5;
+
+    int fftSize{FFT_SIZE};
+    WindowType windowType{WINDOW_TYPE};
+    double overlap{OVERLAP};
+
+    // Segmentler sabit boyutlu parçalara bölünür; parça sınırları yalnızca
+    // segment sayısına bağlı olduğundan toplama sırası thread sayısından
+    // bağımsızdır ve sonuç her zaman bit düzeyinde aynıdır
+    static constexpr qint64 MIN_CHUNK_SEGMENTS = 16;
+    static constexpr qint64 MAX_CHUNKS = 256;
+
+    // Plan/pencere önbelleği ve kalıcı çalışma tamponları
+    FftEngine fft;
+    std::vector<std::vector<std::complex<float>>> segments;  // Worker başına
+    std::vector<double> chunkAccumulators;                     // Parça başına
+    std::vector<double> psdLinear;
+
+    // Kümülatif mW dizileri (N+1 eleman, prefix[0] = 0). Sweep'e ait dizi
+    // sweep kimliğiyle saklanır; aynı sweep üzerindeki kanal gücü, OBW ve
+    // ACPR tek O(N) geçişi paylaşır, her bant gücü sorgusu iki okumadır.
+    std::vector<double> prefixScratch;
+    std::vector<double> sweepPrefix;
+    quint64 sweepPrefixId{0};
+
+    // Spur arama tamponları çağrılar arasında korunur
+    PeakDetector peakDetector;
+
+    QThreadPool pool;
+    int threadCount{0};
+
+    int effectiveThreads() const
+    {
+        return threadCount > 0 ? threadCount : std::max(QThread::idealThreadCount(), 1);
+    }
 };
 
+namespace {
+
+// [first, first+count) segmentlerinin periodogramlarını acc'ye ekler
+void accumulateSegments(FftEngine& fft, const float* window, int n, qint64 hop,
+                        const std::complex<float>* data, qint64 first, qint64 count,
+                        std::complex<float>* seg, double* acc)
+{
+    for (qint64 s = first; s < first + count; ++s) {
+        const std::complex<float>* src = data + s * hop;
+        for (int i = 0; i < n; ++i) {
+            seg[i] = src[i] * window[i];
+        }
+        fft.forward(seg, n);
+        for (int k = 0; k < n; ++k) {
+            const float re = seg[k].real();
+            const float im = seg[k].imag();
+            acc[k] += static_cast<double>(re * re + im * im);
+        }
+    }
+}
+
+} // namespace
+
 Analyzer::Analyzer(QObject *parent)
     : QObject(parent)
     , pimpl(std::make_unique<Impl>())
@@ -23,41 +86,103 @@ double Analyzer::measureChannelPower(const QVector<double>& frequencies,
                                    double startFreq,
                                    double stopFreq)
 {
-    int startIndex = findFrequencyIndex(frequencies, startFreq);
-    int stopIndex = findFrequencyIndex(frequencies, stopFreq);
+    if (frequencies.isEmpty() || frequencies.size() != amplitudes.size())
+        return 0.0;
+    return channelPower(frequencies, powerPrefix(amplitudes), startFreq, stopFreq);
+}
 
-    return calculatePower(amplitudes, startIndex, stopIndex);
+double Analyzer::measureChannelPower(const Sweep& sweep, double startFreq, double stopFreq)
+{
+    if (!sweep.axis() || sweep.axis()->size() != sweep.size() || sweep.size() == 0)
+        return 0.0;
+    return channelPower(sweep.axis()->values(), powerPrefix(sweep), startFreq, stopFreq);
 }
 
 double Analyzer::measureOBW(const QVector<double>& frequencies,
                           const QVector<double>& amplitudes,
                           double percentPower)
 {
-    // Toplam gücü hesapla
-    double totalPower = calculatePower(amplitudes, 0, amplitudes.size() - 1);
-    double targetPower = totalPower * percentPower / 100.0;
-
-    // Merkez frekansı bul
-    int centerIndex = amplitudes.size() / 2;
-    double currentPower = 0.0;
-    int bandwidth = 0;
-
-    // Güç eşiğine ulaşana kadar bant genişliğini artır
-    while (currentPower < targetPower && bandwidth < amplitudes.size()) {
-        int startIndex = std::max(centerIndex - bandwidth/2, 0);
-        int stopIndex = std::min(centerIndex + bandwidth/2, amplitudes.size() - 1);
-        currentPower = calculatePower(amplitudes, startIndex, stopIndex);
-        bandwidth++;
-    }
+    if (frequencies.isEmpty() || frequencies.size() != amplitudes.size())
+        return 0.0;
+    return occupiedBandwidth(frequencies, powerPrefix(amplitudes), percentPower);
+}
 
-    return std::abs(frequencies[centerIndex + bandwidth/2] -
-                   frequencies[centerIndex - bandwidth/2]);
+double Analyzer::measureOBW(const Sweep& sweep, double percentPower)
+{
+    if (!sweep.axis() || sweep.axis()->size() != sweep.size() || sweep.size() == 0)
+        return 0.0;
+    return occupiedBandwidth(sweep.axis()->values(), powerPrefix(sweep), percentPower);
 }
 
 ACPRResult Analyzer::measureACPR(const QVector<double>& frequencies,
                                const QVector<double>& amplitudes,
                                double channelBW,
                                double channelSpacing)
+{
+    if (frequencies.isEmpty() || frequencies.size() != amplitudes.size())
+        return ACPRResult();
+    return adjacentChannelPower(frequencies, powerPrefix(amplitudes), channelBW, channelSpacing);
+}
+
+ACPRResult Analyzer::measureACPR(const Sweep& sweep, double channelBW, double channelSpacing)
+{
+    if (!sweep.axis() || sweep.axis()->size() != sweep.size() || sweep.size() == 0)
+        return ACPRResult();
+    return adjacentChannelPower(sweep.axis()->values(), powerPrefix(sweep), channelBW, channelSpacing);
+}
+
+double Analyzer::channelPower(const QVector<double>& frequencies,
+                              const double* prefix,
+                              double startFreq,
+                              double stopFreq)
+{
+    int startIndex = findFrequencyIndex(frequencies, startFreq);
+    int stopIndex = findFrequencyIndex(frequencies, stopFreq);
+
+    return calculatePower(prefix, startIndex, stopIndex);
+}
+
+double Analyzer::occupiedBandwidth(const QVector<double>& frequencies,
+                                   const double* prefix,
+                                   double percentPower)
+{
+    const int count = frequencies.size();
+    const double totalPower = prefix[count];
+    if (count < 2 || totalPower <= 0.0)
+        return 0.0;
+
+    // Gücün (100 - x)/2 %'si her iki kenarın dışında kalır
+    const double fraction = std::clamp(percentPower, 0.0, 100.0) / 100.0;
+    const double lowerTarget = totalPower * (1.0 - fraction) / 2.0;
+    const double upperTarget = totalPower * (1.0 + fraction) / 2.0;
+
+    // Bin i, [edge(i), edge(i+1)) aralığını kaplar; kenarlar komşu bin
+    // merkezlerinin ortasıdır, uçlarda yarım bin dışarı uzatılır
+    auto edge = [&](int i) {
+        if (i == 0)
+            return frequencies[0] - (frequencies[1] - frequencies[0]) / 2.0;
+        if (i == count)
+            return frequencies[count - 1] + (frequencies[count - 1] - frequencies[count - 2]) / 2.0;
+        return (frequencies[i - 1] + frequencies[i]) / 2.0;
+    };
+
+    // Kümülatif güç hedefi geçtiği bin ikili aramayla bulunur ve bin
+    // içinde güç düzgün dağılmış kabul edilerek kenar aradeğerlenir
+    auto crossing = [&](double target) {
+        const double* it = std::lower_bound(prefix + 1, prefix + count + 1, target);
+        const int bin = std::min(static_cast<int>(it - prefix) - 1, count - 1);
+        const double binPower = prefix[bin + 1] - prefix[bin];
+        const double frac = binPower > 0.0 ? std::clamp((target - prefix[bin]) / binPower, 0.0, 1.0) : 0.0;
+        return edge(bin) + frac * (edge(bin + 1) - edge(bin));
+    };
+
+    return std::abs(crossing(upperTarget) - crossing(lowerTarget));
+}
+
+ACPRResult Analyzer::adjacentChannelPower(const QVector<double>& frequencies,
+                                          const double* prefix,
+                                          double channelBW,
+                                          double channelSpacing)
 {
     ACPRResult result;
 
@@ -74,9 +199,9 @@ ACPRResult Analyzer::measureACPR(const QVector<double>& frequencies,
     int upperStop = findFrequencyIndex(frequencies, frequencies[mainStop] + channelSpacing + channelBW);
 
     // Güç hesapla
-    result.mainChannelPower = calculatePower(amplitudes, mainStart, mainStop);
-    result.lowerChannelPower = calculatePower(amplitudes, lowerStart, lowerStop);
-    result.upperChannelPower = calculatePower(amplitudes, upperStart, upperStop);
+    result.mainChannelPower = calculatePower(prefix, mainStart, mainStop);
+    result.lowerChannelPower = calculatePower(prefix, lowerStart, lowerStop);
+    result.upperChannelPower = calculatePower(prefix, upperStart, upperStop);
 
     // Oranları hesapla
     result.lowerRatio = result.mainChannelPower - result.lowerChannelPower;
@@ -88,29 +213,36 @@ ACPRResult Analyzer::measureACPR(const QVector<double>& frequencies,
 QVector<SpurResult> Analyzer::findSpurs(const QVector<double>& frequencies,
                                       const QVector<double>& amplitudes,
                                       double threshold)
+{
+    PeakSearchSettings settings;
+    settings.threshold = threshold;
+    return findSpurs(frequencies, amplitudes, settings);
+}
+
+QVector<SpurResult> Analyzer::findSpurs(const QVector<double>& frequencies,
+                                      const QVector<double>& amplitudes,
+                                      const PeakSearchSettings& settings)
 {
     QVector<SpurResult> spurs;
-    
-    // Tepe noktalarını bul
-    for (int i = 1; i < amplitudes.size() - 1; ++i) {
-        if (amplitudes[i] > threshold &&
-            amplitudes[i] > amplitudes[i-1] &&
-            amplitudes[i] > amplitudes[i+1]) {
-            
-            SpurResult spur;
-            spur.frequency = frequencies[i];
-            spur.amplitude = amplitudes[i];
-            spur.relativePower = spur.amplitude - *std::max_element(amplitudes.begin(),
-                                                                  amplitudes.end());
-            spurs.push_back(spur);
-        }
-    }
+    if (amplitudes.isEmpty() || frequencies.size() != amplitudes.size())
+        return spurs;
 
-    // Genliğe göre sırala
-    std::sort(spurs.begin(), spurs.end(),
-              [](const SpurResult& a, const SpurResult& b) {
-                  return a.amplitude > b.amplitude;
-              });
+    const std::vector<Peak>& peaks = pimpl->peakDetector.find(amplitudes.constData(),
+                                                              amplitudes.size(), settings);
+    if (peaks.empty())
+        return spurs;
+
+    // Bağıl güç için global maksimum bir kez bulunur
+    const double maxAmplitude = *std::max_element(amplitudes.constBegin(), amplitudes.constEnd());
+
+    spurs.reserve(static_cast<int>(peaks.size()));
+    for (const Peak& peak : peaks) {
+        SpurResult spur;
+        spur.frequency = frequencies[peak.index];
+        spur.amplitude = peak.amplitude;
+        spur.relativePower = peak.amplitude - maxAmplitude;
+        spurs.push_back(spur);
+    }
 
     return spurs;
 }
@@ -118,48 +250,191 @@ QVector<SpurResult> Analyzer::findSpurs(const QVector<double>& frequencies,
 QVector<double> Analyzer::measurePhaseNoise(const QVector<std::complex<float>>& iqData,
                                           double sampleRate,
                                           const QVector<double>& offsets)
+{
+    return measurePhaseNoise(iqData.constData(), iqData.size(), sampleRate, offsets);
+}
+
+QVector<double> Analyzer::measurePhaseNoise(const std::complex<float>* iqData,
+                                          int count,
+                                          double sampleRate,
+                                          const QVector<double>& offsets)
 {
     QVector<double> phaseNoise(offsets.size());
     
     // Güç spektral yoğunluğunu hesapla
-    auto psd = calculatePSD(iqData, sampleRate);
+    const int n = welchPSD(iqData, count, sampleRate);
+    if (n == 0) {
+        return phaseNoise;
+    }
+    const std::vector<double>& psd = pimpl->psdLinear;
+    const double binWidth = sampleRate / n;
+    
+    // Taşıyıcıyı bul ve pencerenin ana lobu boyunca gücünü topla
+    const int peak = static_cast<int>(std::distance(psd.begin(),
+                                                    std::max_element(psd.begin(), psd.end())));
+    int lobe = 2;
+    if (pimpl->windowType == WindowType::Blackman) lobe = 3;
+    if (pimpl->windowType == WindowType::FlatTop) lobe = 5;
+    
+    double carrierPower = 0.0;
+    for (int k = -lobe; k <= lobe; ++k) {
+        carrierPower += psd[(peak + k + n) % n] * binWidth;
+    }
+    if (carrierPower <= 0.0) {
+        return phaseNoise;
+    }
     
-    // Her offset için faz gürültüsünü hesapla
+    // Her offset için faz gürültüsünü hesapla (dBc/Hz)
     for (int i = 0; i < offsets.size(); ++i) {
-        int offsetIndex = static_cast<int>(offsets[i] * psd.size() / sampleRate);
-        if (offsetIndex < psd.size()) {
-            phaseNoise[i] = psd[offsetIndex];
+        int offsetBins = static_cast<int>(std::lround(offsets[i] / binWidth));
+        if (offsetBins > lobe && offsetBins < n / 2) {
+            double value = psd[(peak + offsetBins) % n];
+            phaseNoise[i] = 10.0 * std::log10(std::max(value, 1e-30) / carrierPower);
         }
     }
     
     return phaseNoise;
 }
 
-double Analyzer::calculatePower(const QVector<double>& amplitudes,
+void Analyzer::setPSDParameters(int fftSize, WindowType window, double overlap)
+{
+    pimpl->fftSize = std::max(FftEngine::floorPowerOfTwo(fftSize), 2);
+    pimpl->windowType = window;
+    pimpl->overlap = std::clamp(overlap, 0.0, 0.9);
+}
+
+void Analyzer::setThreadCount(int threads)
+{
+    pimpl->threadCount = std::max(threads, 0);
+}
+
+double Analyzer::calculatePower(const double* prefix,
                               int startIndex,
                               int stopIndex)
 {
-    double power = 0.0;
-    for (int i = startIndex; i <= stopIndex; ++i) {
-        power += std::pow(10.0, amplitudes[i] / 10.0);  // dBm -> mW
+    // Önekler monoton artan olduğundan fark hiçbir zaman negatif olmaz
+    const double power = stopIndex >= startIndex ? prefix[stopIndex + 1] - prefix[startIndex] : 0.0;
+    return PowerKernels::linearToDb(power);  // mW -> dBm
+}
+
+const double* Analyzer::powerPrefix(const QVector<double>& amplitudes)
+{
+    // Kimliği bilinmeyen dizi: her çağrıda hesaplanır (tampon korunur)
+    pimpl->prefixScratch.resize(amplitudes.size() + 1);
+    PowerKernels::dbToPrefixSum(amplitudes.constData(), pimpl->prefixScratch.data(), amplitudes.size());
+    return pimpl->prefixScratch.data();
+}
+
+const double* Analyzer::powerPrefix(const Sweep& sweep)
+{
+    if (pimpl->sweepPrefixId != sweep.id() ||
+        static_cast<int>(pimpl->sweepPrefix.size()) != sweep.size() + 1) {
+        pimpl->sweepPrefix.resize(sweep.size() + 1);
+        PowerKernels::dbToPrefixSum(sweep.amplitudes().constData(), pimpl->sweepPrefix.data(), sweep.size());
+        pimpl->sweepPrefixId = sweep.id();
     }
-    return 10.0 * std::log10(power);  // mW -> dBm
+    return pimpl->sweepPrefix.data();
 }
 
 int Analyzer::findFrequencyIndex(const QVector<double>& frequencies,
                                double frequency)
 {
     auto it = std::lower_bound(frequencies.begin(), frequencies.end(), frequency);
-    return static_cast<int>(std::distance(frequencies.begin(), it));
+    const int index = static_cast<int>(std::distance(frequencies.begin(), it));
+    return std::min(index, static_cast<int>(frequencies.size()) - 1);
 }
 
-QVector<double> Analyzer::calculatePSD(const QVector<std::complex<float>>& iqData,
+QVector<double> Analyzer::calculatePSD(const std::complex<float>* iqData,
+                                     qint64 count,
                                      double sampleRate)
 {
-    // Basit bir güç spektral yoğunluk hesabı
-    QVector<double> psd(Impl::FFT_SIZE/2);
+    QVector<double> psd;
+    calculatePSD(iqData, count, sampleRate, psd);
+    return psd;
+}
+
+void Analyzer::calculatePSD(const std::complex<float>* iqData,
+                            qint64 count,
+                            double sampleRate,
+                            QVector<double>& psd)
+{
+    const int n = welchPSD(iqData, count, sampleRate);
+    psd.resize(n);
     
-    // TODO: FFT ve pencere fonksiyonu uygula
+    for (int k = 0; k < n; ++k) {
+        psd[k] = 10.0 * std::log10(std::max(pimpl->psdLinear[k], 1e-30));
+    }
+}
+
+int Analyzer::welchPSD(const std::complex<float>* iqData,
+                       qint64 count,
+                       double sampleRate)
+{
+    if (!iqData || count < 2 || sampleRate <= 0.0) {
+        return 0;
+    }
     
-    return psd;
+    // Kısa bloklarda segment boyu veriye sığacak şekilde küçültülür
+    const int n = std::min(pimpl->fftSize,
+                           FftEngine::floorPowerOfTwo(static_cast<int>(std::min<qint64>(count, 1 << 30))));
+    const qint64 hop = std::max<qint64>(1, static_cast<qint64>(n * (1.0 - pimpl->overlap)));
+    const qint64 totalSegments = (count - n) / hop + 1;
+    
+    // Plan ve pencere worker'lar başlamadan hazırlanır; sonrasında
+    // FftEngine yalnızca okunur ve eşzamanlı kullanılabilir
+    pimpl->fft.prepare(n, pimpl->windowType);
+    const float* window = pimpl->fft.window(pimpl->windowType, n).data();
+    
+    // Parça düzeni thread sayısına bağlı değildir
+    const qint64 chunkSegments = std::max(Impl::MIN_CHUNK_SEGMENTS,
+                                          (totalSegments + Impl::MAX_CHUNKS - 1) / Impl::MAX_CHUNKS);
+    const qint64 chunks = (totalSegments + chunkSegments - 1) / chunkSegments;
+    const int workers = static_cast<int>(std::min<qint64>(pimpl->effectiveThreads(), chunks));
+    
+    // Çalışma tamponları yalnızca boyut değişince büyür
+    if (static_cast<int>(pimpl->segments.size()) < workers) {
+        pimpl->segments.resize(workers);
+    }
+    for (int w = 0; w < workers; ++w) {
+        pimpl->segments[w].resize(n);
+    }
+    pimpl->chunkAccumulators.assign(static_cast<size_t>(chunks) * n, 0.0);
+    
+    std::atomic<qint64> nextChunk{0};
+    auto work = [&](int worker) {
+        std::complex<float>* seg = pimpl->segments[worker].data();
+        for (qint64 c = nextChunk.fetch_add(1); c < chunks; c = nextChunk.fetch_add(1)) {
+            const qint64 first = c * chunkSegments;
+            const qint64 segs = std::min(chunkSegments, totalSegments - first);
+            accumulateSegments(pimpl->fft, window, n, hop, iqData, first, segs, seg,
+                               pimpl->chunkAccumulators.data() + c * n);
+        }
+    };
+    
+    // Çağıran thread de worker 0 olarak çalışır
+    pimpl->pool.setMaxThreadCount(std::max(workers - 1, 1));
+    for (int w = 1; w < workers; ++w) {
+        pimpl->pool.start([&work, w]() { work(w); });
+    }
+    work(0);
+    pimpl->pool.waitForDone();
+    
+    // Parçalar sabit sırayla toplanır
+    pimpl->psdLinear.assign(n, 0.0);
+    double* acc = pimpl->psdLinear.data();
+    for (qint64 c = 0; c < chunks; ++c) {
+        const double* part = pimpl->chunkAccumulators.data() + c * n;
+        for (int k = 0; k < n; ++k) {
+            acc[k] += part[k];
+        }
+    }
+    
+    // Yoğunluk ölçeği: 1 / (segment sayısı * fs * sum(w^2))
+    const double scale = 1.0 / (totalSegments * sampleRate
+                                * pimpl->fft.windowPowerSum(pimpl->windowType, n));
+    for (int k = 0; k < n; ++k) {
+        acc[k] *= scale;
+    }
+    
+    return n;
 }
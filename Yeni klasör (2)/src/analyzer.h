@@ -5,6 +5,10 @@
 #include <QVector>
 #include <complex>
 #include <memory>
+#include "fftengine.h"
+#include "peakdetector.h"
+
+class Sweep;
 
 // Ölçüm sonuçları için yapılar
 struct ACPRResult {
@@ -42,28 +46,85 @@ public:
                           double channelBW,
                           double channelSpacing);
 
+    // Sweep sürümleri: aynı sweep üzerindeki ölçümler kümülatif mW
+    // dizisini bir kez hesaplayıp paylaşır (sweep kimliğiyle önbelleklenir).
+    // OBW, gücün %x'ini içeren bant: kenarlar kümülatif gücün
+    // (100-x)/2 ve (100+x)/2 %'sini geçtiği noktalar, bin içinde aradeğerli.
+    double measureChannelPower(const Sweep& sweep, double startFreq, double stopFreq);
+    double measureOBW(const Sweep& sweep, double percentPower);
+    ACPRResult measureACPR(const Sweep& sweep, double channelBW, double channelSpacing);
+
+    // Spurlar genliğe göre azalan sıradadır; bağıl güç trace'in tek bir
+    // global maksimumuna göredir. Eşik sürümü her yerel maksimumu arar.
     QVector<SpurResult> findSpurs(const QVector<double>& frequencies,
                                  const QVector<double>& amplitudes,
                                  double threshold);
+    QVector<SpurResult> findSpurs(const QVector<double>& frequencies,
+                                 const QVector<double>& amplitudes,
+                                 const PeakSearchSettings& settings);
 
     QVector<double> measurePhaseNoise(const QVector<std::complex<float>>& iqData,
                                     double sampleRate,
                                     const QVector<double>& offsets);
 
+    // IQRingBuffer bloklarını kopyalamadan işlemek için
+    QVector<double> measurePhaseNoise(const std::complex<float>* iqData,
+                                    int count,
+                                    double sampleRate,
+                                    const QVector<double>& offsets);
+
+    // Welch PSD ayarları (FFT boyutu ikinin kuvvetine yuvarlanır)
+    void setPSDParameters(int fftSize, WindowType window, double overlap);
+
+    // Uzun kayıtlarda Welch segmentlerini işleyecek thread sayısı
+    // (0: QThread::idealThreadCount). Sonuç thread sayısından bağımsızdır.
+    void setThreadCount(int threads);
+
+    // Welch ortalamalı PSD (dB/Hz, FFT sırası: DC'den fs'e). Çıkış
+    // tamponu yeniden kullanılır; aynı boyutta tekrarlanan çağrılar
+    // bellek ayırmaz.
+    void calculatePSD(const std::complex<float>* iqData,
+                      qint64 count,
+                      double sampleRate,
+                      QVector<double>& psd);
+
+    QVector<double> calculatePSD(const std::complex<float>* iqData,
+                               qint64 count,
+                               double sampleRate);
+
 private:
     struct Impl;
     std::unique_ptr<Impl> pimpl;
 
     // Yardımcı fonksiyonlar
-    double calculatePower(const QVector<double>& amplitudes,
+    // [startIndex, stopIndex] aralığının gücü (dBm), önek dizisinden O(1)
+    double calculatePower(const double* prefix,
                          int startIndex,
                          int stopIndex);
 
+    // Kümülatif mW dizisi (N+1 eleman); QVector sürümü her çağrıda hesaplar
+    const double* powerPrefix(const QVector<double>& amplitudes);
+    const double* powerPrefix(const Sweep& sweep);
+
+    double channelPower(const QVector<double>& frequencies,
+                       const double* prefix,
+                       double startFreq,
+                       double stopFreq);
+    double occupiedBandwidth(const QVector<double>& frequencies,
+                            const double* prefix,
+                            double percentPower);
+    ACPRResult adjacentChannelPower(const QVector<double>& frequencies,
+                                   const double* prefix,
+                                   double channelBW,
+                                   double channelSpacing);
+
     int findFrequencyIndex(const QVector<double>& frequencies,
                           double frequency);
 
-    QVector<double> calculatePSD(const QVector<std::complex<float>>& iqData,
-                               double sampleRate);
+    // Doğrusal PSD'yi pimpl->psdLinear'a yazar, kullanılan FFT boyutunu döndürür
+    int welchPSD(const std::complex<float>* iqData,
+                 qint64 count,
+                 double sampleRate);
 };
 
 #endif // ANALYZER_H
@@ -0,0 +1,271 @@
+#include "channelizer.h"
+#include "firfilter.h"
+#include "nco.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+#include <immintrin.h>
+#define CHANNELIZER_KERNEL_AVX2 1
+#endif
+
+namespace {
+
+constexpr int CHUNK_SIZE = 4096;              // NCO ve ilk aşama parça boyu (örnek)
+constexpr double STAGE_ATTENUATION_DB = 80.0; // Katlanma (aliasing) bastırması
+constexpr double CHANNEL_TRANSITION = 0.2;    // Kanal filtresi geçişi / kanal genişliği
+constexpr double MIN_OVERSAMPLE = 2.0;        // Çıkış hızı / kanal genişliği alt sınırı
+
+// Karmaşık giriş ile gerçek katsayıların iç çarpımı. h her katsayıyı
+// re/im için iki kez içerir; floats 8'in katıdır.
+inline std::complex<float> dotComplexReal(const float* h, const float* x, int floats)
+{
+#if defined(CHANNELIZER_KERNEL_AVX2)
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    int j = 0;
+    for (; j + 16 <= floats; j += 16) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(h + j), _mm256_loadu_ps(x + j), acc0);
+        acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(h + j + 8), _mm256_loadu_ps(x + j + 8), acc1);
+    }
+    for (; j < floats; j += 8) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(h + j), _mm256_loadu_ps(x + j), acc0);
+    }
+    float acc[8];
+    _mm256_storeu_ps(acc, _mm256_add_ps(acc0, acc1));
+#else
+    // Lane'ler bağımsız olduğundan derleyici döngüyü vektörleştirebilir
+    float acc[8] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+    for (int j = 0; j < floats; j += 8) {
+        for (int k = 0; k < 8; ++k) {
+            acc[k] += h[j + k] * x[j + k];
+        }
+    }
+#endif
+    return {acc[0] + acc[2] + acc[4] + acc[6], acc[1] + acc[3] + acc[5] + acc[7]};
+}
+
+// Polifaz desimatör: yalnızca tutulan her M'inci çıkış hesaplanır, bu da
+// M alt filtreli polifaz yapısıyla aynı işlem sayısıdır. Geçmiş örnekler
+// sabit çalışma tamponunda taşınır.
+class DecimatingFir {
+public:
+    DecimatingFir(const std::vector<float>& taps, int decimation, int maxInput)
+        : decimation(std::max(decimation, 1))
+        , maxInput(std::max(maxInput, 1))
+    {
+        const int numTaps = static_cast<int>(taps.size());
+        paddedTaps = (numTaps + GROUP - 1) / GROUP * GROUP;
+
+        // Ters çevrilmiş ve başı sıfırla doldurulmuş, her katsayı re/im için çift
+        coeffs.assign(2 * paddedTaps, 0.0f);
+        const int pad = paddedTaps - numTaps;
+        for (int j = 0; j < numTaps; ++j) {
+            coeffs[2 * (pad + j)] = taps[numTaps - 1 - j];
+            coeffs[2 * (pad + j) + 1] = taps[numTaps - 1 - j];
+        }
+
+        work.assign(2 * (paddedTaps - 1 + this->maxInput), 0.0f);
+    }
+
+    void reset()
+    {
+        std::fill(work.begin(), work.end(), 0.0f);
+        nextOutput = 0;
+    }
+
+    int maxOutput(int count) const { return count / decimation + 1; }
+
+    int process(const std::complex<float>* in, int count, std::complex<float>* out)
+    {
+        const int history = paddedTaps - 1;
+        float* buffer = work.data();
+        int produced = 0;
+
+        for (int offset = 0; offset < count; offset += maxInput) {
+            const int n = std::min(maxInput, count - offset);
+            std::memcpy(buffer + 2 * history, in + offset, sizeof(std::complex<float>) * n);
+
+            for (; nextOutput < n; nextOutput += decimation) {
+                out[produced++] = dotComplexReal(coeffs.data(), buffer + 2 * nextOutput,
+                                                 2 * paddedTaps);
+            }
+            nextOutput -= n;
+
+            std::memmove(buffer, buffer + 2 * n, sizeof(std::complex<float>) * history);
+        }
+        return produced;
+    }
+
+private:
+    static constexpr int GROUP = 4;  // 4 karmaşık tap = 8 float
+
+    int decimation;
+    int maxInput;
+    int paddedTaps{0};
+    int nextOutput{0};          // Sıradaki çıkışın parçadaki giriş indeksi
+    std::vector<float> coeffs;
+    std::vector<float> work;    // [geçmiş (paddedTaps-1) | parça], karmaşık
+};
+
+} // namespace
+
+struct Channelizer::Impl {
+    double inputRate{0.0};
+    double outputRate{0.0};
+    int decimation{1};
+
+    Nco nco;
+    std::vector<Stage> stages;
+    std::vector<DecimatingFir> filters;
+    // buffers[0]: karıştırılmış parça, buffers[i]: (i-1). aşamanın çıkışı
+    std::vector<std::vector<std::complex<float>>> buffers;
+};
+
+Channelizer::Channelizer()
+    : pimpl(std::make_unique<Impl>())
+{
+}
+
+Channelizer::~Channelizer() = default;
+
+std::vector<int> Channelizer::planDecimation(double inputRate, double minOutputRate)
+{
+    std::vector<int> factors;
+    if (inputRate <= 0.0 || minOutputRate <= 0.0) {
+        return factors;
+    }
+
+    // İlk aşamalar yüksek hızda çalışır ama geçiş bantları geniştir; büyük
+    // oranı başa koymak sonraki aşamaların giriş hızını en çok düşürür
+    double remaining = inputRate / minOutputRate;
+    while (remaining >= 2.0) {
+        const int factor = std::min(MAX_STAGE_DECIMATION, static_cast<int>(remaining));
+        factors.push_back(factor);
+        remaining /= factor;
+    }
+    return factors;
+}
+
+void Channelizer::configure(double inputRate, double offset, double bandwidth, double minOutputRate)
+{
+    Impl& d = *pimpl;
+    d.inputRate = std::max(inputRate, 1.0);
+    bandwidth = std::clamp(bandwidth, 1.0, d.inputRate);
+
+    d.stages.clear();
+    d.filters.clear();
+    d.buffers.clear();
+    d.buffers.emplace_back(CHUNK_SIZE);
+
+    const double halfBand = bandwidth / 2.0;
+    const double minRate = std::max(minOutputRate, MIN_OVERSAMPLE * bandwidth);
+
+    double rate = d.inputRate;
+    int maxInput = CHUNK_SIZE;
+    d.decimation = 1;
+
+    auto addStage = [&](const std::vector<float>& taps, int factor) {
+        d.stages.push_back({factor, static_cast<int>(taps.size()), rate});
+        d.filters.emplace_back(taps, factor, maxInput);
+        maxInput = d.filters.back().maxOutput(maxInput);
+        d.buffers.emplace_back(maxInput);
+        rate /= factor;
+        d.decimation *= factor;
+    };
+
+    for (int factor : planDecimation(d.inputRate, minRate)) {
+        // Geçiş bandı: kanal kenarından, çıkışta kanala katlanacak ilk
+        // frekansa (fout - kanal kenarı) kadar
+        const double outRate = rate / factor;
+        addStage(FirFilter::designLowpass(0.5 / factor, (outRate - bandwidth) / rate,
+                                          STAGE_ATTENUATION_DB),
+                 factor);
+    }
+
+    // Son kanal filtresi: kanal dışındaki sinyaller demodülatöre ulaşmasın
+    const double transition = CHANNEL_TRANSITION * bandwidth;
+    if (halfBand + transition < rate / 2.0) {
+        addStage(FirFilter::designLowpass((halfBand + transition / 2.0) / rate,
+                                          transition / rate, STAGE_ATTENUATION_DB),
+                 1);
+    }
+
+    d.outputRate = rate;
+    setOffset(offset);
+    reset();
+}
+
+void Channelizer::setOffset(double offset)
+{
+    // Kanal merkezi 0 Hz'e indirilir
+    pimpl->nco.setFrequency(-offset, pimpl->inputRate);
+}
+
+void Channelizer::reset()
+{
+    pimpl->nco.reset();
+    for (auto& filter : pimpl->filters) {
+        filter.reset();
+    }
+}
+
+int Channelizer::process(const std::complex<float>* in, int count, std::complex<float>* out)
+{
+    Impl& d = *pimpl;
+    if (!in || !out || count <= 0) {
+        return 0;
+    }
+
+    if (d.filters.empty()) {
+        d.nco.mix(in, out, count);
+        return count;
+    }
+
+    int produced = 0;
+    for (int offset = 0; offset < count; offset += CHUNK_SIZE) {
+        const int n = std::min(CHUNK_SIZE, count - offset);
+        d.nco.mix(in + offset, d.buffers[0].data(), n);
+
+        const std::complex<float>* src = d.buffers[0].data();
+        int length = n;
+        for (size_t s = 0; s < d.filters.size(); ++s) {
+            std::complex<float>* dst = s + 1 == d.filters.size() ? out + produced
+                                                                 : d.buffers[s + 1].data();
+            length = d.filters[s].process(src, length, dst);
+            src = dst;
+        }
+        produced += length;
+    }
+    return produced;
+}
+
+int Channelizer::maxOutput(int count) const
+{
+    // Her aşama kendi toplam girişinin 1/M'inden en fazla bir fazla çıkış verir
+    for (const auto& stage : pimpl->stages) {
+        count = count / stage.decimation + 1;
+    }
+    return count;
+}
+
+double Channelizer::inputRate() const
+{
+    return pimpl->inputRate;
+}
+
+double Channelizer::outputRate() const
+{
+    return pimpl->outputRate;
+}
+
+int Channelizer::decimation() const
+{
+    return pimpl->decimation;
+}
+
+const std::vector<Channelizer::Stage>& Channelizer::stages() const
+{
+    return pimpl->stages;
+}
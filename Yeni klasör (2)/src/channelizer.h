@@ -0,0 +1,56 @@
+#ifndef CHANNELIZER_H
+#define CHANNELIZER_H
+
+#include <complex>
+#include <memory>
+#include <vector>
+
+// Tam hızlı IQ akışından tek bir dar bant kanal çıkarır: NCO ile kanal
+// merkezi 0 Hz'e kaydırılır, ardından çok aşamalı polifaz FIR
+// desimatörleri ve son bir kanal filtresi uygulanır. Aşama planı giriş
+// hızı ve kanal bant genişliğinden otomatik hesaplanır; her aşama yalnızca
+// tutulan çıkışları hesaplar ve durumunu çağrılar arasında korur.
+class Channelizer {
+public:
+    struct Stage {
+        int decimation{1};      // 1 = desimasyonsuz kanal filtresi
+        int taps{0};
+        double inputRate{0.0};
+    };
+
+    Channelizer();
+    ~Channelizer();
+
+    Channelizer(const Channelizer&) = delete;
+    Channelizer& operator=(const Channelizer&) = delete;
+
+    // offset: IQ merkezine göre kanal merkezi (Hz), bandwidth: kanalın
+    // toplam genişliği (Hz). Çıkış hızı en az minOutputRate olur.
+    void configure(double inputRate, double offset, double bandwidth,
+                   double minOutputRate = DEFAULT_OUTPUT_RATE);
+    // Yalnızca NCO'yu yeniden ayarlar; filtre durumları korunur
+    void setOffset(double offset);
+    void reset();
+
+    // Çıkış örnek sayısını döndürür; out en az maxOutput(count) eleman
+    // almalıdır. Bellek ayırmaz.
+    int process(const std::complex<float>* in, int count, std::complex<float>* out);
+    int maxOutput(int count) const;
+
+    double inputRate() const;
+    double outputRate() const;
+    int decimation() const;
+    const std::vector<Stage>& stages() const;
+
+    // Toplam desimasyonu aşamalara böler (büyük oranlar önce)
+    static std::vector<int> planDecimation(double inputRate, double minOutputRate);
+
+    static constexpr double DEFAULT_OUTPUT_RATE = 48e3;
+    static constexpr int MAX_STAGE_DECIMATION = 8;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pimpl;
+};
+
+#endif // CHANNELIZER_H
@@ -1,15 +1,106 @@
 #include "datamanager.h"
+#include "iqfilereader.h"
+#include "tracefile.h"
 #include <QFile>
 #include <QDataStream>
 #include <QTextStream>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QtEndian>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
 
 // PIMPL implementation
 struct DataManager::Impl {
-    // Dosya formatı versiyonu
+    // Eski JSON trace formatının versiyonu (yalnızca okunur)
     static constexpr int FILE_VERSION = 1;
+
+    // IQ gövdesi bu boyutta parçalarla aktarılır (8 MB)
+    static constexpr qint64 IQ_CHUNK_BYTES = qint64(8) << 20;
+
+    // Kompakt gövdeyi IQ_CHUNK_BYTES'lık cf32 dilimleri halinde kodlar
+    static bool writeCompact(QFile& file, const QVector<std::complex<float>>& iqData,
+                             const IQEncoding& encoding)
+    {
+        IQCodec codec(encoding);
+        const qint64 chunk = std::max<qint64>(
+            IQ_CHUNK_BYTES / qint64(sizeof(std::complex<float>))
+                / encoding.blockSamples * encoding.blockSamples,
+            encoding.blockSamples);
+        std::vector<char> blocks;
+        for (qint64 first = 0; first < iqData.size(); first += chunk) {
+            blocks.clear();
+            codec.encode(iqData.constData() + first,
+                         std::min<qint64>(chunk, iqData.size() - first), blocks);
+            if (file.write(blocks.data(), qint64(blocks.size())) != qint64(blocks.size()))
+                return false;
+        }
+        return true;
+    }
+
+    // Blokları sırayla okuyup çözer; parça sonunda kalan yarım blok bir
+    // sonraki okumanın başına taşınır
+    static bool readCompact(QFile& file, const IQFileHeader& info,
+                            QVector<std::complex<float>>& iqData, QString& error)
+    {
+        IQCodec codec(info.encoding);
+        iqData.clear();
+        qint64 remaining = file.size() - info.dataOffset;
+        // Başlıktaki sayıya (bozuk olabilir) değil, dosyanın sıkıştırmasız
+        // taşıyabileceği örnek sayısına göre ayrılır; sıkıştırılmış blok
+        // fazlası okunurken büyür
+        const qint64 sampleBytes = info.encoding.format == IQSampleFormat::CI8 ? 2 : 4;
+        iqData.reserve(qsizetype(std::min<quint64>(info.sampleCount,
+                                                   quint64(remaining / sampleBytes))));
+        std::vector<char> buffer;
+        qint64 pending = 0;
+        while (remaining > 0 || pending > 0) {
+            const qint64 length = std::min(IQ_CHUNK_BYTES, remaining);
+            buffer.resize(size_t(pending + length));
+            if (length > 0 && file.read(buffer.data() + pending, length) != length) {
+                error = file.errorString();
+                return false;
+            }
+            remaining -= length;
+
+            const qint64 available = pending + length;
+            qint64 position = 0;
+            int samples = 0;
+            qint64 blockBytes = 0;
+            while (IQCodec::blockInfo(buffer.data() + position, available - position,
+                                      samples, blockBytes)
+                   && blockBytes <= available - position) {
+                const qsizetype offset = iqData.size();
+                iqData.resize(offset + samples);
+                if (codec.decodeBlock(buffer.data() + position, available - position,
+                                      iqData.data() + offset) != blockBytes) {
+                    error = QObject::tr("Bozuk dosya formatı");
+                    return false;
+                }
+                position += blockBytes;
+            }
+
+            pending = available - position;
+            if ((pending > 0 && remaining == 0)
+                || (pending >= IQCodec::BLOCK_HEADER_SIZE
+                    && !IQCodec::blockInfo(buffer.data() + position, pending,
+                                           samples, blockBytes))) {
+                // Geçersiz blok başlığı ya da yarım blokla biten (kesik) kayıt
+                error = QObject::tr("Bozuk dosya formatı");
+                return false;
+            }
+            std::memmove(buffer.data(), buffer.data() + position, size_t(pending));
+        }
+
+        if (info.sampleCount != 0 && quint64(iqData.size()) != info.sampleCount) {
+            error = QObject::tr("Bozuk dosya formatı");
+            return false;
+        }
+        return true;
+    }
 };
 
 DataManager::DataManager(QObject *parent)
@@ -22,35 +113,74 @@ DataManager::~DataManager() = default;
 
 bool DataManager::saveTrace(const QString& filename,
                           const QVector<double>& frequencies,
-                          const QVector<double>& amplitudes)
+                          const QVector<double>& amplitudes,
+                          const BBSettings& settings,
+                          qint64 timestamp)
 {
     if (frequencies.size() != amplitudes.size()) {
         setError(tr("Frekans ve genlik vektörlerinin boyutları eşleşmiyor"));
         return false;
     }
 
-    QJsonObject root;
-    root["version"] = Impl::FILE_VERSION;
-    root["size"] = frequencies.size();
-
-    QJsonArray freqArray;
-    QJsonArray ampArray;
-
-    for (int i = 0; i < frequencies.size(); ++i) {
-        freqArray.append(frequencies[i]);
-        ampArray.append(amplitudes[i]);
+    // Eksen başlangıç/adım olarak saklanır; bin'in binde birinden büyük
+    // sapma doğrusal olmayan eksen demektir
+    const int count = frequencies.size();
+    const double start = count > 0 ? frequencies.first() : 0.0;
+    const double step = count > 1 ? (frequencies.last() - start) / (count - 1) : 0.0;
+    const double tolerance = 1e-3 * std::max(std::abs(step), 1.0);
+    for (int i = 0; i < count; ++i) {
+        if (std::abs(frequencies[i] - (start + i * step)) > tolerance) {
+            setError(tr("Frekans ekseni doğrusal değil; CSV olarak dışa aktarın"));
+            return false;
+        }
     }
 
-    root["frequencies"] = freqArray;
-    root["amplitudes"] = ampArray;
-
-    QJsonDocument doc(root);
-    return writeFile(filename, doc.toJson());
+    TraceFileWriter writer;
+    if (!writer.open(filename, settings, timestamp)
+        || !writer.append(timestamp, start, step, amplitudes.constData(), count)
+        || !writer.close()) {
+        setError(writer.errorString());
+        return false;
+    }
+    return true;
 }
 
 bool DataManager::loadTrace(const QString& filename,
                           QVector<double>& frequencies,
                           QVector<double>& amplitudes)
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        setError(file.errorString());
+        return false;
+    }
+    char magic[4];
+    const qint64 length = file.read(magic, sizeof(magic));
+    file.close();
+
+    if (TraceFileHeader::matches(magic, length)) {
+        TraceFileReader reader;
+        if (!reader.open(filename)) {
+            setError(reader.errorString());
+            return false;
+        }
+        if (reader.sweepCount() == 0) {
+            setError(tr("Dosyada sweep yok"));
+            return false;
+        }
+        if (!reader.readSweep(reader.sweepCount() - 1, frequencies, amplitudes)) {
+            setError(reader.errorString());
+            return false;
+        }
+        return true;
+    }
+
+    return loadJsonTrace(filename, frequencies, amplitudes);
+}
+
+bool DataManager::loadJsonTrace(const QString& filename,
+                                QVector<double>& frequencies,
+                                QVector<double>& amplitudes)
 {
     QByteArray data;
     if (!readFile(filename, data)) {
@@ -126,6 +256,124 @@ bool DataManager::loadState(const QString& filename, QByteArray& state)
     return readFile(filename, state);
 }
 
+bool DataManager::saveIQData(const QString& filename,
+                             const QVector<std::complex<float>>& iqData,
+                             double sampleRate,
+                             double centerFreq,
+                             const IQEncoding& encoding)
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        setError(file.errorString());
+        return false;
+    }
+
+    IQFileHeader info;
+    info.sampleRate = sampleRate;
+    info.centerFreq = centerFreq;
+    info.sampleCount = static_cast<quint64>(iqData.size());
+    info.encoding = IQCodec(encoding).encoding();
+    char header[IQFileHeader::SIZE];
+    info.write(header);
+    if (file.write(header, sizeof(header)) != qint64(sizeof(header))) {
+        setError(file.errorString());
+        return false;
+    }
+
+    if (info.encoding.isCompact()) {
+        if (!Impl::writeCompact(file, iqData, info.encoding)) {
+            setError(file.errorString());
+            return false;
+        }
+        return true;
+    }
+
+    // complex<float> bellekte I, Q sıralı iki float'tır
+    const char* body = reinterpret_cast<const char*>(iqData.constData());
+    const qint64 total = qint64(iqData.size()) * qint64(sizeof(std::complex<float>));
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+    QByteArray swapped;
+#endif
+    for (qint64 offset = 0; offset < total;) {
+        const qint64 length = std::min(Impl::IQ_CHUNK_BYTES, total - offset);
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+        swapped.resize(length);
+        qbswap<quint32>(body + offset, length / 4, swapped.data());
+        const qint64 written = file.write(swapped.constData(), length);
+#else
+        const qint64 written = file.write(body + offset, length);
+#endif
+        if (written != length) {
+            setError(file.errorString());
+            return false;
+        }
+        offset += length;
+    }
+
+    return true;
+}
+
+bool DataManager::loadIQData(const QString& filename,
+                             QVector<std::complex<float>>& iqData,
+                             double& sampleRate,
+                             double& centerFreq)
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        setError(file.errorString());
+        return false;
+    }
+
+    char header[IQFileHeader::SIZE];
+    if (file.read(header, sizeof(header)) != qint64(sizeof(header))) {
+        setError(tr("Geçersiz IQ dosyası"));
+        return false;
+    }
+    IQFileHeader info;
+    QString error;
+    if (!info.read(header, file.size(), error)) {
+        setError(error);
+        return false;
+    }
+    if (!file.seek(info.dataOffset)) {
+        setError(file.errorString());
+        return false;
+    }
+
+    if (info.encoding.isCompact()) {
+        if (!Impl::readCompact(file, info, iqData, error)) {
+            setError(error);
+            iqData.clear();
+            return false;
+        }
+        sampleRate = info.sampleRate;
+        centerFreq = info.centerFreq;
+        return true;
+    }
+
+    const quint64 count = info.sampleCount;
+    const qint64 sampleBytes = qint64(sizeof(std::complex<float>));
+    iqData.resize(qsizetype(count));
+    char* body = reinterpret_cast<char*>(iqData.data());
+    const qint64 total = qint64(count) * sampleBytes;
+    for (qint64 offset = 0; offset < total;) {
+        const qint64 length = std::min(Impl::IQ_CHUNK_BYTES, total - offset);
+        if (file.read(body + offset, length) != length) {
+            setError(file.errorString());
+            iqData.clear();
+            return false;
+        }
+        offset += length;
+    }
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+    qbswap<quint32>(body, total / 4, body);
+#endif
+
+    sampleRate = info.sampleRate;
+    centerFreq = info.centerFreq;
+    return true;
+}
+
 QString DataManager::getLastError() const
 {
     return lastError;
@@ -1,9 +1,12 @@
 #ifndef DATAMANAGER_H
 #define DATAMANAGER_H
 
+#include "bb_api.h"
+#include "iqcodec.h"
 #include <QObject>
 #include <QVector>
 #include <QString>
+#include <complex>
 #include <memory>
 
 class DataManager : public QObject
@@ -13,10 +16,16 @@ public:
     explicit DataManager(QObject *parent = nullptr);
     ~DataManager() override;
 
-    // Trace kaydetme/yükleme
+    // Trace kaydetme/yükleme. Trace tek sweep'lik ikili trace dosyası
+    // olarak yazılır (bkz. TraceFileHeader): eksen başlangıç/adım, genlikler
+    // float32 sütun, ayarlar başlıkta. Frekans ekseni doğrusal olmalıdır.
+    // loadTrace çok sweep'li oturum dosyalarında son sweep'i, eski JSON
+    // trace dosyalarında tek trace'i yükler.
     bool saveTrace(const QString& filename,
                    const QVector<double>& frequencies,
-                   const QVector<double>& amplitudes);
+                   const QVector<double>& amplitudes,
+                   const BBSettings& settings = BBSettings(),
+                   qint64 timestamp = 0);
 
     bool loadTrace(const QString& filename,
                    QVector<double>& frequencies,
@@ -34,6 +43,24 @@ public:
     bool loadState(const QString& filename,
                    QByteArray& state);
 
+    // IQ kaydetme/yükleme. Dosya 64 baytlık başlık (örnekleme hızı, merkez
+    // frekans, 64 bit örnek sayısı; bkz. IQFileHeader) ve ardından
+    // küçük-endian, I/Q sıralı ham cf32 gövdeden oluşur; gövde vektörün
+    // belleğinden parça parça tek write()/read() çağrılarıyla aktarılır.
+    // Kompakt encoding verilirse gövde IQCodec bloklarıdır (int16/int8,
+    // isteğe bağlı sıkıştırma); loadIQData biçimi başlıktan tanır.
+    // Belleğe sığmayan cf32 kayıtlar IQFileReader ile eşlenerek okunur.
+    bool saveIQData(const QString& filename,
+                    const QVector<std::complex<float>>& iqData,
+                    double sampleRate,
+                    double centerFreq,
+                    const IQEncoding& encoding = IQEncoding());
+
+    bool loadIQData(const QString& filename,
+                    QVector<std::complex<float>>& iqData,
+                    double& sampleRate,
+                    double& centerFreq);
+
     // Hata mesajı
     QString getLastError() const;
 
@@ -44,6 +71,9 @@ private:
 
     // Yardımcı fonksiyonlar
     void setError(const QString& error);
+    bool loadJsonTrace(const QString& filename,
+                       QVector<double>& frequencies,
+                       QVector<double>& amplitudes);
     bool writeFile(const QString& filename, const QByteArray& data);
     bool readFile(const QString& filename, QByteArray& data);
 };
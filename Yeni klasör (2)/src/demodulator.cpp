@@ -1,12 +1,28 @@
 #include "demodulator.h"
+#include "channelizer.h"
+#include "firfilter.h"
+#include "nco.h"
 #include <cmath>
 #include <algorithm>
+#include <vector>
+
+namespace {
+constexpr int DEMOD_CHUNK = 16384;             // Kanallaştırıcıya verilen parça (IQ örneği)
+constexpr double AUDIO_TRANSITION = 0.25;      // Ses filtresi geçişi / bant genişliği
+constexpr double AUDIO_ATTENUATION_DB = 60.0;
+}
 
 // PIMPL implementation
 struct Demodulator::Impl {
-    // Filtre katsayıları ve geçici tamponlar
-    QVector<float> filterCoeffs;
-    QVector<float> delayLine;
+    // Tam hızlı IQ'dan kanalı ses hızına indirir
+    Channelizer channelizer;
+    std::vector<std::complex<float>> baseband;
+    // SSB: kanal ortasını taşıyıcıya geri kaydırır
+    Nco ssbShift;
+
+    // Filtre katsayıları ve blok sınırları arasında geçmişi tutan filtre
+    std::vector<float> filterCoeffs;
+    FirFilter filter;
     
     // FM demodülasyon için önceki faz
     float prevPhase{0.0f};
@@ -15,15 +31,12 @@ struct Demodulator::Impl {
 Demodulator::Demodulator(QObject *parent)
     : QObject(parent)
     , pimpl(std::make_unique<Impl>())
-    , mode(AM)
+    , mode(Mode::AM)
     , centerFreq(1e6)  // 1 MHz
     , bw(10e3)         // 10 kHz
-    , vol(1.0f)
+    , vol(0.5f)
 {
-    // Varsayılan alçak geçiren filtre katsayıları
-    pimpl->filterCoeffs = {0.1f, 0.2f, 0.4f, 0.2f, 0.1f};
-    pimpl->delayLine.resize(pimpl->filterCoeffs.size());
-    updateFilterCoeffs();
+    updateChannel();
 }
 
 Demodulator::~Demodulator() = default;
@@ -32,7 +45,7 @@ void Demodulator::setMode(Mode newMode)
 {
     if (mode != newMode) {
         mode = newMode;
-        updateFilterCoeffs();
+        updateChannel();
     }
 }
 
@@ -40,7 +53,8 @@ void Demodulator::setFrequency(double freq)
 {
     if (centerFreq != freq) {
         centerFreq = freq;
-        updateFilterCoeffs();
+        // Yalnızca NCO yeniden ayarlanır; filtre durumu korunur, ses kesilmez
+        pimpl->channelizer.setOffset(channelOffset());
     }
 }
 
@@ -48,53 +62,105 @@ void Demodulator::setBandwidth(double bandwidth)
 {
     if (bw != bandwidth) {
         bw = bandwidth;
-        updateFilterCoeffs();
+        updateChannel();
+    }
+}
+
+void Demodulator::setSampleRate(double rate)
+{
+    if (rate > 0.0 && inputRate != rate) {
+        inputRate = rate;
+        updateChannel();
     }
 }
 
-void Demodulator::setVolume(float volume)
+double Demodulator::audioRate() const
+{
+    return pimpl->channelizer.outputRate();
+}
+
+int Demodulator::maxAudioSamples(int iqCount) const
+{
+    return pimpl->channelizer.maxOutput(iqCount);
+}
+
+void Demodulator::setVolume(int volume)
 {
-    vol = std::clamp(volume, 0.0f, 1.0f);
+    vol = std::clamp(volume, 0, 100) / 100.0f;
 }
 
 QVector<float> Demodulator::demodulate(const QVector<std::complex<float>>& iqData)
 {
-    switch (mode) {
-    case AM:
-        return demodulateAM(iqData);
-    case FM:
-        return demodulateFM(iqData);
-    case USB:
-        return demodulateSSB(iqData, true);
-    case LSB:
-        return demodulateSSB(iqData, false);
-    case CW:
-        return demodulateCW(iqData);
-    default:
+    return demodulate(iqData.constData(), iqData.size());
+}
+
+QVector<float> Demodulator::demodulate(const std::complex<float>* iqData, int count)
+{
+    if (mode == Mode::None) {
         return QVector<float>();
     }
+    
+    QVector<float> audioData(maxAudioSamples(count));
+    audioData.resize(demodulate(iqData, count, audioData.data()));
+    return audioData;
 }
 
-QVector<float> Demodulator::demodulateAM(const QVector<std::complex<float>>& iqData)
+int Demodulator::demodulate(const std::complex<float>* iqData, int count, float* audio)
 {
-    QVector<float> audioData(iqData.size());
+    if (mode == Mode::None || !iqData || !audio) {
+        return 0;
+    }
+
+    int produced = 0;
+    for (int offset = 0; offset < count; offset += DEMOD_CHUNK) {
+        const int n = std::min(DEMOD_CHUNK, count - offset);
+
+        // Kanal seçimi ve desimasyon; demodülasyon ses hızında yapılır
+        std::complex<float>* baseband = pimpl->baseband.data();
+        const int m = pimpl->channelizer.process(iqData + offset, n, baseband);
+
+        switch (mode) {
+        case Mode::AM:
+            demodulateAM(baseband, m, audio + produced);
+            break;
+        case Mode::FM:
+            demodulateFM(baseband, m, audio + produced);
+            break;
+        case Mode::USB:
+        case Mode::LSB:
+        case Mode::CW:
+            // CW için üst yan bant kullanılır
+            pimpl->ssbShift.mix(baseband, baseband, m);
+            demodulateSSB(baseband, m, audio + produced);
+            break;
+        default:
+            return 0;
+        }
+        produced += m;
+    }
+    return produced;
+}
+
+void Demodulator::demodulateAM(const std::complex<float>* iqData, int count, float* audio)
+{
+    const float gain = vol * 100.0f;
     
     // AM demodülasyon: Genlik hesapla
-    for (int i = 0; i < iqData.size(); ++i) {
-        float magnitude = std::sqrt(std::norm(iqData[i]));
-        audioData[i] = magnitude * vol * 100.0f;
+    for (int i = 0; i < count; ++i) {
+        const float re = iqData[i].real();
+        const float im = iqData[i].imag();
+        audio[i] = std::sqrt(re * re + im * im) * gain;
     }
     
-    applyBandwidth(audioData);
-    return audioData;
+    applyBandwidth(audio, count);
 }
 
-QVector<float> Demodulator::demodulateFM(const QVector<std::complex<float>>& iqData)
+void Demodulator::demodulateFM(const std::complex<float>* iqData, int count, float* audio)
 {
-    QVector<float> audioData(iqData.size());
+    const float gain = vol * 100.0f;
     
     // FM demodülasyon: Faz farkını hesapla
-    for (int i = 0; i < iqData.size(); ++i) {
+    for (int i = 0; i < count; ++i) {
         float phase = std::arg(iqData[i]);
         float phaseDiff = phase - pimpl->prevPhase;
         
@@ -102,80 +168,66 @@ QVector<float> Demodulator::demodulateFM(const QVector<std::complex<float>>& iqD
         if (phaseDiff > M_PI) phaseDiff -= 2*M_PI;
         if (phaseDiff < -M_PI) phaseDiff += 2*M_PI;
         
-        audioData[i] = phaseDiff * vol * 100.0f;
+        audio[i] = phaseDiff * gain;
         pimpl->prevPhase = phase;
     }
     
-    applyBandwidth(audioData);
-    return audioData;
+    applyBandwidth(audio, count);
 }
 
-QVector<float> Demodulator::demodulateSSB(const QVector<std::complex<float>>& iqData, bool upperSideband)
+void Demodulator::demodulateSSB(const std::complex<float>* iqData, int count, float* audio)
 {
-    QVector<float> audioData(iqData.size());
+    const float gain = vol * 100.0f;
     
-    // SSB demodülasyon: Hilbert dönüşümü ile
-    for (int i = 0; i < iqData.size(); ++i) {
-        float real = iqData[i].real();
-        float imag = iqData[i].imag();
-        
-        // USB için topla, LSB için çıkar
-        audioData[i] = upperSideband ? (real + imag) : (real - imag);
-        audioData[i] *= vol * 100.0f;
+    // SSB demodülasyon: kanal tek yan bandı seçip taşıyıcıyı 0 Hz'e
+    // getirdiğinden (Weaver yöntemi) gerçek kısım ses sinyalidir
+    for (int i = 0; i < count; ++i) {
+        audio[i] = iqData[i].real() * gain;
     }
-    
-    return audioData;
 }
 
-void Demodulator::updateFilterCoeffs()
+double Demodulator::channelOffset() const
 {
-    // Basit bir alçak geçiren filtre tasarımı
-    const int ORDER = 64;
-    pimpl->filterCoeffs.resize(ORDER);
-
-    double fc = bw / 2.0;  // Kesim frekansı
-    double sum = 0.0;
-
-    for (int i = 0; i < ORDER; ++i) {
-        if (i == ORDER/2) {
-            pimpl->filterCoeffs[i] = 2.0 * fc;
-        } else {
-            double x = M_PI * (i - ORDER/2);
-            pimpl->filterCoeffs[i] = std::sin(2.0 * fc * x) / x;
-        }
-        // Blackman penceresi uygula
-        pimpl->filterCoeffs[i] *= 0.42 - 0.5 * std::cos(2.0 * M_PI * i / ORDER)
-                           + 0.08 * std::cos(4.0 * M_PI * i / ORDER);
-        sum += pimpl->filterCoeffs[i];
-    }
-
-    // Normalize et
-    for (float& coeff : pimpl->filterCoeffs) {
-        coeff /= sum;
+    // SSB'de kanal, taşıyıcının seçilen yan bandı üzerinde ortalanır
+    switch (mode) {
+    case Mode::USB:
+    case Mode::CW:
+        return centerFreq + bw / 2.0;
+    case Mode::LSB:
+        return centerFreq - bw / 2.0;
+    default:
+        return centerFreq;
     }
 }
 
-void Demodulator::applyBandwidth(QVector<float>& audio)
+void Demodulator::updateChannel()
 {
-    QVector<float> filtered(audio.size());
+    // Aşama planı giriş hızı ve bant genişliğinden otomatik hesaplanır
+    pimpl->channelizer.configure(inputRate, channelOffset(), bw);
+    pimpl->baseband.resize(pimpl->channelizer.maxOutput(DEMOD_CHUNK));
 
-    // Konvolüsyon ile filtreleme
-    for (size_t i = 0; i < audio.size(); ++i) {
-        float sum = 0.0f;
-        for (size_t j = 0; j < pimpl->filterCoeffs.size(); ++j) {
-            if (i >= j) {
-                sum += audio[i-j] * pimpl->filterCoeffs[j];
-            }
-        }
-        filtered[i] = sum;
-    }
+    const double shift = mode == Mode::LSB ? -bw / 2.0 : bw / 2.0;
+    pimpl->ssbShift.setFrequency(shift, pimpl->channelizer.outputRate());
+    pimpl->ssbShift.reset();
+
+    pimpl->prevPhase = 0.0f;
+    updateFilterCoeffs();
+}
 
-    audio = std::move(filtered);
+void Demodulator::updateFilterCoeffs()
+{
+    // Ses bandı filtresi kanallaştırıcı çıkış hızına göre normalize edilir
+    const double rate = pimpl->channelizer.outputRate();
+    pimpl->filterCoeffs = FirFilter::designLowpass(bw / 2.0 / rate,
+                                                   AUDIO_TRANSITION * bw / rate,
+                                                   AUDIO_ATTENUATION_DB);
+    
+    // Yeni katsayılar geçmişi sıfırlar
+    pimpl->filter.setCoefficients(pimpl->filterCoeffs);
 }
 
-void Demodulator::applyVolume(QVector<float>& audio)
+void Demodulator::applyBandwidth(float* audio, int count)
 {
-    for (float& sample : audio) {
-        sample *= vol;
-    }
+    // Durum tutan FIR: yerinde, bellek ayırmadan, bloklar arası süreklilikle
+    pimpl->filter.process(audio, count);
 }
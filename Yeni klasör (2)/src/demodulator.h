@@ -15,7 +15,8 @@ public:
         AM,
         FM,
         USB,
-        LSB
+        LSB,
+        CW
     };
     Q_ENUM(Mode)
 
@@ -24,18 +25,30 @@ public:
 
     // Ayarlar
     void setMode(Mode mode);
+    // IQ merkezine göre kanal ofseti (Hz)
     void setFrequency(double freq);
     void setBandwidth(double bw);
     void setVolume(int volume);
+    // Giriş IQ örnekleme hızı (BBSettings::sampleRate)
+    void setSampleRate(double rate);
 
     // Demodülasyon
     QVector<float> demodulate(const QVector<std::complex<float>>& iqData);
+    // IQRingBuffer bloklarını kopyalamadan işlemek için
+    QVector<float> demodulate(const std::complex<float>* iqData, int count);
+    // Çağıranın tamponuna yazar (en az maxAudioSamples(count) eleman),
+    // üretilen ses örneği sayısını döndürür; bellek ayırmaz
+    int demodulate(const std::complex<float>* iqData, int count, float* audio);
+    int maxAudioSamples(int iqCount) const;
 
     // Durum sorgulama
     Mode currentMode() const { return mode; }
-    double frequency() const { return frequency; }
-    double bandwidth() const { return bandwidth; }
-    int volume() const { return volume; }
+    double frequency() const { return centerFreq; }
+    double bandwidth() const { return bw; }
+    int volume() const { return static_cast<int>(vol * 100.0f + 0.5f); }
+    double sampleRate() const { return inputRate; }
+    // Kanallaştırıcı çıkışındaki (ses) örnekleme hızı
+    double audioRate() const;
 
 private:
     struct Impl;
@@ -43,14 +56,21 @@ private:
 
     // Demodülasyon parametreleri
     Mode mode{Mode::None};
-    double frequency{1e6};  // 1 MHz
-    double bandwidth{10e3}; // 10 kHz
-    int volume{50};        // 0-100 arası
+    double centerFreq{1e6};  // 1 MHz ofset
+    double bw{10e3};         // 10 kHz
+    float vol{0.5f};         // 0-1 arası
+    double inputRate{40e6};  // 40 MHz
 
     // Demodülasyon fonksiyonları
-    QVector<float> demodulateAM(const QVector<std::complex<float>>& iqData);
-    QVector<float> demodulateFM(const QVector<std::complex<float>>& iqData);
-    QVector<float> demodulateSSB(const QVector<std::complex<float>>& iqData, bool upperSideband);
+    void demodulateAM(const std::complex<float>* iqData, int count, float* audio);
+    void demodulateFM(const std::complex<float>* iqData, int count, float* audio);
+    void demodulateSSB(const std::complex<float>* iqData, int count, float* audio);
+
+    // Kanallaştırıcı ve filtreleme
+    void updateChannel();
+    double channelOffset() const;
+    void updateFilterCoeffs();
+    void applyBandwidth(float* audio, int count);
 };
 
 #endif // DEMODULATOR_H
@@ -0,0 +1,179 @@
+#include "demodulatorbank.h"
+#include "fftengine.h"
+#include "filterbank.h"
+#include <algorithm>
+
+namespace {
+constexpr int BANK_CHUNK = 16384;  // Filtre bankasına verilen parça (IQ örneği)
+}
+
+struct DemodulatorBank::Impl {
+    struct ChannelState {
+        Channel definition;
+        std::unique_ptr<Demodulator> demodulator;
+        int activeIndex{-1};       // Filtre bankası çıkış indeksi
+        std::vector<float> audio;
+        int audioCount{0};
+    };
+
+    double inputRate{40e6};
+    int volume{50};
+    std::vector<ChannelState> channels;
+
+    PolyphaseFilterbank filterbank;
+    bool useFilterbank{false};
+};
+
+DemodulatorBank::DemodulatorBank()
+    : pimpl(std::make_unique<Impl>())
+{
+}
+
+DemodulatorBank::~DemodulatorBank() = default;
+
+void DemodulatorBank::setSampleRate(double rate)
+{
+    if (rate > 0.0 && pimpl->inputRate != rate) {
+        pimpl->inputRate = rate;
+        rebuild();
+    }
+}
+
+void DemodulatorBank::setChannels(const std::vector<Channel>& channels)
+{
+    pimpl->channels.clear();
+    for (const Channel& definition : channels) {
+        Impl::ChannelState state;
+        state.definition = definition;
+        state.demodulator = std::make_unique<Demodulator>();
+        pimpl->channels.push_back(std::move(state));
+    }
+    rebuild();
+}
+
+void DemodulatorBank::setVolume(int volume)
+{
+    pimpl->volume = volume;
+    for (auto& state : pimpl->channels) {
+        state.demodulator->setVolume(volume);
+    }
+}
+
+void DemodulatorBank::rebuild()
+{
+    Impl& d = *pimpl;
+
+    double widest = 0.0;
+    for (const auto& state : d.channels) {
+        widest = std::max(widest, state.definition.bandwidth);
+    }
+
+    // Alt bant aralığı en geniş kanalın iki katından küçük olmamalı
+    int bins = 0;
+    if (static_cast<int>(d.channels.size()) >= FILTERBANK_MIN_CHANNELS && widest > 0.0) {
+        const double limit = std::min<double>(MAX_FILTERBANK_BINS, d.inputRate / (2.0 * widest));
+        bins = limit >= 1.0 ? FftEngine::floorPowerOfTwo(static_cast<int>(limit)) : 0;
+    }
+    d.useFilterbank = bins >= MIN_FILTERBANK_BINS;
+
+    std::vector<int> activeBins;
+    if (d.useFilterbank) {
+        d.filterbank.configure(bins, d.inputRate);
+    }
+
+    for (auto& state : d.channels) {
+        const Channel& ch = state.definition;
+        Demodulator& demod = *state.demodulator;
+        demod.setVolume(d.volume);
+        demod.setMode(ch.mode);
+        demod.setBandwidth(ch.bandwidth);
+
+        if (d.useFilterbank) {
+            // Kanal en yakın alt banda atanır; kalan ofset ince ayardır
+            const int bin = d.filterbank.binForFrequency(ch.offset);
+            auto it = std::find(activeBins.begin(), activeBins.end(), bin);
+            state.activeIndex = static_cast<int>(it - activeBins.begin());
+            if (it == activeBins.end()) {
+                activeBins.push_back(bin);
+            }
+            demod.setSampleRate(d.filterbank.outputRate());
+            demod.setFrequency(ch.offset - d.filterbank.binCenter(bin));
+        } else {
+            state.activeIndex = -1;
+            demod.setSampleRate(d.inputRate);
+            demod.setFrequency(ch.offset);
+        }
+        state.audioCount = 0;
+    }
+
+    if (d.useFilterbank) {
+        d.filterbank.setActiveBins(activeBins);
+    }
+}
+
+void DemodulatorBank::process(const std::complex<float>* iqData, int count)
+{
+    Impl& d = *pimpl;
+
+    // Ses tamponları yalnızca daha büyük bir blok geldiğinde büyütülür
+    for (auto& state : d.channels) {
+        const int inputs = d.useFilterbank ? count / (d.filterbank.bins() / 2) + 1 : count;
+        const size_t needed = static_cast<size_t>(state.demodulator->maxAudioSamples(inputs));
+        if (state.audio.size() < needed) {
+            state.audio.resize(needed);
+        }
+        state.audioCount = 0;
+    }
+
+    if (!iqData || count <= 0) {
+        return;
+    }
+
+    if (!d.useFilterbank) {
+        for (auto& state : d.channels) {
+            state.audioCount = state.demodulator->demodulate(iqData, count, state.audio.data());
+        }
+        return;
+    }
+
+    // Tam hızlı iş (polifaz toplamı + FFT) tüm kanallar için bir kez yapılır
+    for (int offset = 0; offset < count; offset += BANK_CHUNK) {
+        const int n = std::min(BANK_CHUNK, count - offset);
+        const int m = d.filterbank.process(iqData + offset, n);
+
+        for (auto& state : d.channels) {
+            state.audioCount += state.demodulator->demodulate(
+                d.filterbank.output(state.activeIndex), m, state.audio.data() + state.audioCount);
+        }
+    }
+}
+
+int DemodulatorBank::channelCount() const
+{
+    return static_cast<int>(pimpl->channels.size());
+}
+
+const DemodulatorBank::Channel& DemodulatorBank::channel(int index) const
+{
+    return pimpl->channels[index].definition;
+}
+
+const float* DemodulatorBank::audio(int index) const
+{
+    return pimpl->channels[index].audio.data();
+}
+
+int DemodulatorBank::audioCount(int index) const
+{
+    return pimpl->channels[index].audioCount;
+}
+
+double DemodulatorBank::audioRate(int index) const
+{
+    return pimpl->channels[index].demodulator->audioRate();
+}
+
+int DemodulatorBank::filterbankBins() const
+{
+    return pimpl->useFilterbank ? pimpl->filterbank.bins() : 0;
+}
@@ -0,0 +1,57 @@
+#ifndef DEMODULATORBANK_H
+#define DEMODULATORBANK_H
+
+#include "demodulator.h"
+#include <complex>
+#include <memory>
+#include <vector>
+
+// Tek bir IQ akışındaki birden çok dar bant kanalı aynı geçişte demodüle
+// eder. Kanal sayısı yeterliyse IQ bloğu bir kez ortak polifaz filtre
+// bankasından geçirilir; her kanal kendi alt bandını düşük hızda ince
+// ayar, filtre ve demodülasyondan geçirir. Böylece tam hızlı iş kanal
+// sayısından bağımsız kalır. Az kanalda her kanal doğrudan tam hızdan
+// kanallaştırılır.
+class DemodulatorBank {
+public:
+    struct Channel {
+        double offset{0.0};        // IQ merkezine göre (Hz)
+        double bandwidth{10e3};    // Hz
+        Demodulator::Mode mode{Demodulator::Mode::AM};
+    };
+
+    DemodulatorBank();
+    ~DemodulatorBank();
+
+    DemodulatorBank(const DemodulatorBank&) = delete;
+    DemodulatorBank& operator=(const DemodulatorBank&) = delete;
+
+    void setSampleRate(double rate);
+    void setChannels(const std::vector<Channel>& channels);
+    void setVolume(int volume);
+
+    // Bloğu tüm kanallar için işler; sonuçlar bir sonraki çağrıya kadar
+    // audio()/audioCount() ile okunur
+    void process(const std::complex<float>* iqData, int count);
+
+    int channelCount() const;
+    const Channel& channel(int index) const;
+    const float* audio(int index) const;
+    int audioCount(int index) const;
+    double audioRate(int index) const;
+
+    // Kullanılan filtre bankası alt bant sayısı; 0 ise doğrudan yol
+    int filterbankBins() const;
+
+    static constexpr int FILTERBANK_MIN_CHANNELS = 4;
+    static constexpr int MIN_FILTERBANK_BINS = 16;
+    static constexpr int MAX_FILTERBANK_BINS = 1024;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pimpl;
+
+    void rebuild();
+};
+
+#endif // DEMODULATORBANK_H
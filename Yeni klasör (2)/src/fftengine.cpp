@@ -0,0 +1,162 @@
+#include "fftengine.h"
+#include <cmath>
+#include <utility>
+
+// Boyut başına önceden hesaplanan FFT planı
+struct FftEngine::Plan {
+    int size{0};
+    // Bit-ters çevirme için yer değiştirecek indeks çiftleri
+    std::vector<std::pair<int, int>> swaps;
+    // Aşama başına ardışık twiddle'lar: yarı uzunluğu h olan aşama
+    // [h-1, 2h-1) aralığını kullanır, toplam n-1 eleman
+    std::vector<std::complex<float>> twiddles;
+};
+
+FftEngine::FftEngine() = default;
+
+FftEngine::~FftEngine() = default;
+
+int FftEngine::floorPowerOfTwo(int n)
+{
+    int p = 1;
+    while (p <= n / 2) {
+        p <<= 1;
+    }
+    return n > 0 ? p : 0;
+}
+
+void FftEngine::prepare(int n, WindowType type)
+{
+    plan(n);
+    windowTable(type, n);
+}
+
+const FftEngine::Plan& FftEngine::plan(int n)
+{
+    auto it = plans.find(n);
+    if (it != plans.end()) {
+        return *it->second;
+    }
+
+    auto p = std::make_unique<Plan>();
+    p->size = n;
+
+    int bits = 0;
+    while ((1 << bits) < n) {
+        ++bits;
+    }
+    for (int i = 0; i < n; ++i) {
+        int r = 0;
+        for (int b = 0; b < bits; ++b) {
+            r |= ((i >> b) & 1) << (bits - 1 - b);
+        }
+        if (i < r) {
+            p->swaps.emplace_back(i, r);
+        }
+    }
+
+    // Twiddle'lar çift hassasiyette hesaplanıp float'a indirilir
+    p->twiddles.resize(n > 1 ? n - 1 : 0);
+    for (int h = 1; h < n; h <<= 1) {
+        for (int k = 0; k < h; ++k) {
+            double angle = -M_PI * k / h;
+            p->twiddles[h - 1 + k] = std::complex<float>(static_cast<float>(std::cos(angle)),
+                                                         static_cast<float>(std::sin(angle)));
+        }
+    }
+
+    const Plan& ref = *p;
+    plans.emplace(n, std::move(p));
+    return ref;
+}
+
+void FftEngine::forward(std::complex<float>* data, int n)
+{
+    if (!data || !isPowerOfTwo(n) || n < 2) {
+        return;
+    }
+
+    const Plan& p = plan(n);
+
+    for (const auto& s : p.swaps) {
+        std::swap(data[s.first], data[s.second]);
+    }
+
+    // std::complex çarpımı NaN/inf kontrolleri yüzünden yavaş; elle açıldı
+    float* d = reinterpret_cast<float*>(data);
+
+    // İlk aşama: twiddle = 1
+    for (int i = 0; i < 2 * n; i += 4) {
+        float ar = d[i], ai = d[i + 1];
+        float br = d[i + 2], bi = d[i + 3];
+        d[i] = ar + br;
+        d[i + 1] = ai + bi;
+        d[i + 2] = ar - br;
+        d[i + 3] = ai - bi;
+    }
+
+    for (int h = 2; h < n; h <<= 1) {
+        const float* tw = reinterpret_cast<const float*>(p.twiddles.data() + (h - 1));
+        for (int start = 0; start < n; start += 2 * h) {
+            float* a = d + 2 * start;
+            float* b = d + 2 * (start + h);
+            for (int k = 0; k < h; ++k) {
+                float wr = tw[2 * k], wi = tw[2 * k + 1];
+                float br = b[2 * k] * wr - b[2 * k + 1] * wi;
+                float bi = b[2 * k] * wi + b[2 * k + 1] * wr;
+                float ar = a[2 * k], ai = a[2 * k + 1];
+                a[2 * k] = ar + br;
+                a[2 * k + 1] = ai + bi;
+                b[2 * k] = ar - br;
+                b[2 * k + 1] = ai - bi;
+            }
+        }
+    }
+}
+
+const std::vector<float>& FftEngine::window(WindowType type, int n)
+{
+    return windowTable(type, n).coeffs;
+}
+
+double FftEngine::windowPowerSum(WindowType type, int n)
+{
+    return windowTable(type, n).powerSum;
+}
+
+const FftEngine::WindowTable& FftEngine::windowTable(WindowType type, int n)
+{
+    const auto key = std::make_pair(static_cast<int>(type), n);
+    auto it = windows.find(key);
+    if (it != windows.end()) {
+        return it->second;
+    }
+
+    WindowTable table;
+    table.coeffs.resize(n);
+
+    // Spektral analiz için periyodik (DFT-even) pencereler
+    for (int i = 0; i < n; ++i) {
+        const double x = 2.0 * M_PI * i / n;
+        double w = 1.0;
+        switch (type) {
+        case WindowType::Rectangular:
+            w = 1.0;
+            break;
+        case WindowType::Hann:
+            w = 0.5 - 0.5 * std::cos(x);
+            break;
+        case WindowType::Blackman:
+            w = 0.42 - 0.5 * std::cos(x) + 0.08 * std::cos(2.0 * x);
+            break;
+        case WindowType::FlatTop:
+            w = 0.21557895 - 0.41663158 * std::cos(x) + 0.277263158 * std::cos(2.0 * x)
+                - 0.083578947 * std::cos(3.0 * x) + 0.006947368 * std::cos(4.0 * x);
+            break;
+        }
+        table.coeffs[i] = static_cast<float>(w);
+        table.powerSum += w * w;
+    }
+
+    return windows.emplace(key, std::move(table)).first->second;
+}
@@ -0,0 +1,55 @@
+#ifndef FFTENGINE_H
+#define FFTENGINE_H
+
+#include <complex>
+#include <map>
+#include <memory>
+#include <vector>
+
+// Pencere fonksiyonları
+enum class WindowType {
+    Rectangular,
+    Hann,
+    Blackman,
+    FlatTop
+};
+
+// Kendi kendine yeten radix-2 karmaşık FFT. Bit-ters çevirme tabloları,
+// twiddle'lar ve pencere tabloları boyut başına bir kez hesaplanıp
+// saklanır; aynı boyutta tekrarlanan çağrılar bellek ayırmaz.
+class FftEngine {
+public:
+    FftEngine();
+    ~FftEngine();
+
+    FftEngine(const FftEngine&) = delete;
+    FftEngine& operator=(const FftEngine&) = delete;
+
+    // Yerinde ileri FFT; n ikinin kuvveti olmalı
+    void forward(std::complex<float>* data, int n);
+
+    // Önbellekteki pencere tablosu ve güç normalizasyonu (sum w^2)
+    const std::vector<float>& window(WindowType type, int n);
+    double windowPowerSum(WindowType type, int n);
+
+    // Plan ve pencereyi önceden hazırla (gerçek zamanlı yolda ayırma olmasın)
+    void prepare(int n, WindowType type);
+
+    static bool isPowerOfTwo(int n) { return n > 0 && (n & (n - 1)) == 0; }
+    static int floorPowerOfTwo(int n);
+
+private:
+    struct Plan;
+    struct WindowTable {
+        std::vector<float> coeffs;
+        double powerSum{0.0};
+    };
+
+    std::map<int, std::unique_ptr<Plan>> plans;
+    std::map<std::pair<int, int>, WindowTable> windows;
+
+    const Plan& plan(int n);
+    const WindowTable& windowTable(WindowType type, int n);
+};
+
+#endif // FFTENGINE_H
@@ -0,0 +1,195 @@
+#include "filterbank.h"
+#include "fftengine.h"
+#include "firfilter.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+constexpr int CHUNK_SIZE = 8192;               // Çalışma tamponu parçası (giriş örneği)
+constexpr double PROTOTYPE_ATTENUATION_DB = 80.0;
+}
+
+struct PolyphaseFilterbank::Impl {
+    int bins{0};
+    int hop{0};                 // Çıkışlar arası giriş örneği (bins / 2)
+    int taps{0};                // Prototip uzunluğu, bins'in katı
+    double inputRate{0.0};
+
+    // Ters çevrilmiş prototip, her katsayı re/im için çift
+    std::vector<float> coeffs;
+    // [geçmiş (taps-1) | parça], karmaşık
+    std::vector<float> work;
+    // Polifaz dalı toplamları (2 * bins float) ve FFT tamponu
+    std::vector<float> branch;
+    std::vector<std::complex<float>> spectrum;
+    FftEngine fft;
+
+    int nextOutput{0};          // Sıradaki çıkışın parçadaki giriş indeksi
+    int inputPhase{0};          // İşlenen toplam giriş örneği mod bins
+
+    std::vector<int> active;
+    std::vector<std::vector<std::complex<float>>> outputs;
+
+    void computeFrame(const float* window, int timeIndex);
+};
+
+PolyphaseFilterbank::PolyphaseFilterbank()
+    : pimpl(std::make_unique<Impl>())
+{
+}
+
+PolyphaseFilterbank::~PolyphaseFilterbank() = default;
+
+void PolyphaseFilterbank::configure(int bins, double inputRate)
+{
+    Impl& d = *pimpl;
+    d.bins = std::max(FftEngine::floorPowerOfTwo(bins), 4);
+    d.hop = d.bins / 2;
+    d.inputRate = inputRate;
+
+    // Prototip: geçiş bandı alt bant aralığının yarısı. Çıkış hızı 2 * aralık
+    // olduğundan kenardaki yarım aralık genişliğindeki kanal katlanmaz.
+    const std::vector<float> prototype = FirFilter::designLowpass(
+        1.0 / d.bins, 0.5 / d.bins, PROTOTYPE_ATTENUATION_DB);
+    d.taps = (static_cast<int>(prototype.size()) + d.bins - 1) / d.bins * d.bins;
+
+    d.coeffs.assign(2 * d.taps, 0.0f);
+    for (size_t n = 0; n < prototype.size(); ++n) {
+        const int m = d.taps - 1 - static_cast<int>(n);
+        d.coeffs[2 * m] = prototype[n];
+        d.coeffs[2 * m + 1] = prototype[n];
+    }
+
+    d.work.assign(2 * (d.taps - 1 + CHUNK_SIZE), 0.0f);
+    d.branch.assign(2 * d.bins, 0.0f);
+    d.spectrum.assign(d.bins, {});
+    d.fft.prepare(d.bins, WindowType::Rectangular);
+
+    setActiveBins(d.active);
+    reset();
+}
+
+void PolyphaseFilterbank::setActiveBins(const std::vector<int>& bins)
+{
+    Impl& d = *pimpl;
+    d.active.clear();
+    for (int bin : bins) {
+        d.active.push_back(d.bins > 0 ? bin & (d.bins - 1) : 0);
+    }
+    d.outputs.resize(d.active.size());
+    for (auto& out : d.outputs) {
+        out.resize(d.hop > 0 ? CHUNK_SIZE / d.hop + 1 : 0);
+    }
+}
+
+void PolyphaseFilterbank::reset()
+{
+    std::fill(pimpl->work.begin(), pimpl->work.end(), 0.0f);
+    pimpl->nextOutput = 0;
+    pimpl->inputPhase = 0;
+}
+
+void PolyphaseFilterbank::Impl::computeFrame(const float* window, int timeIndex)
+{
+    // Dal toplamları: branch[j] = sum_q h'[qK + j] * x'[qK + j]
+    // (ters çevrilmiş prototip ve pencere üzerinde, ardışık bellek)
+    const int width = 2 * bins;
+    std::fill(branch.begin(), branch.end(), 0.0f);
+    for (int q = 0; q < taps; q += bins) {
+        const float* h = coeffs.data() + 2 * q;
+        const float* x = window + 2 * q;
+        float* acc = branch.data();
+        for (int j = 0; j < width; ++j) {
+            acc[j] += h[j] * x[j];
+        }
+    }
+
+    // j. dal gecikmesi (K - 1 - j) olan örnekleri toplar. Zaman indeksine
+    // göre dairesel kaydırma, alt bant çıkışlarını mutlak zamana göre
+    // 0 Hz'e indirir (her alt bant için ayrı karıştırıcı gerekmez).
+    const int mask = bins - 1;
+    for (int r = 0; r < bins; ++r) {
+        const int j = mask - ((r + timeIndex) & mask);
+        spectrum[r] = std::complex<float>(branch[2 * j], branch[2 * j + 1]);
+    }
+
+    fft.forward(spectrum.data(), bins);
+}
+
+int PolyphaseFilterbank::process(const std::complex<float>* in, int count)
+{
+    Impl& d = *pimpl;
+    if (!in || count <= 0 || d.bins == 0) {
+        return 0;
+    }
+
+    // Çağrı başına çıkış sayısı sınırı aşılırsa tamponlar bir kez büyütülür
+    const size_t needed = static_cast<size_t>(count / d.hop + 1);
+    for (auto& out : d.outputs) {
+        if (out.size() < needed) {
+            out.resize(needed);
+        }
+    }
+
+    const int history = d.taps - 1;
+    const int mask = d.bins - 1;
+    float* buffer = d.work.data();
+    int produced = 0;
+
+    for (int offset = 0; offset < count; offset += CHUNK_SIZE) {
+        const int n = std::min(CHUNK_SIZE, count - offset);
+        std::memcpy(buffer + 2 * history, in + offset, sizeof(std::complex<float>) * n);
+
+        for (; d.nextOutput < n; d.nextOutput += d.hop) {
+            d.computeFrame(buffer + 2 * d.nextOutput, d.inputPhase + d.nextOutput);
+
+            // Alt bant k, FFT çıkışında (K - k) mod K indeksindedir
+            for (size_t a = 0; a < d.active.size(); ++a) {
+                d.outputs[a][produced] = d.spectrum[(d.bins - d.active[a]) & mask];
+            }
+            ++produced;
+        }
+        d.nextOutput -= n;
+        d.inputPhase = (d.inputPhase + n) & mask;
+
+        std::memmove(buffer, buffer + 2 * n, sizeof(std::complex<float>) * history);
+    }
+    return produced;
+}
+
+const std::complex<float>* PolyphaseFilterbank::output(int activeIndex) const
+{
+    return pimpl->outputs[activeIndex].data();
+}
+
+int PolyphaseFilterbank::bins() const
+{
+    return pimpl->bins;
+}
+
+double PolyphaseFilterbank::binSpacing() const
+{
+    return pimpl->bins > 0 ? pimpl->inputRate / pimpl->bins : 0.0;
+}
+
+double PolyphaseFilterbank::outputRate() const
+{
+    return 2.0 * binSpacing();
+}
+
+int PolyphaseFilterbank::binForFrequency(double freq) const
+{
+    const double spacing = binSpacing();
+    if (spacing <= 0.0) {
+        return 0;
+    }
+    return static_cast<int>(std::lround(freq / spacing)) & (pimpl->bins - 1);
+}
+
+double PolyphaseFilterbank::binCenter(int bin) const
+{
+    // Üst yarıdaki alt bantlar negatif frekanslardır
+    const int k = bin & (pimpl->bins - 1);
+    return (k < pimpl->bins / 2 ? k : k - pimpl->bins) * binSpacing();
+}
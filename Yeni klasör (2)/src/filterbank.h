@@ -0,0 +1,48 @@
+#ifndef FILTERBANK_H
+#define FILTERBANK_H
+
+#include <complex>
+#include <memory>
+#include <vector>
+
+// 2 kat aşırı örneklenmiş polifaz FFT analiz filtre bankası. Giriş bandı
+// bins eşit aralıklı alt banda bölünür (aralık inputRate / bins); her
+// alt bant 0 Hz'e indirilmiş olarak 2 * inputRate / bins hızında verilir.
+// Aşırı örnekleme sayesinde alt bant kenarına denk gelen dar kanallar da
+// katlanmadan çıkarılabilir. Maliyet kanal sayısından bağımsızdır: her
+// bins/2 giriş örneğinde bir polifaz toplamı ve bir FFT.
+class PolyphaseFilterbank {
+public:
+    PolyphaseFilterbank();
+    ~PolyphaseFilterbank();
+
+    PolyphaseFilterbank(const PolyphaseFilterbank&) = delete;
+    PolyphaseFilterbank& operator=(const PolyphaseFilterbank&) = delete;
+
+    // bins ikinin kuvveti olmalı (>= 4)
+    void configure(int bins, double inputRate);
+    // Çıkışı istenen alt bantlar (0..bins-1, negatif frekanslar sondan)
+    void setActiveBins(const std::vector<int>& bins);
+    void reset();
+
+    // Her aktif alt bant için üretilen örnek sayısını döndürür; çıktılar
+    // bir sonraki process çağrısına kadar output() ile okunur
+    int process(const std::complex<float>* in, int count);
+    const std::complex<float>* output(int activeIndex) const;
+
+    int bins() const;
+    double binSpacing() const;
+    double outputRate() const;
+    // frekansa (Hz, IQ merkezine göre) en yakın alt bant ve merkezi
+    int binForFrequency(double freq) const;
+    double binCenter(int bin) const;
+
+    // Bir kanalın alt bantta katlanmadan taşınabileceği en büyük genişlik
+    double maxChannelBandwidth() const { return binSpacing() / 2.0; }
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pimpl;
+};
+
+#endif // FILTERBANK_H
@@ -0,0 +1,199 @@
+#include "firfilter.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+#include <immintrin.h>
+#define FIR_KERNEL_AVX2 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define FIR_KERNEL_NEON 1
+#endif
+
+namespace {
+
+// y[i] = sum_j h[j] * x[i + j], i = 0..count-1
+// x en az count + taps - 1 eleman içerir, taps 8'in katıdır
+void firKernel(const float* h, int taps, const float* x, float* y, int count)
+{
+    int i = 0;
+
+#if defined(FIR_KERNEL_AVX2)
+    // 32 çıkış birlikte: dört bağımsız akümülatör FMA gecikmesini gizler
+    for (; i + 32 <= count; i += 32) {
+        __m256 acc0 = _mm256_setzero_ps();
+        __m256 acc1 = _mm256_setzero_ps();
+        __m256 acc2 = _mm256_setzero_ps();
+        __m256 acc3 = _mm256_setzero_ps();
+        const float* xp = x + i;
+        for (int j = 0; j < taps; ++j) {
+            const __m256 c = _mm256_broadcast_ss(h + j);
+            acc0 = _mm256_fmadd_ps(c, _mm256_loadu_ps(xp + j), acc0);
+            acc1 = _mm256_fmadd_ps(c, _mm256_loadu_ps(xp + j + 8), acc1);
+            acc2 = _mm256_fmadd_ps(c, _mm256_loadu_ps(xp + j + 16), acc2);
+            acc3 = _mm256_fmadd_ps(c, _mm256_loadu_ps(xp + j + 24), acc3);
+        }
+        _mm256_storeu_ps(y + i, acc0);
+        _mm256_storeu_ps(y + i + 8, acc1);
+        _mm256_storeu_ps(y + i + 16, acc2);
+        _mm256_storeu_ps(y + i + 24, acc3);
+    }
+#elif defined(FIR_KERNEL_NEON)
+    for (; i + 8 <= count; i += 8) {
+        float32x4_t acc0 = vdupq_n_f32(0.0f);
+        float32x4_t acc1 = vdupq_n_f32(0.0f);
+        const float* xp = x + i;
+        for (int j = 0; j < taps; ++j) {
+            const float32x4_t c = vdupq_n_f32(h[j]);
+            acc0 = vmlaq_f32(acc0, c, vld1q_f32(xp + j));
+            acc1 = vmlaq_f32(acc1, c, vld1q_f32(xp + j + 4));
+        }
+        vst1q_f32(y + i, acc0);
+        vst1q_f32(y + i + 4, acc1);
+    }
+#else
+    // Skaler yol: 8 çıkış birlikte, çıkışlar üzerinde vektörleştirilebilir
+    for (; i + 8 <= count; i += 8) {
+        float acc[8] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+        const float* xp = x + i;
+        for (int j = 0; j < taps; ++j) {
+            const float c = h[j];
+            for (int k = 0; k < 8; ++k) {
+                acc[k] += c * xp[j + k];
+            }
+        }
+        for (int k = 0; k < 8; ++k) {
+            y[i + k] = acc[k];
+        }
+    }
+#endif
+
+    // Kalan çıkışlar
+    for (; i < count; ++i) {
+        float acc = 0.0f;
+        for (int j = 0; j < taps; ++j) {
+            acc += h[j] * x[i + j];
+        }
+        y[i] = acc;
+    }
+}
+
+// Birinci tür sıfırıncı mertebe değiştirilmiş Bessel fonksiyonu (seri açılımı)
+double besselI0(double x)
+{
+    double sum = 1.0;
+    double term = 1.0;
+    const double q = x * x / 4.0;
+    for (int k = 1; k < 64 && term > sum * 1e-12; ++k) {
+        term *= q / (static_cast<double>(k) * k);
+        sum += term;
+    }
+    return sum;
+}
+
+} // namespace
+
+FirFilter::FirFilter() = default;
+
+FirFilter::FirFilter(const std::vector<float>& coeffs)
+{
+    setCoefficients(coeffs);
+}
+
+void FirFilter::setCoefficients(const std::vector<float>& coeffs)
+{
+    numTaps = static_cast<int>(coeffs.size());
+    paddedTaps = (numTaps + LANES - 1) / LANES * LANES;
+
+    // Konvolüsyon, ters çevrilmiş katsayılarla iç çarpım olarak yapılır;
+    // dolgu sıfırları en eski geçmiş örneklerle çarpılır
+    reversed.assign(paddedTaps, 0.0f);
+    const int pad = paddedTaps - numTaps;
+    for (int j = 0; j < numTaps; ++j) {
+        reversed[pad + j] = coeffs[numTaps - 1 - j];
+    }
+
+    work.assign(std::max(paddedTaps - 1, 0) + BLOCK_SIZE, 0.0f);
+}
+
+void FirFilter::reset()
+{
+    std::fill(work.begin(), work.end(), 0.0f);
+}
+
+void FirFilter::process(float* data, int count)
+{
+    process(data, data, count);
+}
+
+void FirFilter::process(const float* in, float* out, int count)
+{
+    if (numTaps == 0) {
+        if (in != out) {
+            std::memmove(out, in, sizeof(float) * std::max(count, 0));
+        }
+        return;
+    }
+
+    const int history = paddedTaps - 1;
+    float* buffer = work.data();
+
+    for (int offset = 0; offset < count; offset += BLOCK_SIZE) {
+        const int n = std::min(BLOCK_SIZE, count - offset);
+
+        // Parça geçmişin arkasına kopyalanır; çıkış girişin üzerine yazılabilir
+        std::memcpy(buffer + history, in + offset, sizeof(float) * n);
+        firKernel(reversed.data(), paddedTaps, buffer, out + offset, n);
+
+        // Sonraki parça için son örnekleri geçmişe taşı
+        std::memmove(buffer, buffer + n, sizeof(float) * history);
+    }
+}
+
+std::vector<float> FirFilter::designLowpass(double cutoff, double transition, double attenuationDb)
+{
+    cutoff = std::clamp(cutoff, 1e-6, 0.5);
+    transition = std::max(transition, 1e-6);
+
+    // Kaiser tahmini; tek sayıda tap ile doğrusal fazlı (tip I) filtre
+    int taps = static_cast<int>(std::ceil((attenuationDb - 7.95) / (14.36 * transition))) + 1;
+    taps = std::clamp(taps | 1, 3, MAX_DESIGN_TAPS);
+
+    double beta = 0.0;
+    if (attenuationDb > 50.0) {
+        beta = 0.1102 * (attenuationDb - 8.7);
+    } else if (attenuationDb > 21.0) {
+        beta = 0.5842 * std::pow(attenuationDb - 21.0, 0.4) + 0.07886 * (attenuationDb - 21.0);
+    }
+
+    std::vector<double> h(taps);
+    const int mid = taps / 2;
+    const double norm = besselI0(beta);
+    double sum = 0.0;
+    for (int i = 0; i < taps; ++i) {
+        const int n = i - mid;
+        const double ideal = n == 0 ? 2.0 * cutoff
+                                    : std::sin(2.0 * M_PI * cutoff * n) / (M_PI * n);
+        const double r = static_cast<double>(n) / mid;
+        h[i] = ideal * besselI0(beta * std::sqrt(std::max(0.0, 1.0 - r * r))) / norm;
+        sum += h[i];
+    }
+
+    std::vector<float> coeffs(taps);
+    for (int i = 0; i < taps; ++i) {
+        coeffs[i] = static_cast<float>(h[i] / sum);
+    }
+    return coeffs;
+}
+
+const char* FirFilter::kernelName()
+{
+#if defined(FIR_KERNEL_AVX2)
+    return "avx2";
+#elif defined(FIR_KERNEL_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
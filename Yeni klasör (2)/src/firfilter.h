@@ -0,0 +1,46 @@
+#ifndef FIRFILTER_H
+#define FIRFILTER_H
+
+#include <vector>
+
+// Durum tutan (streaming) gerçek FIR filtre. Geçmiş örnekler çağrılar
+// arasında korunur, böylece blok sınırlarında süreksizlik oluşmaz.
+// Çalışma tamponu sabit boyutludur; process() bellek ayırmaz.
+// İç döngü AVX2/FMA veya NEON ile vektörleştirilir, yoksa skaler yol
+// (derleyicinin otomatik vektörleştirebileceği biçimde) kullanılır.
+class FirFilter {
+public:
+    FirFilter();
+    explicit FirFilter(const std::vector<float>& coeffs);
+
+    // Katsayıları ayarlar ve geçmişi sıfırlar
+    void setCoefficients(const std::vector<float>& coeffs);
+    void reset();
+
+    // Yerinde filtreleme (in == out olabilir)
+    void process(float* data, int count);
+    void process(const float* in, float* out, int count);
+
+    int taps() const { return numTaps; }
+
+    // Derlenen çekirdeğin adı ("avx2", "neon", "scalar")
+    static const char* kernelName();
+
+    // Kaiser pencereli sinc alçak geçiren tasarımı. cutoff ve transition
+    // örnekleme hızına göre normalize (0-0.5); tap sayısı geçiş bandı ve
+    // istenen bastırmadan kestirilir, DC kazancı 1'dir
+    static std::vector<float> designLowpass(double cutoff, double transition,
+                                            double attenuationDb = 80.0);
+
+private:
+    static constexpr int BLOCK_SIZE = 1024;  // Çalışma tamponu parçası
+    static constexpr int LANES = 8;          // Katsayılar bu katına tamamlanır
+    static constexpr int MAX_DESIGN_TAPS = 4095;
+
+    int numTaps{0};
+    int paddedTaps{0};
+    std::vector<float> reversed;  // Ters çevrilmiş, başı sıfırla doldurulmuş
+    std::vector<float> work;      // [geçmiş (paddedTaps-1) | parça]
+};
+
+#endif // FIRFILTER_H
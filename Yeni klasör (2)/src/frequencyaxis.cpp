@@ -0,0 +1,63 @@
+#include "frequencyaxis.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+namespace {
+
+// Sürümler süreç genelinde tekildir; farklı kaynaklardan (cihaz, dosya)
+// gelen eksenler hiçbir zaman aynı sürümü taşımaz
+std::atomic<quint64> nextVersion{1};
+
+} // namespace
+
+FrequencyAxis::FrequencyAxis(double start, double stop, int count)
+    : axisVersion(nextVersion.fetch_add(1, std::memory_order_relaxed))
+    , startFreq(start)
+    , stopFreq(stop)
+    , frequencies(std::max(count, 0))
+{
+    const int n = frequencies.size();
+    double* out = frequencies.data();
+    for (int i = 0; i < n; ++i) {
+        out[i] = n > 1 ? start + i * (stop - start) / (n - 1) : start;
+    }
+}
+
+FrequencyAxis::FrequencyAxis(const QVector<double>& values)
+    : axisVersion(nextVersion.fetch_add(1, std::memory_order_relaxed))
+    , startFreq(values.isEmpty() ? 0.0 : values.first())
+    , stopFreq(values.isEmpty() ? 0.0 : values.last())
+    , frequencies(values)
+{
+}
+
+FrequencyAxisPtr FrequencyAxis::create(double start, double stop, int count)
+{
+    return std::make_shared<const FrequencyAxis>(start, stop, count);
+}
+
+FrequencyAxisPtr FrequencyAxis::fromValues(const QVector<double>& values)
+{
+    return std::make_shared<const FrequencyAxis>(values);
+}
+
+int FrequencyAxis::indexOf(double frequency) const
+{
+    if (frequencies.isEmpty())
+        return -1;
+
+    const double* first = frequencies.constData();
+    const double* last = first + frequencies.size();
+    const double* it = std::lower_bound(first, last, frequency);
+    if (it == last)
+        return size() - 1;
+    if (it != first && frequency - *(it - 1) < *it - frequency)
+        --it;
+    return static_cast<int>(it - first);
+}
+
+bool FrequencyAxis::matches(double start, double stop, int count) const
+{
+    return count == size() && start == startFreq && stop == stopFreq;
+}
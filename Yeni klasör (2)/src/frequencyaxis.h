@@ -0,0 +1,50 @@
+#ifndef FREQUENCYAXIS_H
+#define FREQUENCYAXIS_H
+
+#include <QVector>
+#include <memory>
+
+class FrequencyAxis;
+using FrequencyAxisPtr = std::shared_ptr<const FrequencyAxis>;
+
+// Bir sweep yapılandırmasının değişmez frekans ekseni. Ayar değişikliği
+// başına bir kez hesaplanır ve shared_ptr<const> ile plot, waterfall,
+// marker'lar ve analizör arasında paylaşılır. Her eksenin süreç içinde
+// benzersiz bir sürümü vardır; tüketiciler son gördükleri sürümle
+// karşılaştırıp eksen değişmediyse işi atlar.
+class FrequencyAxis {
+public:
+    // Doğrusal eksen: start + i * (stop - start) / (count - 1)
+    FrequencyAxis(double start, double stop, int count);
+    // Dosyadan yüklenen gibi hazır frekans listesi (artan sırada)
+    explicit FrequencyAxis(const QVector<double>& values);
+
+    static FrequencyAxisPtr create(double start, double stop, int count);
+    static FrequencyAxisPtr fromValues(const QVector<double>& values);
+
+    quint64 version() const { return axisVersion; }
+    int size() const { return frequencies.size(); }
+    bool isEmpty() const { return frequencies.isEmpty(); }
+
+    double start() const { return startFreq; }
+    double stop() const { return stopFreq; }
+    double step() const { return size() > 1 ? (stopFreq - startFreq) / (size() - 1) : 0.0; }
+    double frequency(int index) const { return frequencies[index]; }
+
+    // Örtük paylaşımlı: kopyalamak bellek ayırmaz
+    const QVector<double>& values() const { return frequencies; }
+
+    // En yakın bin (aralık dışı frekanslar kenar bine sıkıştırılır)
+    int indexOf(double frequency) const;
+
+    // Aynı yapılandırma için yeniden hesaplamaya gerek var mı
+    bool matches(double start, double stop, int count) const;
+
+private:
+    quint64 axisVersion;
+    double startFreq{0.0};
+    double stopFreq{0.0};
+    QVector<double> frequencies;
+};
+
+#endif // FREQUENCYAXIS_H
@@ -0,0 +1,424 @@
+#include "iqcodec.h"
+#include <QtEndian>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#if defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+#include <immintrin.h>
+#define IQCODEC_AVX2 1
+#endif
+
+#ifdef BB60C_HAVE_LZ4
+#include <lz4.h>
+#endif
+#ifdef BB60C_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace {
+
+// Hızlı seviye: kayıt sırasında yazıcı thread'inde çalışır
+constexpr int ZSTD_LEVEL = 1;
+
+template <typename T>
+constexpr float fullScale()
+{
+    return sizeof(T) == 2 ? 32767.0f : 127.0f;
+}
+
+// Interleaved I/Q içindeki en büyük mutlak değer
+float peakMagnitude(const float* values, int count)
+{
+    int i = 0;
+    float peak = 0.0f;
+#ifdef IQCODEC_AVX2
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    __m256 peak0 = _mm256_setzero_ps();
+    __m256 peak1 = _mm256_setzero_ps();
+    for (; i + 16 <= count; i += 16) {
+        peak0 = _mm256_max_ps(peak0, _mm256_andnot_ps(signMask, _mm256_loadu_ps(values + i)));
+        peak1 = _mm256_max_ps(peak1, _mm256_andnot_ps(signMask, _mm256_loadu_ps(values + i + 8)));
+    }
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, _mm256_max_ps(peak0, peak1));
+    for (float lane : lanes) {
+        peak = std::max(peak, lane);
+    }
+#endif
+    for (; i < count; ++i) {
+        peak = std::max(peak, std::fabs(values[i]));
+    }
+    return peak;
+}
+
+template <typename T>
+float scaleFor(const float* values, int count)
+{
+    const float peak = peakMagnitude(values, count);
+    // Sıfır/sonlu olmayan blok: ölçek 1, örnekler 0'a yuvarlanır
+    return peak > 0.0f && std::isfinite(peak) ? peak / fullScale<T>() : 1.0f;
+}
+
+template <typename T>
+void quantizeScalar(const float* in, int count, float inverse, T* out)
+{
+    constexpr float limit = fullScale<T>();
+    for (int i = 0; i < count; ++i) {
+        const float v = std::clamp(std::nearbyint(in[i] * inverse), -limit, limit);
+        out[i] = static_cast<T>(v);
+    }
+}
+
+template <typename T>
+void dequantizeScalar(const T* in, int count, float scale, float* out)
+{
+    for (int i = 0; i < count; ++i) {
+        out[i] = static_cast<float>(in[i]) * scale;
+    }
+}
+
+// Bileşen başına fark (I'dan I, Q'dan Q), zigzag ve LEB128. Dönen değer
+// yazılan bayt sayısı; limit aşılırsa -1 (ham saklamak daha kısa).
+template <typename T>
+qint64 deltaVarintEncode(const T* values, int count, unsigned char* out, qint64 limit)
+{
+    qint64 length = 0;
+    qint32 previous[2] = {0, 0};
+    for (int i = 0; i < count; ++i) {
+        const qint32 value = values[i];
+        const qint32 delta = value - previous[i & 1];
+        previous[i & 1] = value;
+        quint32 zigzag = (quint32(delta) << 1) ^ quint32(delta >> 31);
+        if (length + 3 > limit)
+            return -1;
+        while (zigzag >= 0x80) {
+            out[length++] = static_cast<unsigned char>(zigzag | 0x80);
+            zigzag >>= 7;
+        }
+        out[length++] = static_cast<unsigned char>(zigzag);
+    }
+    return length;
+}
+
+template <typename T>
+bool deltaVarintDecode(const unsigned char* in, qint64 size, int count, T* values)
+{
+    qint64 position = 0;
+    qint32 previous[2] = {0, 0};
+    for (int i = 0; i < count; ++i) {
+        quint32 zigzag = 0;
+        int shift = 0;
+        while (true) {
+            if (position >= size || shift > 21)
+                return false;
+            const unsigned char byte = in[position++];
+            zigzag |= quint32(byte & 0x7f) << shift;
+            if (!(byte & 0x80))
+                break;
+            shift += 7;
+        }
+        const qint32 delta = qint32(zigzag >> 1) ^ -qint32(zigzag & 1);
+        previous[i & 1] += delta;
+        values[i] = static_cast<T>(previous[i & 1]);
+    }
+    return position == size;
+}
+
+} // namespace
+
+// PIMPL implementation
+struct IQCodec::Impl {
+    IQEncoding encoding;
+    std::vector<char> integers;   // Nicemlenmiş blok (I/Q tamsayıları)
+    std::vector<char> packed;     // Sıkıştırılmış blok
+
+    int sampleBytes() const { return encoding.format == IQSampleFormat::CI8 ? 2 : 4; }
+
+    // Ham tamsayı bloğunu sıkıştırır; küçülmediyse -1
+    qint64 compress(const char* data, qint64 bytes, int values)
+    {
+        packed.resize(size_t(bytes));
+        switch (encoding.compression) {
+        case IQCompression::DeltaVarint:
+            if (encoding.format == IQSampleFormat::CI8)
+                return deltaVarintEncode(reinterpret_cast<const qint8*>(data), values,
+                                         reinterpret_cast<unsigned char*>(packed.data()), bytes);
+            return deltaVarintEncode(reinterpret_cast<const qint16*>(data), values,
+                                     reinterpret_cast<unsigned char*>(packed.data()), bytes);
+#ifdef BB60C_HAVE_LZ4
+        case IQCompression::LZ4: {
+            const int length = LZ4_compress_default(data, packed.data(), int(bytes), int(bytes));
+            return length > 0 ? length : -1;
+        }
+#endif
+#ifdef BB60C_HAVE_ZSTD
+        case IQCompression::Zstd: {
+            const size_t length = ZSTD_compress(packed.data(), packed.size(), data,
+                                                size_t(bytes), ZSTD_LEVEL);
+            return ZSTD_isError(length) || length >= size_t(bytes) ? -1 : qint64(length);
+        }
+#endif
+        default:
+            return -1;
+        }
+    }
+
+    bool decompress(IQCompression method, IQSampleFormat format, const char* data,
+                    qint64 size, char* out, qint64 bytes, int values)
+    {
+        switch (method) {
+        case IQCompression::None:
+            if (size != bytes)
+                return false;
+            std::memcpy(out, data, size_t(size));
+            return true;
+        case IQCompression::DeltaVarint:
+            if (format == IQSampleFormat::CI8)
+                return deltaVarintDecode(reinterpret_cast<const unsigned char*>(data), size,
+                                         values, reinterpret_cast<qint8*>(out));
+            return deltaVarintDecode(reinterpret_cast<const unsigned char*>(data), size,
+                                     values, reinterpret_cast<qint16*>(out));
+#ifdef BB60C_HAVE_LZ4
+        case IQCompression::LZ4:
+            return LZ4_decompress_safe(data, out, int(size), int(bytes)) == int(bytes);
+#endif
+#ifdef BB60C_HAVE_ZSTD
+        case IQCompression::Zstd:
+            return ZSTD_decompress(out, size_t(bytes), data, size_t(size)) == size_t(bytes);
+#endif
+        default:
+            return false;
+        }
+    }
+};
+
+IQCodec::IQCodec(const IQEncoding& encoding)
+    : pimpl(std::make_unique<Impl>())
+{
+    pimpl->encoding = encoding;
+    pimpl->encoding.blockSamples = std::max(encoding.blockSamples, 1);
+    if (!isAvailable(encoding.compression)) {
+        pimpl->encoding.compression = IQCompression::DeltaVarint;
+    }
+}
+
+IQCodec::~IQCodec() = default;
+
+const IQEncoding& IQCodec::encoding() const
+{
+    return pimpl->encoding;
+}
+
+bool IQCodec::isAvailable(IQCompression compression)
+{
+    switch (compression) {
+    case IQCompression::None:
+    case IQCompression::DeltaVarint:
+        return true;
+    case IQCompression::LZ4:
+#ifdef BB60C_HAVE_LZ4
+        return true;
+#else
+        return false;
+#endif
+    case IQCompression::Zstd:
+#ifdef BB60C_HAVE_ZSTD
+        return true;
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+const char* IQCodec::name(IQCompression compression)
+{
+    switch (compression) {
+    case IQCompression::None:        return "none";
+    case IQCompression::DeltaVarint: return "delta_varint";
+    case IQCompression::LZ4:         return "lz4";
+    case IQCompression::Zstd:        return "zstd";
+    }
+    return "unknown";
+}
+
+const char* IQCodec::name(IQSampleFormat format)
+{
+    switch (format) {
+    case IQSampleFormat::CF32: return "cf32";
+    case IQSampleFormat::CI16: return "ci16";
+    case IQSampleFormat::CI8:  return "ci8";
+    }
+    return "unknown";
+}
+
+float IQCodec::quantize(const std::complex<float>* in, int count, qint16* out)
+{
+    const float* values = reinterpret_cast<const float*>(in);
+    const int n = 2 * count;
+    const float scale = scaleFor<qint16>(values, n);
+    const float inverse = 1.0f / scale;
+    int i = 0;
+#ifdef IQCODEC_AVX2
+    // cvtps en yakına yuvarlar, packs doyurur; packs şerit içi çalıştığından
+    // 64 bitlik parçalar yeniden sıralanır
+    const __m256 factor = _mm256_set1_ps(inverse);
+    for (; i + 16 <= n; i += 16) {
+        const __m256i a = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(values + i), factor));
+        const __m256i b = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(values + i + 8), factor));
+        const __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), 0xD8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), packed);
+    }
+#endif
+    quantizeScalar(values + i, n - i, inverse, out + i);
+    return scale;
+}
+
+float IQCodec::quantize(const std::complex<float>* in, int count, qint8* out)
+{
+    const float* values = reinterpret_cast<const float*>(in);
+    const int n = 2 * count;
+    const float scale = scaleFor<qint8>(values, n);
+    const float inverse = 1.0f / scale;
+    int i = 0;
+#ifdef IQCODEC_AVX2
+    const __m256 factor = _mm256_set1_ps(inverse);
+    const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    for (; i + 32 <= n; i += 32) {
+        const __m256i a = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(values + i), factor));
+        const __m256i b = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(values + i + 8), factor));
+        const __m256i c = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(values + i + 16), factor));
+        const __m256i d = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(values + i + 24), factor));
+        const __m256i bytes = _mm256_packs_epi16(_mm256_packs_epi32(a, b), _mm256_packs_epi32(c, d));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                            _mm256_permutevar8x32_epi32(bytes, order));
+    }
+#endif
+    quantizeScalar(values + i, n - i, inverse, out + i);
+    return scale;
+}
+
+void IQCodec::dequantize(const qint16* in, int count, float scale, std::complex<float>* out)
+{
+    float* values = reinterpret_cast<float*>(out);
+    const int n = 2 * count;
+    int i = 0;
+#ifdef IQCODEC_AVX2
+    const __m256 factor = _mm256_set1_ps(scale);
+    for (; i + 8 <= n; i += 8) {
+        const __m256i wide = _mm256_cvtepi16_epi32(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)));
+        _mm256_storeu_ps(values + i, _mm256_mul_ps(_mm256_cvtepi32_ps(wide), factor));
+    }
+#endif
+    dequantizeScalar(in + i, n - i, scale, values + i);
+}
+
+void IQCodec::dequantize(const qint8* in, int count, float scale, std::complex<float>* out)
+{
+    float* values = reinterpret_cast<float*>(out);
+    const int n = 2 * count;
+    int i = 0;
+#ifdef IQCODEC_AVX2
+    const __m256 factor = _mm256_set1_ps(scale);
+    for (; i + 8 <= n; i += 8) {
+        const __m256i wide = _mm256_cvtepi8_epi32(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + i)));
+        _mm256_storeu_ps(values + i, _mm256_mul_ps(_mm256_cvtepi32_ps(wide), factor));
+    }
+#endif
+    dequantizeScalar(in + i, n - i, scale, values + i);
+}
+
+void IQCodec::encode(const std::complex<float>* in, qint64 count, std::vector<char>& out)
+{
+    Impl& d = *pimpl;
+    const IQEncoding& encoding = d.encoding;
+    if (!encoding.isCompact() || count <= 0)
+        return;
+
+    d.integers.resize(size_t(encoding.blockSamples) * d.sampleBytes());
+    for (qint64 first = 0; first < count; first += encoding.blockSamples) {
+        const int samples = int(std::min<qint64>(encoding.blockSamples, count - first));
+        const qint64 rawBytes = qint64(samples) * d.sampleBytes();
+        float scale;
+        if (encoding.format == IQSampleFormat::CI8) {
+            scale = quantize(in + first, samples, reinterpret_cast<qint8*>(d.integers.data()));
+        } else {
+            scale = quantize(in + first, samples, reinterpret_cast<qint16*>(d.integers.data()));
+        }
+
+        // Sıkıştırma küçültmüyorsa blok ham saklanır; hiçbir blok büyümez
+        IQCompression method = IQCompression::None;
+        const char* payload = d.integers.data();
+        qint64 payloadBytes = rawBytes;
+        if (encoding.compression != IQCompression::None) {
+            const qint64 packedBytes = d.compress(d.integers.data(), rawBytes, 2 * samples);
+            if (packedBytes > 0 && packedBytes < rawBytes) {
+                method = encoding.compression;
+                payload = d.packed.data();
+                payloadBytes = packedBytes;
+            }
+        }
+
+        const size_t offset = out.size();
+        out.resize(offset + BLOCK_HEADER_SIZE + size_t(payloadBytes));
+        char* header = out.data() + offset;
+        quint32 scaleBits;
+        std::memcpy(&scaleBits, &scale, sizeof(scaleBits));
+        qToLittleEndian<quint32>(quint32(samples), header);
+        qToLittleEndian<quint32>(quint32(payloadBytes), header + 4);
+        qToLittleEndian<quint32>(scaleBits, header + 8);
+        header[12] = char(method);
+        header[13] = char(encoding.format);
+        header[14] = 0;
+        header[15] = 0;
+        std::memcpy(header + BLOCK_HEADER_SIZE, payload, size_t(payloadBytes));
+    }
+}
+
+bool IQCodec::blockInfo(const char* data, qint64 size, int& sampleCount, qint64& blockBytes)
+{
+    if (size < BLOCK_HEADER_SIZE)
+        return false;
+    const quint32 samples = qFromLittleEndian<quint32>(data);
+    const quint32 payload = qFromLittleEndian<quint32>(data + 4);
+    const auto format = IQSampleFormat(quint8(data[13]));
+    if (samples == 0 || samples > quint32(std::numeric_limits<int>::max() / 4)
+        || (format != IQSampleFormat::CI16 && format != IQSampleFormat::CI8)
+        || quint8(data[12]) > quint8(IQCompression::Zstd))
+        return false;
+    sampleCount = int(samples);
+    blockBytes = BLOCK_HEADER_SIZE + qint64(payload);
+    return true;
+}
+
+qint64 IQCodec::decodeBlock(const char* data, qint64 size, std::complex<float>* out)
+{
+    int samples = 0;
+    qint64 blockBytes = 0;
+    if (!blockInfo(data, size, samples, blockBytes) || blockBytes > size)
+        return 0;
+
+    Impl& d = *pimpl;
+    const auto method = IQCompression(quint8(data[12]));
+    const auto format = IQSampleFormat(quint8(data[13]));
+    const quint32 scaleBits = qFromLittleEndian<quint32>(data + 8);
+    float scale;
+    std::memcpy(&scale, &scaleBits, sizeof(scale));
+
+    const qint64 rawBytes = qint64(samples) * (format == IQSampleFormat::CI8 ? 2 : 4);
+    d.integers.resize(size_t(rawBytes));
+    if (!d.decompress(method, format, data + BLOCK_HEADER_SIZE, blockBytes - BLOCK_HEADER_SIZE,
+                      d.integers.data(), rawBytes, 2 * samples))
+        return 0;
+
+    if (format == IQSampleFormat::CI8) {
+        dequantize(reinterpret_cast<const qint8*>(d.integers.data()), samples, scale, out);
+    } else {
+        dequantize(reinterpret_cast<const qint16*>(d.integers.data()), samples, scale, out);
+    }
+    return blockBytes;
+}
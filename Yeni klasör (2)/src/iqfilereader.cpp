@@ -0,0 +1,236 @@
+#include "iqfilereader.h"
+#include <QFile>
+#include <QObject>
+#include <QtEndian>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+constexpr char IQ_MAGIC[4] = {'B', 'B', 'I', 'Q'};
+constexpr qint64 SAMPLE_BYTES = qint64(sizeof(std::complex<float>));
+
+// 64 bitte tüm gövde tek seferde eşlenir; 32 bitte 256 MB'lık pencereler
+constexpr qint64 WINDOW_BYTES = sizeof(void*) >= 8
+    ? std::numeric_limits<qint64>::max() : qint64(256) << 20;
+
+quint64 doubleBits(double value)
+{
+    quint64 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+double bitsToDouble(quint64 bits)
+{
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+} // namespace
+
+void IQFileHeader::write(char* out) const
+{
+    std::memset(out, 0, SIZE);
+    std::memcpy(out, IQ_MAGIC, sizeof(IQ_MAGIC));
+    qToLittleEndian<quint32>(VERSION, out + 4);
+    qToLittleEndian<quint32>(static_cast<quint32>(dataOffset), out + 8);
+    qToLittleEndian<quint32>(quint32(encoding.format), out + 12);
+    qToLittleEndian<quint64>(doubleBits(sampleRate), out + 16);
+    qToLittleEndian<quint64>(doubleBits(centerFreq), out + 24);
+    qToLittleEndian<quint64>(sampleCount, out + 32);
+    if (encoding.isCompact()) {
+        qToLittleEndian<quint32>(quint32(encoding.compression), out + 40);
+        qToLittleEndian<quint32>(quint32(encoding.blockSamples), out + 44);
+    }
+}
+
+bool IQFileHeader::read(const char* in, qint64 fileSize, QString& error)
+{
+    if (std::memcmp(in, IQ_MAGIC, sizeof(IQ_MAGIC)) != 0) {
+        error = QObject::tr("Geçersiz IQ dosyası");
+        return false;
+    }
+    const quint32 format = qFromLittleEndian<quint32>(in + 12);
+    const quint32 compression = qFromLittleEndian<quint32>(in + 40);
+    if (qFromLittleEndian<quint32>(in + 4) != VERSION
+        || format < quint32(IQSampleFormat::CF32) || format > quint32(IQSampleFormat::CI8)
+        || compression > quint32(IQCompression::Zstd)) {
+        error = QObject::tr("Desteklenmeyen dosya versiyonu");
+        return false;
+    }
+
+    const qint64 offset = qFromLittleEndian<quint32>(in + 8);
+    const quint64 count = qFromLittleEndian<quint64>(in + 32);
+    const bool compact = format != quint32(IQSampleFormat::CF32);
+    const quint32 blockSamples = compact ? qFromLittleEndian<quint32>(in + 44) : 0;
+    if (offset < SIZE || fileSize < offset
+        || (!compact && count > quint64((fileSize - offset) / SAMPLE_BYTES))
+        || (compact && (blockSamples == 0
+                        || blockSamples > quint32(std::numeric_limits<int>::max())))) {
+        error = QObject::tr("Bozuk dosya formatı");
+        return false;
+    }
+
+    encoding = IQEncoding();
+    encoding.format = IQSampleFormat(format);
+    if (compact) {
+        encoding.compression = IQCompression(compression);
+        encoding.blockSamples = int(blockSamples);
+    }
+    dataOffset = offset;
+    sampleCount = count;
+    sampleRate = bitsToDouble(qFromLittleEndian<quint64>(in + 16));
+    centerFreq = bitsToDouble(qFromLittleEndian<quint64>(in + 24));
+    return true;
+}
+
+// PIMPL implementation
+struct IQFileReader::Impl {
+    QFile file;
+    IQFileHeader header;
+    QString error;
+
+    // Eşlenmiş pencere: [windowFirst, windowFirst + windowCount) örnekleri
+    uchar* window{nullptr};
+    quint64 windowFirst{0};
+    qint64 windowCount{0};
+
+    void unmap()
+    {
+        if (window) {
+            file.unmap(window);
+            window = nullptr;
+            windowCount = 0;
+        }
+    }
+
+    // first'ten başlayan ve en az count örneği kapsayan pencereyi eşler
+    bool map(quint64 first, qint64 count)
+    {
+        unmap();
+        const qint64 remaining = qint64(header.sampleCount - first);
+        const qint64 length = std::min(remaining,
+                                       std::max(count, WINDOW_BYTES / SAMPLE_BYTES));
+        // QFile::map ofseti sayfa sınırına kendisi hizalar
+        window = file.map(header.dataOffset + qint64(first) * SAMPLE_BYTES,
+                          length * SAMPLE_BYTES);
+        if (!window) {
+            error = file.errorString();
+            return false;
+        }
+        windowFirst = first;
+        windowCount = length;
+        return true;
+    }
+};
+
+IQFileReader::IQFileReader()
+    : pimpl(std::make_unique<Impl>())
+{
+}
+
+IQFileReader::~IQFileReader()
+{
+    close();
+}
+
+bool IQFileReader::open(const QString& filename)
+{
+    close();
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+    // Görünümler dosyadaki küçük-endian baytları doğrudan gösterir
+    pimpl->error = QObject::tr("Büyük-endian sistemlerde eşleme desteklenmiyor");
+    return false;
+#endif
+
+    pimpl->file.setFileName(filename);
+    if (!pimpl->file.open(QIODevice::ReadOnly)) {
+        pimpl->error = pimpl->file.errorString();
+        return false;
+    }
+
+    char header[IQFileHeader::SIZE];
+    if (pimpl->file.read(header, sizeof(header)) != qint64(sizeof(header))) {
+        pimpl->error = QObject::tr("Geçersiz IQ dosyası");
+        close();
+        return false;
+    }
+    if (!pimpl->header.read(header, pimpl->file.size(), pimpl->error)) {
+        close();
+        return false;
+    }
+    if (pimpl->header.encoding.isCompact()) {
+        pimpl->error = QObject::tr("Kompakt (%1) IQ dosyası eşlenemez; DataManager::loadIQData ile açın")
+                           .arg(QLatin1String(IQCodec::name(pimpl->header.encoding.format)));
+        close();
+        return false;
+    }
+
+    // 64 bitte tek eşleme burada yapılır; hata açılışta görülür
+    if (pimpl->header.sampleCount > 0 && !pimpl->map(0, 0)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void IQFileReader::close()
+{
+    pimpl->unmap();
+    pimpl->file.close();
+    pimpl->header = IQFileHeader();
+}
+
+bool IQFileReader::isOpen() const
+{
+    return pimpl->file.isOpen();
+}
+
+QString IQFileReader::errorString() const
+{
+    return pimpl->error;
+}
+
+const IQFileHeader& IQFileReader::header() const
+{
+    return pimpl->header;
+}
+
+double IQFileReader::sampleRate() const
+{
+    return pimpl->header.sampleRate;
+}
+
+double IQFileReader::centerFreq() const
+{
+    return pimpl->header.centerFreq;
+}
+
+quint64 IQFileReader::sampleCount() const
+{
+    return pimpl->header.sampleCount;
+}
+
+IQFileReader::Span IQFileReader::samples(quint64 first, qint64 count)
+{
+    Span span;
+    span.first = first;
+    Impl& d = *pimpl;
+    if (!d.file.isOpen() || count <= 0 || first >= d.header.sampleCount)
+        return span;
+
+    count = qint64(std::min<quint64>(quint64(count), d.header.sampleCount - first));
+    if (!d.window || first < d.windowFirst
+        || first + quint64(count) > d.windowFirst + quint64(d.windowCount)) {
+        if (!d.map(first, count))
+            return span;
+    }
+
+    span.data = reinterpret_cast<const std::complex<float>*>(d.window)
+        + (first - d.windowFirst);
+    span.count = count;
+    return span;
+}
@@ -0,0 +1,78 @@
+#ifndef IQFILEREADER_H
+#define IQFILEREADER_H
+
+#include "iqcodec.h"
+#include <QString>
+#include <QtGlobal>
+#include <complex>
+#include <memory>
+
+// IQ dosya başlığı (DataManager::saveIQData biçimi). SIZE baytlık
+// başlıkta "BBIQ", sürüm, başlık boyu, örnek biçimi, örnekleme hızı,
+// merkez frekans, 64 bit örnek sayısı, sıkıştırma ve blok boyu bulunur;
+// kalan baytlar sıfırdır. Tüm alanlar küçük-endian, double'lar IEEE 754
+// bit deseni olarak yazılır. Gövde dataOffset'ten başlar: CF32'de I/Q
+// sıralı küçük-endian cf32, kompakt biçimlerde IQCodec blokları.
+struct IQFileHeader {
+    static constexpr int SIZE = 64;
+    static constexpr quint32 VERSION = 2;
+
+    double sampleRate{0.0};
+    double centerFreq{0.0};
+    quint64 sampleCount{0};
+    qint64 dataOffset{SIZE};
+    IQEncoding encoding;
+
+    // SIZE baytı out'a yazar
+    void write(char* out) const;
+    // SIZE baytlık başlığı çözer; CF32'de örnek sayısı fileSize'a
+    // sığmalıdır (kesik dosya hata sayılır). Hatada açıklama error'a yazılır.
+    bool read(const char* in, qint64 fileSize, QString& error);
+};
+
+// IQ kaydını belleğe eşleyerek (QFile::map) okur. Dosya belleğe
+// yüklenmez; istenen örnek aralığı doğrudan eşlenmiş sayfalardan
+// kopyasız bir görünüm olarak verilir, sayfaları işletim sistemi talep
+// üzerine okur. RAM'den büyük ve 4 G örnekten uzun kayıtlar açılabilir.
+// 64 bit derlemede tüm gövde bir kez eşlenir; 32 bitte adres alanı
+// yetmeyeceğinden istenen aralığı kapsayan pencereler eşlenir.
+// Görünümler Analyzer::calculatePSD, Demodulator::demodulate ve
+// Channelizer::process gibi işaretçi + sayı alan arayüzlere verilebilir.
+// Yalnızca CF32 gövdeler eşlenebilir; kompakt dosyalar
+// DataManager::loadIQData ile çözülür. Tek thread içindir.
+class IQFileReader {
+public:
+    // Salt okunur örnek görünümü
+    struct Span {
+        const std::complex<float>* data{nullptr};
+        qint64 count{0};
+        quint64 first{0};  // İlk örneğin dosyadaki indeksi
+    };
+
+    IQFileReader();
+    ~IQFileReader();
+
+    IQFileReader(const IQFileReader&) = delete;
+    IQFileReader& operator=(const IQFileReader&) = delete;
+
+    bool open(const QString& filename);
+    void close();
+    bool isOpen() const;
+    QString errorString() const;
+
+    const IQFileHeader& header() const;
+    double sampleRate() const;
+    double centerFreq() const;
+    quint64 sampleCount() const;
+
+    // [first, first + count) aralığının görünümü; dosya sonunda kısalır.
+    // Görünüm close()'a kadar geçerlidir; 32 bit derlemede bir sonraki
+    // samples() çağrısı pencereyi taşıyabileceğinden o ana kadar.
+    Span samples(quint64 first, qint64 count);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pimpl;
+};
+
+#endif // IQFILEREADER_H
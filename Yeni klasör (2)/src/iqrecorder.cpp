@@ -0,0 +1,596 @@
+#include "iqrecorder.h"
+#include "iqfilereader.h"
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#ifdef Q_OS_LINUX
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// O_DIRECT için tampon adresi, boyutu ve dosya ofseti bu hizada olmalı
+constexpr qint64 IO_ALIGNMENT = 4096;
+constexpr qint64 SAMPLE_BYTES = qint64(sizeof(std::complex<float>));
+
+struct AlignedFree {
+    void operator()(char* p) const { qFreeAligned(p); }
+};
+
+QString sigmfBase(const QString& path)
+{
+    for (const char* suffix : {".sigmf-data", ".sigmf-meta", ".sigmf", ".iq"}) {
+        if (path.endsWith(QLatin1String(suffix)))
+            return path.left(path.size() - int(std::strlen(suffix)));
+    }
+    return path;
+}
+
+QString isoTime(const QDateTime& time)
+{
+    return time.toUTC().toString(Qt::ISODateWithMs);
+}
+
+} // namespace
+
+// PIMPL implementation
+struct IQRecorder::Impl {
+    struct Buffer {
+        std::unique_ptr<char, AlignedFree> data;
+        qint64 used{0};
+    };
+
+    struct Capture {
+        quint64 sampleStart{0};
+        double frequency{0.0};
+        QDateTime time;
+    };
+
+    struct Annotation {
+        quint64 sampleStart{0};
+        quint64 sampleCount{0};
+        QString label;
+        QString comment;
+        double freqLower{0.0};
+        double freqUpper{0.0};
+    };
+
+    QString base;
+    QString error;
+    IQRecorderOptions options;
+    double sampleRate{0.0};
+    double startFrequency{0.0};
+    bool directIO{false};       // Dosya O_DIRECT ile açıldı
+    bool directActive{false};   // Yazıcı thread'i: O_DIRECT hâlâ açık
+    QFile dataFile;
+
+    // Kompakt kayıt: kodlayıcı ve çıktı bloğu yalnızca yazıcı thread'inde
+    std::unique_ptr<IQCodec> codec;
+    std::vector<char> encoded;
+
+    QString dataPath() const
+    {
+        return base + (options.encoding.isCompact() ? QStringLiteral(".iq")
+                                                    : QStringLiteral(".sigmf-data"));
+    }
+
+    // Kompakt dosya başlığı; count durdurulunca yazılır
+    bool writeHeader(quint64 count)
+    {
+        IQFileHeader info;
+        info.sampleRate = sampleRate;
+        info.centerFreq = startFrequency;
+        info.sampleCount = count;
+        info.encoding = options.encoding;
+        char header[IQFileHeader::SIZE];
+        info.write(header);
+        if (dataFile.write(header, sizeof(header)) != qint64(sizeof(header))) {
+            error = dataFile.errorString();
+            return false;
+        }
+        return true;
+    }
+
+    // Tamponlar; serbest liste ve dolu kuyruk mutex altında
+    QMutex mutex;
+    QWaitCondition filled;
+    std::vector<Buffer> buffers;
+    qint64 capacity{0};
+    std::vector<int> freeList;
+    std::vector<int> fullQueue;   // buffers.size() kapasiteli halka
+    int fullHead{0};
+    int fullCount{0};
+    bool finishing{false};
+
+    // Üretici durumu (acquisition thread); stopRecording ile producerMutex
+    // üzerinden eşzamanlanır
+    QMutex producerMutex;
+    int fill{-1};
+    bool inGap{false};
+    quint64 gapStart{0};
+    quint64 gapSamples{0};
+
+    // Meta verisi
+    mutable QMutex metaMutex;
+    std::vector<Capture> captures;
+    std::vector<Annotation> annotations;
+
+    bool acquire()
+    {
+        QMutexLocker locker(&mutex);
+        if (freeList.empty())
+            return false;
+        fill = freeList.back();
+        freeList.pop_back();
+        buffers[fill].used = 0;
+        return true;
+    }
+
+    void handOff()
+    {
+        QMutexLocker locker(&mutex);
+        fullQueue[(fullHead + fullCount) % int(fullQueue.size())] = fill;
+        ++fullCount;
+        fill = -1;
+        filled.wakeOne();
+    }
+
+    // sampleStart'ta aynı frekansla, şimdiki zamanla yeni capture segmenti;
+    // son segmentin henüz örneği yoksa yalnızca zamanı yenilenir
+    // (metaMutex tutulurken çağrılır)
+    void restartCapture(quint64 sampleStart)
+    {
+        if (captures.empty())
+            return;
+        const QDateTime now = QDateTime::currentDateTimeUtc();
+        if (captures.back().sampleStart == sampleStart) {
+            captures.back().time = now;
+        } else {
+            captures.push_back({sampleStart, captures.back().frequency, now});
+        }
+    }
+
+    // Atlamanın yeri açıklama olarak işaretlenir. Kayıt sürüyorsa
+    // (resumed) atlanan süre sonraki zamanları kaydırmasın diye sonraki
+    // örnekler yeni capture segmentinde başlar.
+    void closeGap(bool resumed)
+    {
+        QMutexLocker locker(&metaMutex);
+        if (resumed) {
+            restartCapture(gapStart);
+        }
+        Annotation gap;
+        gap.sampleStart = gapStart;
+        gap.label = QStringLiteral("dropped");
+        gap.comment = QString::number(gapSamples) + QStringLiteral(" samples dropped");
+        annotations.push_back(gap);
+        inGap = false;
+        gapSamples = 0;
+    }
+
+    bool openData(const QString& path, bool wantDirect)
+    {
+        directIO = false;
+        directActive = false;
+#if defined(Q_OS_LINUX) && defined(O_DIRECT)
+        if (wantDirect) {
+            const int fd = ::open(QFile::encodeName(path).constData(),
+                                  O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT, 0644);
+            if (fd >= 0) {
+                if (dataFile.open(fd, QIODevice::WriteOnly | QIODevice::Unbuffered,
+                                  QFileDevice::AutoCloseHandle)) {
+                    directIO = true;
+                    directActive = true;
+                    return true;
+                }
+                ::close(fd);
+            }
+            // Dosya sistemi O_DIRECT'i desteklemiyor (örn. tmpfs): normal yazma
+        }
+#else
+        Q_UNUSED(wantDirect);
+#endif
+        dataFile.setFileName(path);
+        if (!dataFile.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Unbuffered)) {
+            error = dataFile.errorString();
+            return false;
+        }
+        return true;
+    }
+
+    // Yazılan veri baytlarını döndürür; hatada -1
+    qint64 writeBuffer(const Buffer& buffer)
+    {
+        if (codec) {
+            encoded.clear();
+            codec->encode(reinterpret_cast<const std::complex<float>*>(buffer.data.get()),
+                          buffer.used / SAMPLE_BYTES, encoded);
+            const qint64 length = qint64(encoded.size());
+            if (dataFile.write(encoded.data(), length) != length) {
+                error = dataFile.errorString();
+                return -1;
+            }
+            return length;
+        }
+#if defined(Q_OS_LINUX) && defined(O_DIRECT)
+        // Son, hizasız tampon önbellekli yazılır
+        if (directActive && buffer.used % IO_ALIGNMENT != 0) {
+            const int fd = dataFile.handle();
+            ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) & ~O_DIRECT);
+            directActive = false;
+        }
+#endif
+        if (dataFile.write(buffer.data.get(), buffer.used) != buffer.used) {
+            error = dataFile.errorString();
+            return -1;
+        }
+        return buffer.used;
+    }
+};
+
+IQRecorder::IQRecorder(QObject *parent)
+    : QThread(parent)
+    , pimpl(std::make_unique<Impl>())
+{
+}
+
+IQRecorder::~IQRecorder()
+{
+    stopRecording();
+}
+
+bool IQRecorder::startRecording(const QString& basePath, double sampleRate, double centerFreq,
+                                const IQRecorderOptions& options)
+{
+    Impl& d = *pimpl;
+    if (isRecording() || isRunning()) {
+        d.error = tr("Kayıt zaten sürüyor");
+        return false;
+    }
+    if (sampleRate <= 0.0) {
+        d.error = tr("Geçersiz örnekleme hızı");
+        return false;
+    }
+
+    d.base = sigmfBase(basePath);
+    d.options = options;
+    d.sampleRate = sampleRate;
+    d.startFrequency = centerFreq;
+    d.error.clear();
+    d.codec.reset();
+    if (options.encoding.isCompact()) {
+        // Kullanılamayan sıkıştırma yerleşik olana döner
+        d.codec = std::make_unique<IQCodec>(options.encoding);
+        d.options.encoding = d.codec->encoding();
+    }
+    if (!d.openData(d.dataPath(), options.directIO && !d.codec))
+        return false;
+    if (d.codec && !d.writeHeader(0)) {
+        d.dataFile.close();
+        return false;
+    }
+
+    // Tampon boyutu hem örnek hem O_DIRECT hizasının katı
+    const qint64 bytes = std::max<qint64>(options.bufferBytes, IO_ALIGNMENT);
+    d.capacity = (bytes + IO_ALIGNMENT - 1) / IO_ALIGNMENT * IO_ALIGNMENT;
+    const int count = std::max(options.bufferCount, 2);
+    d.buffers.resize(count);
+    d.freeList.clear();
+    for (int i = 0; i < count; ++i) {
+        d.buffers[i].data.reset(static_cast<char*>(qMallocAligned(size_t(d.capacity), IO_ALIGNMENT)));
+        if (!d.buffers[i].data) {
+            d.error = tr("Kayıt tamponu ayrılamadı");
+            d.buffers.clear();
+            d.dataFile.close();
+            return false;
+        }
+        d.buffers[i].used = 0;
+        d.freeList.push_back(i);
+    }
+    d.fullQueue.assign(count, -1);
+    d.fullHead = 0;
+    d.fullCount = 0;
+    d.finishing = false;
+    d.fill = -1;
+    d.inGap = false;
+    d.gapSamples = 0;
+
+    {
+        QMutexLocker locker(&d.metaMutex);
+        d.captures.clear();
+        d.annotations.clear();
+        d.captures.push_back({0, centerFreq, QDateTime::currentDateTimeUtc()});
+    }
+
+    recorded.store(0);
+    written.store(0);
+    writtenBytes.store(0);
+    submitted.store(0);
+    droppedBlocks.store(0);
+    droppedSamples.store(0);
+
+    // Çökme durumunda da veri dosyası meta ile açılabilsin
+    if (!writeMeta()) {
+        d.dataFile.close();
+        d.buffers.clear();
+        return false;
+    }
+
+    recording.store(true, std::memory_order_release);
+    start(QThread::HighPriority);
+    return true;
+}
+
+void IQRecorder::stopRecording()
+{
+    if (!isRunning())
+        return;
+
+    Impl& d = *pimpl;
+    recording.store(false, std::memory_order_release);
+    {
+        // Süren bir submit() bitene kadar beklenir; yarım tampon da yazılır
+        QMutexLocker producer(&d.producerMutex);
+        if (d.inGap) {
+            d.closeGap(false);
+        }
+        if (d.fill >= 0 && d.buffers[d.fill].used > 0) {
+            d.handOff();
+        }
+        d.fill = -1;
+    }
+    {
+        QMutexLocker locker(&d.mutex);
+        d.finishing = true;
+        d.filled.wakeAll();
+    }
+    wait();
+
+    if (d.codec && d.dataFile.seek(0)) {
+        d.writeHeader(written.load(std::memory_order_relaxed));
+    }
+    d.dataFile.close();
+    d.buffers.clear();
+    writeMeta();
+}
+
+bool IQRecorder::isDirectIO() const
+{
+    return pimpl->directIO;
+}
+
+QString IQRecorder::basePath() const
+{
+    return pimpl->base;
+}
+
+QString IQRecorder::dataPath() const
+{
+    return pimpl->dataPath();
+}
+
+QString IQRecorder::errorString() const
+{
+    return pimpl->error;
+}
+
+void IQRecorder::submit(const std::complex<float>* data, int count)
+{
+    if (!isRecording() || !data || count <= 0)
+        return;
+
+    Impl& d = *pimpl;
+    QMutexLocker producer(&d.producerMutex);
+    if (!isRecording())
+        return;
+
+    submitted.fetch_add(1, std::memory_order_relaxed);
+    const char* source = reinterpret_cast<const char*>(data);
+    qint64 remaining = qint64(count) * SAMPLE_BYTES;
+    while (remaining > 0) {
+        // Yazıcı geride kaldı: bloğun kalanı atılır, acquisition beklemez
+        if (d.fill < 0 && !d.acquire()) {
+            const quint64 lost = quint64(remaining / SAMPLE_BYTES);
+            droppedBlocks.fetch_add(1, std::memory_order_relaxed);
+            droppedSamples.fetch_add(lost, std::memory_order_relaxed);
+            if (!d.inGap) {
+                d.inGap = true;
+                d.gapStart = recorded.load(std::memory_order_relaxed);
+            }
+            d.gapSamples += lost;
+            return;
+        }
+        if (d.inGap) {
+            d.closeGap(true);
+        }
+
+        Impl::Buffer& buffer = d.buffers[d.fill];
+        const qint64 length = std::min(remaining, d.capacity - buffer.used);
+        std::memcpy(buffer.data.get() + buffer.used, source, size_t(length));
+        buffer.used += length;
+        source += length;
+        remaining -= length;
+        recorded.fetch_add(quint64(length / SAMPLE_BYTES), std::memory_order_relaxed);
+
+        if (buffer.used == d.capacity) {
+            d.handOff();
+        }
+    }
+}
+
+void IQRecorder::setCenterFrequency(double freq)
+{
+    if (!isRecording())
+        return;
+
+    Impl& d = *pimpl;
+    const quint64 start = recorded.load(std::memory_order_relaxed);
+    QMutexLocker locker(&d.metaMutex);
+    // Aynı örnekte birden çok değişiklik: sonuncusu geçerli
+    if (!d.captures.empty() && d.captures.back().sampleStart == start) {
+        d.captures.back().frequency = freq;
+        d.captures.back().time = QDateTime::currentDateTimeUtc();
+    } else if (d.captures.empty() || d.captures.back().frequency != freq) {
+        d.captures.push_back({start, freq, QDateTime::currentDateTimeUtc()});
+    }
+}
+
+void IQRecorder::markDiscontinuity()
+{
+    if (!isRecording())
+        return;
+
+    Impl& d = *pimpl;
+    const quint64 start = recorded.load(std::memory_order_relaxed);
+    QMutexLocker locker(&d.metaMutex);
+    d.restartCapture(start);
+}
+
+void IQRecorder::addAnnotation(quint64 sampleStart, quint64 sampleCount, const QString& label,
+                               double freqLower, double freqUpper)
+{
+    Impl& d = *pimpl;
+    QMutexLocker locker(&d.metaMutex);
+    Impl::Annotation annotation;
+    annotation.sampleStart = sampleStart;
+    annotation.sampleCount = sampleCount;
+    annotation.label = label;
+    annotation.freqLower = freqLower;
+    annotation.freqUpper = freqUpper;
+    d.annotations.push_back(annotation);
+}
+
+void IQRecorder::run()
+{
+    Impl& d = *pimpl;
+    QMutexLocker locker(&d.mutex);
+    while (true) {
+        if (d.fullCount == 0) {
+            if (d.finishing)
+                break;
+            d.filled.wait(&d.mutex);
+            continue;
+        }
+
+        const int index = d.fullQueue[d.fullHead];
+        d.fullHead = (d.fullHead + 1) % int(d.fullQueue.size());
+        --d.fullCount;
+
+        // Disk yazması kilitsiz; üretici bu arada diğer tampona yazar
+        locker.unlock();
+        const Impl::Buffer& buffer = d.buffers[index];
+        const qint64 bytes = d.writeBuffer(buffer);
+        const bool ok = bytes >= 0;
+        if (ok) {
+            written.fetch_add(quint64(buffer.used / SAMPLE_BYTES), std::memory_order_relaxed);
+            writtenBytes.fetch_add(quint64(bytes), std::memory_order_relaxed);
+        }
+        locker.relock();
+
+        d.freeList.push_back(index);
+        if (!ok) {
+            // Yazma hatası: yeni veri kabul edilmez, kalan tamponlar atılır
+            recording.store(false, std::memory_order_release);
+            d.fullCount = 0;
+            locker.unlock();
+            emit recordingError(tr("IQ kaydı yazılamadı: %1").arg(d.error));
+            locker.relock();
+        }
+    }
+}
+
+bool IQRecorder::writeMeta()
+{
+    Impl& d = *pimpl;
+
+    const IQEncoding& encoding = d.options.encoding;
+    QJsonObject global;
+    if (encoding.isCompact()) {
+        // Gövde düz SigMF değil: ölçekli bloklar bb60c uzantısında tanımlı
+        global["core:datatype"] = encoding.format == IQSampleFormat::CI8
+            ? QStringLiteral("ci8") : QStringLiteral("ci16_le");
+        global["core:dataset"] = QFileInfo(d.dataPath()).fileName();
+        QJsonObject extension;
+        extension["name"] = QStringLiteral("bb60c");
+        extension["version"] = QStringLiteral("1.0.0");
+        extension["optional"] = false;
+        QJsonArray extensions;
+        extensions.append(extension);
+        global["core:extensions"] = extensions;
+        QJsonObject codec;
+        codec["format"] = QLatin1String(IQCodec::name(encoding.format));
+        codec["compression"] = QLatin1String(IQCodec::name(encoding.compression));
+        codec["block_samples"] = encoding.blockSamples;
+        codec["header_bytes"] = IQFileHeader::SIZE;
+        global["bb60c:encoding"] = codec;
+    } else {
+        global["core:datatype"] = QStringLiteral("cf32_le");
+    }
+    global["core:sample_rate"] = d.sampleRate;
+    global["core:version"] = QStringLiteral("1.0.0");
+    global["core:num_channels"] = 1;
+    global["core:recorder"] = QStringLiteral("BB60C Spektrum Analizörü");
+    if (!d.options.hardware.isEmpty())
+        global["core:hw"] = d.options.hardware;
+    if (!d.options.description.isEmpty())
+        global["core:description"] = d.options.description;
+
+    QJsonArray captures;
+    QJsonArray annotations;
+    {
+        QMutexLocker locker(&d.metaMutex);
+        for (const Impl::Capture& capture : d.captures) {
+            QJsonObject item;
+            item["core:sample_start"] = qint64(capture.sampleStart);
+            item["core:frequency"] = capture.frequency;
+            item["core:datetime"] = isoTime(capture.time);
+            captures.append(item);
+        }
+
+        // SigMF açıklamaları sample_start sırasında ister
+        std::vector<Impl::Annotation> sorted = d.annotations;
+        std::stable_sort(sorted.begin(), sorted.end(),
+            [](const Impl::Annotation& a, const Impl::Annotation& b) {
+                return a.sampleStart < b.sampleStart;
+            });
+        for (const Impl::Annotation& annotation : sorted) {
+            QJsonObject item;
+            item["core:sample_start"] = qint64(annotation.sampleStart);
+            if (annotation.sampleCount > 0)
+                item["core:sample_count"] = qint64(annotation.sampleCount);
+            if (!annotation.label.isEmpty())
+                item["core:label"] = annotation.label;
+            if (!annotation.comment.isEmpty())
+                item["core:comment"] = annotation.comment;
+            if (annotation.freqLower != 0.0 || annotation.freqUpper != 0.0) {
+                item["core:freq_lower_edge"] = annotation.freqLower;
+                item["core:freq_upper_edge"] = annotation.freqUpper;
+            }
+            annotations.append(item);
+        }
+    }
+
+    QJsonObject root;
+    root["global"] = global;
+    root["captures"] = captures;
+    root["annotations"] = annotations;
+
+    QFile meta(d.base + QStringLiteral(".sigmf-meta"));
+    const QByteArray json = QJsonDocument(root).toJson(QJsonDocument::Indented);
+    if (!meta.open(QIODevice::WriteOnly | QIODevice::Truncate)
+        || meta.write(json) != json.size()) {
+        d.error = meta.errorString();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,108 @@
+#ifndef IQRECORDER_H
+#define IQRECORDER_H
+
+#include "iqcodec.h"
+#include <QThread>
+#include <QString>
+#include <atomic>
+#include <complex>
+#include <memory>
+
+// Kayıt seçenekleri
+struct IQRecorderOptions {
+    static constexpr int DEFAULT_BUFFER_BYTES = 32 << 20;   // ~100 ms @ 40 MS/s cf32
+    static constexpr int DEFAULT_BUFFER_COUNT = 2;
+
+    QString description;          // core:description
+    QString hardware{"BB60C"};    // core:hw
+    int bufferBytes{DEFAULT_BUFFER_BYTES};  // Tampon başına; 4096'nın katına yuvarlanır
+    int bufferCount{DEFAULT_BUFFER_COUNT};  // En az 2 (çift tampon)
+    // Linux'ta sayfa önbelleğini atlayan O_DIRECT yazma. Dosya sistemi
+    // desteklemiyorsa normal yazmaya dönülür (bkz. isDirectIO()).
+    // Kompakt kayıtta blok boyları değişken olduğundan kullanılmaz.
+    bool directIO{false};
+    // Kompakt kayıt (int16/int8 + sıkıştırma); CF32 ise ham cf32_le
+    IQEncoding encoding;
+};
+
+// Sürekli IQ akışını SigMF düzeninde diske yazan kaydedici:
+// <taban>.sigmf-data (cf32_le) ve <taban>.sigmf-meta (JSON; global,
+// captures, annotations). Acquisition thread'i blokları submit() ile
+// verir; bloklar hizalı büyük tamponlara kopyalanır, dolan tampon yazıcı
+// thread'e devredilir ve tek write() ile diske gider. submit() hiçbir
+// zaman diski beklemez: boş tampon kalmadıysa blok atılır, sayılır ve
+// kayıtta atlamanın yeri bir "dropped" açıklamasıyla işaretlenir;
+// atlamadan sonraki örnekler kendi zamanıyla yeni capture segmentinde
+// başlar.
+// Kaynağın kendisi kesintiye uğradıysa (bitişik olmayan bloklar) yeni
+// capture segmenti markDiscontinuity() ile başlatılır.
+// Meta dosyası kayıt başında yazılır, durdurulunca güncellenir.
+// Kompakt kayıtta veri <taban>.iq dosyasına (IQFileHeader + IQCodec
+// blokları) gider; tamponlar yazıcı thread'inde kodlanır, meta dosyası
+// core:dataset ve bb60c:encoding ile bu dosyayı tanımlar. Örnek sayısı
+// başlığa durdurulunca yazılır (yarıda kalan kayıtta 0; bloklar yine
+// okunabilir). Bu dosyalar DataManager::loadIQData ile açılır.
+class IQRecorder : public QThread {
+    Q_OBJECT
+public:
+    explicit IQRecorder(QObject *parent = nullptr);
+    ~IQRecorder() override;
+
+    // basePath uzantısız olabilir; .sigmf-data (kompaktta .iq) ve
+    // .sigmf-meta eklenir.
+    // Hata durumunda false; açıklama errorString()'de.
+    bool startRecording(const QString& basePath, double sampleRate, double centerFreq,
+                        const IQRecorderOptions& options = IQRecorderOptions());
+    // Kalan veriyi yazar, meta dosyasını tamamlar ve thread'i bekler
+    void stopRecording();
+    bool isRecording() const { return recording.load(std::memory_order_acquire); }
+    bool isDirectIO() const;
+    QString basePath() const;
+    QString dataPath() const;
+    QString errorString() const;
+
+    // Acquisition thread'i (tek üretici): count örneği kayda ekler
+    void submit(const std::complex<float>* data, int count);
+
+    // Kayıt sırasında LO değişince yeni capture segmenti başlar
+    // (herhangi bir thread'den; blok hassasiyetinde)
+    void setCenterFrequency(double freq);
+    // Bir sonraki blok öncekinin zaman içindeki devamı değil (örn. araya
+    // sweep girdi): o örnekte aynı frekansla, kendi core:datetime'ı olan
+    // yeni capture segmenti başlar. submit() ile aynı thread'den çağrılır.
+    void markDiscontinuity();
+    // Örnek aralığına açıklama (herhangi bir thread'den). Frekans
+    // kenarları 0 ise yazılmaz.
+    void addAnnotation(quint64 sampleStart, quint64 sampleCount, const QString& label,
+                       double freqLower = 0.0, double freqUpper = 0.0);
+
+    // Sayaçlar
+    quint64 samplesRecorded() const { return recorded.load(std::memory_order_relaxed); }
+    quint64 samplesWritten() const { return written.load(std::memory_order_relaxed); }
+    quint64 bytesWritten() const { return writtenBytes.load(std::memory_order_relaxed); }
+    quint64 blocksSubmitted() const { return submitted.load(std::memory_order_relaxed); }
+    quint64 blocksDropped() const { return droppedBlocks.load(std::memory_order_relaxed); }
+    quint64 samplesDropped() const { return droppedSamples.load(std::memory_order_relaxed); }
+
+signals:
+    void recordingError(const QString& message);
+
+protected:
+    void run() override;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pimpl;
+
+    std::atomic<bool> recording{false};
+    std::atomic<quint64> recorded{0};      // Dosyaya giren (kabul edilen) örnekler
+    std::atomic<quint64> written{0};       // Diske yazılmış örnekler
+    std::atomic<quint64> writtenBytes{0};  // Diske yazılmış veri baytları
+    std::atomic<quint64> submitted{0};
+    std::atomic<quint64> droppedBlocks{0};
+    std::atomic<quint64> droppedSamples{0};
+
+    bool writeMeta();
+};
+
+#endif // IQRECORDER_H
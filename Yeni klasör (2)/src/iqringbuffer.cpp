@@ -0,0 +1,138 @@
+#include "iqringbuffer.h"
+#include <algorithm>
+
+IQRingBuffer::IQRingBuffer(int blockCount, int blockSize)
+    : numBlocks(std::max(blockCount, 3))
+    , samplesPerBlock(std::max(blockSize, 1))
+    , samples(static_cast<size_t>(numBlocks) * samplesPerBlock)
+    , blockSlots(std::make_unique<Slot[]>(numBlocks))
+{
+}
+
+IQRingBuffer::~IQRingBuffer() = default;
+
+std::complex<float>* IQRingBuffer::beginWrite()
+{
+    const std::uint64_t sequence = writeSequence.load(std::memory_order_relaxed);
+    Slot& slot = blockSlots[sequence % numBlocks];
+
+    // Slotu geçersiz işaretle; veri yazımı bu işaretten önceye taşınamaz
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    return blockData(sequence);
+}
+
+void IQRingBuffer::commitWrite(int count)
+{
+    const std::uint64_t sequence = writeSequence.load(std::memory_order_relaxed);
+    Slot& slot = blockSlots[sequence % numBlocks];
+
+    slot.count = std::clamp(count, 0, samplesPerBlock);
+    slot.sequence.store(sequence, std::memory_order_release);
+    writeSequence.store(sequence + 1, std::memory_order_release);
+}
+
+std::complex<float>* IQRingBuffer::blockData(std::uint64_t sequence)
+{
+    return samples.data() + static_cast<size_t>(sequence % numBlocks) * samplesPerBlock;
+}
+
+const std::complex<float>* IQRingBuffer::blockData(std::uint64_t sequence) const
+{
+    return samples.data() + static_cast<size_t>(sequence % numBlocks) * samplesPerBlock;
+}
+
+IQRingBuffer::Reader::Reader(const IQRingBuffer* ring)
+    : ring(ring)
+{
+    // Okuyucu oluşturulduğu andan itibaren yazılan blokları görür
+    if (ring) {
+        nextSequence = ring->writeSequence.load(std::memory_order_acquire);
+    }
+}
+
+bool IQRingBuffer::Reader::next(BlockView& view)
+{
+    if (!ring) {
+        return false;
+    }
+
+    for (;;) {
+        const std::uint64_t newest = ring->writeSequence.load(std::memory_order_acquire) - 1;
+        if (nextSequence > newest) {
+            return false;
+        }
+
+        // Yazılmakta olan slotla çakışmamak için bir blok pay bırakılır
+        const std::uint64_t window = static_cast<std::uint64_t>(ring->numBlocks - 2);
+        const std::uint64_t oldest = newest > window ? newest - window : 1;
+        if (nextSequence < oldest) {
+            lostBlocks += oldest - nextSequence;
+            nextSequence = oldest;
+        }
+
+        if (fetch(nextSequence, view)) {
+            ++nextSequence;
+            return true;
+        }
+
+        // Okurken yazıcı turu tamamladı
+        ++lostBlocks;
+        ++nextSequence;
+    }
+}
+
+bool IQRingBuffer::Reader::latest(BlockView& view)
+{
+    if (!ring) {
+        return false;
+    }
+
+    const std::uint64_t newest = ring->writeSequence.load(std::memory_order_acquire) - 1;
+    if (newest == 0 || nextSequence > newest) {
+        return false;
+    }
+
+    // Bilerek atlanan bloklar overrun sayılmaz
+    nextSequence = newest;
+    if (!fetch(nextSequence, view)) {
+        return false;
+    }
+    ++nextSequence;
+    return true;
+}
+
+bool IQRingBuffer::Reader::isValid(const BlockView& view) const
+{
+    if (!ring || !view.data) {
+        return false;
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const Slot& slot = ring->blockSlots[view.sequence % ring->numBlocks];
+    return slot.sequence.load(std::memory_order_relaxed) == view.sequence;
+}
+
+std::uint64_t IQRingBuffer::Reader::available() const
+{
+    if (!ring) {
+        return 0;
+    }
+
+    const std::uint64_t newest = ring->writeSequence.load(std::memory_order_acquire) - 1;
+    return nextSequence > newest ? 0 : newest - nextSequence + 1;
+}
+
+bool IQRingBuffer::Reader::fetch(std::uint64_t sequence, BlockView& view)
+{
+    const Slot& slot = ring->blockSlots[sequence % ring->numBlocks];
+    if (slot.sequence.load(std::memory_order_acquire) != sequence) {
+        return false;
+    }
+
+    view.data = ring->blockData(sequence);
+    view.count = slot.count;
+    view.sequence = sequence;
+    return true;
+}
@@ -0,0 +1,79 @@
+#ifndef IQRINGBUFFER_H
+#define IQRINGBUFFER_H
+
+#include <atomic>
+#include <complex>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Sabit boyutlu IQ blokları için önceden ayrılmış halka tampon.
+// Tek yazıcı (cihaz katmanı) blokları doğrudan tampona yazar; her tüketici
+// (demodülatör, analizör, kayıt) kendi Reader'ı ile kopyalamadan okur.
+// Yazıcı hiçbir zaman beklemez: yavaş kalan okuyucular overrun olarak
+// bildirilir ve en eski geçerli bloğa atlatılır.
+class IQRingBuffer {
+public:
+    // Okuyucuya verilen salt okunur blok görünümü
+    struct BlockView {
+        const std::complex<float>* data{nullptr};
+        int count{0};
+        std::uint64_t sequence{0};  // 1'den başlayan blok numarası
+    };
+
+    class Reader {
+    public:
+        explicit Reader(const IQRingBuffer* ring = nullptr);
+
+        // Sıradaki bloğu döndürür; yoksa false
+        bool next(BlockView& view);
+        // Aradakileri atlayarak en yeni bloğa geçer
+        bool latest(BlockView& view);
+        // İşlem bitince çağrılır: blok bu arada üzerine yazıldıysa false
+        bool isValid(const BlockView& view) const;
+
+        std::uint64_t overruns() const { return lostBlocks; }
+        std::uint64_t available() const;
+
+    private:
+        const IQRingBuffer* ring;
+        std::uint64_t nextSequence{1};
+        std::uint64_t lostBlocks{0};
+
+        bool fetch(std::uint64_t sequence, BlockView& view);
+    };
+
+    IQRingBuffer(int blockCount, int blockSize);
+    ~IQRingBuffer();
+
+    IQRingBuffer(const IQRingBuffer&) = delete;
+    IQRingBuffer& operator=(const IQRingBuffer&) = delete;
+
+    // Yazıcı tarafı: beginWrite() ile alınan alana en fazla blockSize()
+    // örnek yazılır, commitWrite() ile yayınlanır
+    std::complex<float>* beginWrite();
+    void commitWrite(int count);
+
+    int blockCount() const { return numBlocks; }
+    int blockSize() const { return samplesPerBlock; }
+    std::uint64_t blocksWritten() const { return writeSequence.load(std::memory_order_acquire) - 1; }
+
+    Reader createReader() const { return Reader(this); }
+
+private:
+    struct Slot {
+        std::atomic<std::uint64_t> sequence{0};  // 0: boş/yazılıyor
+        int count{0};
+    };
+
+    int numBlocks;
+    int samplesPerBlock;
+    std::vector<std::complex<float>> samples;
+    std::unique_ptr<Slot[]> blockSlots;
+    std::atomic<std::uint64_t> writeSequence{1};  // Sıradaki yazılacak blok
+
+    std::complex<float>* blockData(std::uint64_t sequence);
+    const std::complex<float>* blockData(std::uint64_t sequence) const;
+};
+
+#endif // IQRINGBUFFER_H
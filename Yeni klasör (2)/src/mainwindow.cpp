@@ -9,6 +9,21 @@
 #include <QLabel>
 #include <QApplication>
 #include <QStatusBar>
+#include <QHeaderView>
+#include <QPushButton>
+#include <QSignalBlocker>
+#include <QDateTime>
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+namespace {
+
+// RBW seçenekleri (Hz); rbwSelect bu sıradadır
+constexpr int RBW_VALUES[] = {1000, 3000, 10000, 30000, 100000, 300000, 1000000, 3000000};
+constexpr int DEFAULT_RBW_INDEX = 4;
+
+} // namespace
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
@@ -16,10 +31,25 @@ MainWindow::MainWindow(QWidget *parent)
     , demodulator(std::make_unique<Demodulator>(this))
     , analyzer(std::make_unique<Analyzer>(this))
     , dataManager(std::make_unique<DataManager>(this))
-    , updateTimer(std::make_unique<QTimer>(this))
+    , measurementEngine(std::make_unique<MeasurementEngine>())
+    , traceProcessor(std::make_unique<TraceProcessor>())
+    , iqRecorder(std::make_unique<IQRecorder>())
+    , traceWriter(std::make_unique<TraceFileWriter>())
     , isConnected(false)
     , isRunning(false)
+    , iqRing(std::make_unique<IQRingBuffer>(IQ_RING_BLOCKS, BbDeviceInterface::IQ_BLOCK_SIZE))
 {
+    demodReader = iqRing->createReader();
+    analyzerReader = iqRing->createReader();
+    
+    connect(measurementEngine.get(), &MeasurementEngine::resultsReady,
+            this, &MainWindow::onMeasurementResults, Qt::QueuedConnection);
+    connect(measurementEngine.get(), &MeasurementEngine::logError,
+            this, &MainWindow::onMeasurementLogError, Qt::QueuedConnection);
+    measurementEngine->start();
+    connect(iqRecorder.get(), &IQRecorder::recordingError,
+            this, &MainWindow::onIQRecordError, Qt::QueuedConnection);
+    
     setupUI();
     createMenuBar();
     createToolBar();
@@ -35,9 +65,6 @@ MainWindow::MainWindow(QWidget *parent)
     waterfallWidget = new WaterfallPlot(this);
     mainLayout->addWidget(waterfallWidget);
     
-    // Timer bağlantısı
-    connect(updateTimer.get(), &QTimer::timeout, this, &MainWindow::updateData);
-    
     // Varsayılan ayarlar
     centerFreq->setValue(1e9);  // 1 GHz
     spanFreq->setValue(100e6);  // 100 MHz
@@ -52,6 +79,9 @@ MainWindow::~MainWindow()
     if (isRunning) {
         stopAcquisition();
     }
+    measurementEngine->stop();
+    iqRecorder->stopRecording();
+    traceWriter->close();
 }
 
 void MainWindow::setupUI()
@@ -83,9 +113,6 @@ void MainWindow::setupUI()
     waterfallWidget = new WaterfallPlot(this);
     mainLayout->addWidget(waterfallWidget);
     
-    // Timer bağlantısı
-    connect(updateTimer.get(), &QTimer::timeout, this, &MainWindow::updateData);
-    
     // Varsayılan ayarlar
     centerFreq->setValue(1e9);  // 1 GHz
     spanFreq->setValue(100e6);  // 100 MHz
@@ -109,6 +136,8 @@ void MainWindow::createMenuBar()
     fileMenu->addAction(tr("Durum Yükle"), this, &MainWindow::onLoadState);
     fileMenu->addSeparator();
     fileMenu->addAction(tr("CSV Olarak Dışa Aktar"), this, &MainWindow::onExportData);
+    fileMenu->addAction(tr("IQ Kaydı (SigMF)..."), this, &MainWindow::onIQRecord);
+    fileMenu->addAction(tr("Trace Oturumu Kaydı..."), this, &MainWindow::onTraceSessionRecord);
     fileMenu->addSeparator();
     fileMenu->addAction(tr("Çıkış"), this, &QWidget::close);
     
@@ -121,13 +150,35 @@ void MainWindow::createMenuBar()
     viewMenu->addAction(demodDock->toggleViewAction());
     viewMenu->addAction(measureDock->toggleViewAction());
     
+    // Marker menüsü: gezinme sweep'in tepe dizininden yapılır
+    QMenu* markerMenu = menuBar->addMenu(tr("Marker"));
+    markerMenu->addAction(tr("Tepe Noktası"), this, &MainWindow::onPeakSearch);
+    markerMenu->addAction(tr("Sonraki Tepe"), this, &MainWindow::onNextPeak);
+    markerMenu->addAction(tr("Soldaki Tepe"), this, &MainWindow::onNextPeakLeft);
+    markerMenu->addAction(tr("Sağdaki Tepe"), this, &MainWindow::onNextPeakRight);
+    markerMenu->addAction(tr("En Yakın Tepe"), this, &MainWindow::onMarkerToPeak);
+    markerMenu->addAction(tr("En Düşük Nokta"), this, &MainWindow::onMinSearch);
+    markerMenu->addSeparator();
+    markerMenu->addAction(tr("Marker -> Merkez"), this, &MainWindow::onMarkerToCenter);
+    
     // Ölçüm menüsü
     QMenu* measureMenu = menuBar->addMenu(tr("Ölçüm"));
-    measureMenu->addAction(tr("Kanal Gücü"), this, &MainWindow::onChannelPowerMeasure);
-    measureMenu->addAction(tr("OBW"), this, &MainWindow::onOBWMeasure);
-    measureMenu->addAction(tr("ACPR"), this, &MainWindow::onACPRMeasure);
-    measureMenu->addAction(tr("Spur Arama"), this, &MainWindow::onSpurSearch);
+    QAction* channelPowerAction = measureMenu->addAction(tr("Kanal Gücü"));
+    channelPowerAction->setCheckable(true);
+    connect(channelPowerAction, &QAction::toggled, this, &MainWindow::onChannelPowerMeasure);
+    QAction* obwAction = measureMenu->addAction(tr("OBW"));
+    obwAction->setCheckable(true);
+    connect(obwAction, &QAction::toggled, this, &MainWindow::onOBWMeasure);
+    QAction* acprAction = measureMenu->addAction(tr("ACPR"));
+    acprAction->setCheckable(true);
+    connect(acprAction, &QAction::toggled, this, &MainWindow::onACPRMeasure);
+    QAction* spurAction = measureMenu->addAction(tr("Spur Arama"));
+    spurAction->setCheckable(true);
+    connect(spurAction, &QAction::toggled, this, &MainWindow::onSpurSearch);
+    measureMenu->addSeparator();
     measureMenu->addAction(tr("Faz Gürültüsü"), this, &MainWindow::onPhaseNoiseMeasure);
+    measureMenu->addSeparator();
+    measureMenu->addAction(tr("Ölçüm Kaydı..."), this, &MainWindow::onMeasurementLog);
 }
 
 void MainWindow::createToolBar()
@@ -175,11 +226,85 @@ void MainWindow::createDockWindows()
     connect(spanFreq, QOverload<double>::of(&QDoubleSpinBox::valueChanged),
             this, &MainWindow::onSpanChanged);
             
+    rbwSelect = std::make_unique<QComboBox>(freqWidget);
+    for (int rbw : RBW_VALUES) {
+        rbwSelect->addItem(rbw >= 1000000 ? tr("%1 MHz").arg(rbw / 1000000)
+                                          : tr("%1 kHz").arg(rbw / 1000));
+    }
+    rbwSelect->setCurrentIndex(DEFAULT_RBW_INDEX);
+    connect(rbwSelect.get(), QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &MainWindow::onRBWChanged);
+    
+    sweepPlanLabel = std::make_unique<QLabel>(freqWidget);
+    sweepPlanLabel->setWordWrap(true);
+    updateSweepPlanInfo();
+            
     freqLayout->addRow(tr("Merkez:"), centerFreq);
     freqLayout->addRow(tr("Span:"), spanFreq);
+    freqLayout->addRow(tr("RBW:"), rbwSelect.get());
+    freqLayout->addRow(sweepPlanLabel.get());
     freqDock->setWidget(freqWidget);
     addDockWidget(Qt::RightDockWidgetArea, freqDock);
     
+    // Trace paneli; mod listesi TraceProcessor::Mode sırasındadır
+    traceDock = std::make_unique<QDockWidget>(tr("Trace"), this);
+    QWidget* traceWidget = new QWidget(traceDock.get());
+    QFormLayout* traceLayout = new QFormLayout(traceWidget);
+    
+    traceSelect = std::make_unique<QComboBox>(traceWidget);
+    for (int t = 0; t < TraceProcessor::TRACE_COUNT; ++t) {
+        traceSelect->addItem(tr("Trace %1").arg(t + 1));
+    }
+    
+    traceMode = std::make_unique<QComboBox>(traceWidget);
+    traceMode->addItems({tr("Kapalı"), tr("Clear/Write"), tr("Max Hold"), tr("Min Hold"),
+                         tr("Güç Ortalaması"), tr("Log Ortalaması")});
+    
+    traceAveraging = std::make_unique<QComboBox>(traceWidget);
+    traceAveraging->addItems({tr("Üstel"), tr("Blok")});
+    
+    traceAverageCount = std::make_unique<QSpinBox>(traceWidget);
+    traceAverageCount->setRange(1, 10000);
+    traceAverageCount->setValue(10);
+    
+    QPushButton* traceRestart = new QPushButton(tr("Yeniden Başlat"), traceWidget);
+    
+    // Kontroller doldurulduktan sonra bağlanır
+    onTraceSelected(0);
+    connect(traceSelect.get(), QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &MainWindow::onTraceSelected);
+    connect(traceMode.get(), QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &MainWindow::onTraceSettingsChanged);
+    connect(traceAveraging.get(), QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &MainWindow::onTraceSettingsChanged);
+    connect(traceAverageCount.get(), QOverload<int>::of(&QSpinBox::valueChanged),
+            this, &MainWindow::onTraceSettingsChanged);
+    connect(traceRestart, &QPushButton::clicked, this, &MainWindow::onTraceRestart);
+    
+    traceLayout->addRow(tr("Trace:"), traceSelect.get());
+    traceLayout->addRow(tr("Mod:"), traceMode.get());
+    traceLayout->addRow(tr("Ortalama:"), traceAveraging.get());
+    traceLayout->addRow(tr("Sweep Sayısı:"), traceAverageCount.get());
+    traceLayout->addRow(traceRestart);
+    traceDock->setWidget(traceWidget);
+    addDockWidget(Qt::RightDockWidgetArea, traceDock.get());
+    
+    // Ölçüm paneli; satırlar MeasurementConfig::Type sırasındadır
+    measureDock = std::make_unique<QDockWidget>(tr("Ölçümler"), this);
+    const QStringList measureNames = {tr("Kanal Gücü"), tr("OBW"), tr("ACPR"), tr("Spur")};
+    measureTable = std::make_unique<QTableWidget>(measureNames.size(), 3, measureDock.get());
+    measureTable->setHorizontalHeaderLabels({tr("Ölçüm"), tr("Sonuç"), tr("Sweep")});
+    measureTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    measureTable->verticalHeader()->setVisible(false);
+    measureTable->horizontalHeader()->setStretchLastSection(true);
+    for (int row = 0; row < measureNames.size(); ++row) {
+        measureTable->setItem(row, 0, new QTableWidgetItem(measureNames[row]));
+        measureTable->setItem(row, 1, new QTableWidgetItem(tr("Kapalı")));
+        measureTable->setItem(row, 2, new QTableWidgetItem(QString()));
+    }
+    measureDock->setWidget(measureTable.get());
+    addDockWidget(Qt::RightDockWidgetArea, measureDock.get());
+    
     // Diğer dock widget'lar benzer şekilde...
 }
 
@@ -195,9 +320,17 @@ void MainWindow::setupPlot()
     plotWidget->xAxis->grid()->setVisible(true);
     plotWidget->yAxis->grid()->setVisible(true);
     
-    // Grafik ekleme
-    plotWidget->addGraph();
-    plotWidget->graph(0)->setPen(QPen(Qt::yellow));
+    // Her trace için bir grafik
+    const QColor traceColors[TraceProcessor::TRACE_COUNT] = {Qt::yellow, Qt::cyan, Qt::magenta};
+    for (int t = 0; t < TraceProcessor::TRACE_COUNT; ++t) {
+        plotWidget->addGraph();
+        plotWidget->graph(t)->setPen(QPen(traceColors[t]));
+        // Veri kabı yerinde güncellenir; kapasite korunmalı
+        plotWidget->graph(t)->data()->setAutoSqueeze(false);
+    }
+    
+    connect(plotWidget->xAxis, QOverload<const QCPRange&>::of(&QCPAxis::rangeChanged),
+            this, &MainWindow::onPlotRangeChanged);
     
     // Eksen aralıkları
     plotWidget->xAxis->setRange(1e9, 1.1e9);
@@ -206,28 +339,17 @@ void MainWindow::setupPlot()
 
 void MainWindow::updateData()
 {
-    if (!isRunning || !device) return;
+    if (!isRunning || !acquisitionWorker) return;
+    
+    // Sadece en yeni sweep çizilir; arada kalanlar worker'da sayılır
+    SweepPtr sweep;
+    if (!acquisitionWorker->takeLatest(sweep))
+        return;
     
     try {
-        // BB60C'den veri al
-        auto trace = device->bb_fetch_trace();
-        
-        // Frekans vektörünü güncelle
-        double start = centerFreq->value() - spanFreq->value()/2;
-        double stop = centerFreq->value() + spanFreq->value()/2;
-        frequencies = QVector<double>::fromStdVector(
-            std::vector<double>(trace.size(), 0.0));
-        for (int i = 0; i < trace.size(); ++i) {
-            frequencies[i] = start + i * (stop - start) / (trace.size() - 1);
-        }
-        
-        // Genlik verilerini güncelle
-        amplitudes = QVector<double>::fromStdVector(trace);
-        
-        // Grafikleri güncelle
-        updatePlot();
-        updateWaterfall();
-        updateMeasurements();
+        applySweep(sweep);
+        processIQData();
+        updateSweepCounters();
         
     } catch (const std::exception& e) {
         QMessageBox::critical(this, "Hata", 
@@ -236,17 +358,162 @@ void MainWindow::updateData()
     }
 }
 
+void MainWindow::applySweep(const SweepPtr& sweep)
+{
+    if (!sweep || sweep->size() < 2 || !sweep->axis() || sweep->axis()->size() != sweep->size())
+        return;
+    
+    // Eksen yalnızca yapılandırma değiştiğinde yeni sürümle gelir;
+    // frequencies kopyalanmaz, eksenin tamponunu paylaşır
+    setFrequencyAxis(sweep->axis());
+    
+    // Sweep tutamacı alınır; önceki sweep bırakılıp cihaz havuzuna döner
+    currentSweep = sweep;
+    peakIndex.build(amplitudes().constData(), amplitudes().size());
+    traceProcessor->copyTraces(traceData, traceDataVersion);
+    
+    // Marker'lar çizimden önce güncellenir ki aynı replot'ta görünsünler
+    updateMeasurements();
+    updatePlot();
+    updateWaterfall();
+}
+
+const QVector<double>& MainWindow::amplitudes() const
+{
+    static const QVector<double> empty;
+    return currentSweep ? currentSweep->amplitudes() : empty;
+}
+
+void MainWindow::setFrequencyAxis(const FrequencyAxisPtr& axis)
+{
+    if (frequencyAxis && axis && frequencyAxis->version() == axis->version())
+        return;
+    
+    frequencyAxis = axis;
+    frequencies = axis ? axis->values() : QVector<double>();
+    
+    // Eksen değişince marker'lar aynı frekansa en yakın bin'e taşınır
+    for (auto& marker : markers) {
+        if (marker.bin >= 0) {
+            marker.bin = frequencyAxis ? frequencyAxis->indexOf(marker.frequency) : -1;
+        }
+    }
+}
+
+void MainWindow::updateSweepCounters()
+{
+    if (!sweepCounterLabel || !acquisitionWorker)
+        return;
+    
+    sweepCounterLabel->setText(tr("Sweep: %1 alınan / %2 gösterilen / %3 atlanan")
+        .arg(acquisitionWorker->sweepsAcquired())
+        .arg(acquisitionWorker->sweepsDisplayed())
+        .arg(acquisitionWorker->sweepsDropped()));
+    
+    // Ölçüm motoru yetişemezse atlanan sweep'ler ayrıca gösterilir
+    if (measurementEngine->sweepsDropped() > 0) {
+        sweepCounterLabel->setText(sweepCounterLabel->text() + tr(" | ölçüm: %1 atlanan")
+            .arg(measurementEngine->sweepsDropped()));
+    }
+    
+    if (iqRecorder->isRecording()) {
+        sweepCounterLabel->setText(sweepCounterLabel->text() + tr(" | IQ kaydı: %1 MS, %2 blok atlanan")
+            .arg(iqRecorder->samplesRecorded() / 1000000)
+            .arg(iqRecorder->blocksDropped()));
+    }
+    
+    if (traceWriter->isOpen()) {
+        sweepCounterLabel->setText(sweepCounterLabel->text() + tr(" | trace oturumu: %1 sweep")
+            .arg(traceWriter->sweepCount()));
+    }
+}
+
+void MainWindow::updateSweepPlanInfo()
+{
+    if (!sweepPlanLabel || !device)
+        return;
+    
+    // RBW'ye karşı hız ayarı için planın gerçekleşen RBW'si ve süresi
+    const SweepPlan plan = device->getSweepPlan();
+    if (plan.segmentCount() <= 1) {
+        sweepPlanLabel->setText(tr("Tek segment (IF bant genişliği içinde)"));
+        return;
+    }
+    sweepPlanLabel->setText(tr("%1 segment, %2 bin, RBW %3 kHz\nTahmini sweep: %4 ms")
+        .arg(plan.segmentCount())
+        .arg(plan.outputBins)
+        .arg(plan.rbw / 1e3, 0, 'f', 1)
+        .arg(plan.sweepTime * 1e3, 0, 'f', 1));
+}
+
+void MainWindow::onAcquisitionError(const QString& message)
+{
+    QMessageBox::critical(this, "Hata", 
+        QString("Veri okuma hatası: %1").arg(message));
+    stopAcquisition();
+}
+
 void MainWindow::updatePlot()
 {
-    plotWidget->graph(0)->setData(frequencies, amplitudes);
+    refreshPlotData();
     plotWidget->replot();
 }
 
+void MainWindow::onPlotRangeChanged(const QCPRange&)
+{
+    refreshPlotData();
+    plotWidget->replot(QCustomPlot::rpQueuedReplot);
+}
+
+void MainWindow::refreshPlotData()
+{
+    // Görünür aralık piksel sütunlarına indirgenir (tepe korumalı)
+    const QCPRange range = plotWidget->xAxis->range();
+    const int columns = std::max(plotWidget->axisRect()->width(), 1);
+    
+    for (int t = 0; t < TraceProcessor::TRACE_COUNT; ++t) {
+        const std::vector<float>& trace = traceData[t];
+        TraceDecimator& decimator = traceDecimators[t];
+        const int n = decimator.decimate(frequencies.constData(), trace.data(),
+                                         std::min(frequencies.size(), static_cast<int>(trace.size())),
+                                         range.lower, range.upper, columns);
+        const std::vector<double>& keys = decimator.keys();
+        const std::vector<double>& values = decimator.values();
+        
+        // QCPGraphDataContainer yerinde güncellenir: gerekirse sona eklenerek
+        // büyütülür, fazlası anahtarı en büyük yapılıp sondan atılır
+        QSharedPointer<QCPGraphDataContainer> data = plotWidget->graph(t)->data();
+        const double tailKey = std::numeric_limits<double>::max();
+        for (int i = data->size(); i < n; ++i) {
+            data->add(QCPGraphData(tailKey, 0.0));
+        }
+        
+        auto it = data->begin();
+        for (int i = 0; i < n; ++i, ++it) {
+            it->key = keys[i];
+            it->value = values[i];
+        }
+        for (; it != data->end(); ++it) {
+            it->key = tailKey;
+        }
+        
+        if (n == 0) {
+            data->clear();
+        } else if (data->size() > n) {
+            data->removeAfter(keys[n - 1]);
+        }
+    }
+}
+
 void MainWindow::updateWaterfall()
 {
-    waterfallWidget->addData(amplitudes);
-    waterfallWidget->setFrequencyRange(
-        frequencies.first(), frequencies.last());
+    waterfallWidget->addData(amplitudes());
+    
+    // Eksen aynı kaldıkça waterfall aralığına dokunulmaz
+    if (frequencyAxis && frequencyAxis->version() != waterfallAxisVersion) {
+        waterfallAxisVersion = frequencyAxis->version();
+        waterfallWidget->setFrequencyRange(frequencyAxis->start(), frequencyAxis->stop());
+    }
 }
 
 // Slot implementasyonları...
@@ -296,14 +563,27 @@ void MainWindow::onSingleSweep()
         return;
     }
     
-    // Tek çekim için timer'ı bir kez çalıştır
-    updateData();
+    if (isRunning)
+        return;
+    
+    // Sürekli mod kapalıyken tek sweep GUI thread'inde alınır
+    SweepPtr sweep = device->bb_fetch_sweep();
+    if (sweep) {
+        traceProcessor->process(*sweep);
+        if (!traceWriter->append(*sweep) && traceWriter->isOpen())
+            onTraceSessionError(traceWriter->errorString());
+    }
+    applySweep(sweep);
+    measurementEngine->submit(currentSweep);
 }
 
 void MainWindow::onCenterFreqChanged(double freq)
 {
     if (device) {
         device->setCenterFrequency(freq);
+        iqRecorder->setCenterFrequency(freq);
+        refreshChannelPowerMeasurement();
+        updateSweepPlanInfo();
         updateData();
     }
 }
@@ -312,14 +592,17 @@ void MainWindow::onSpanChanged(double span)
 {
     if (device) {
         device->setSpan(span);
+        refreshChannelPowerMeasurement();
+        updateSweepPlanInfo();
         updateData();
     }
 }
 
 void MainWindow::onRBWChanged(int index)
 {
-    if (device) {
-        device->setRBW(index);
+    if (device && index >= 0 && index < static_cast<int>(std::size(RBW_VALUES))) {
+        device->setRBW(RBW_VALUES[index]);
+        updateSweepPlanInfo();
         updateData();
     }
 }
@@ -340,6 +623,39 @@ void MainWindow::onRefLevelChanged(double level)
     }
 }
 
+void MainWindow::onTraceSelected(int index)
+{
+    // Seçilen trace'in ayarları kontrollere yüklenir; yükleme ayar
+    // değişikliği sayılmaz
+    const TraceProcessor::TraceSettings settings = traceProcessor->traceSettings(index);
+    const QSignalBlocker modeBlocker(traceMode.get());
+    const QSignalBlocker averagingBlocker(traceAveraging.get());
+    const QSignalBlocker countBlocker(traceAverageCount.get());
+    traceMode->setCurrentIndex(static_cast<int>(settings.mode));
+    traceAveraging->setCurrentIndex(static_cast<int>(settings.averaging));
+    traceAverageCount->setValue(settings.averageCount);
+}
+
+void MainWindow::onTraceSettingsChanged()
+{
+    TraceProcessor::TraceSettings settings;
+    settings.mode = static_cast<TraceProcessor::Mode>(traceMode->currentIndex());
+    settings.averaging = static_cast<TraceProcessor::Averaging>(traceAveraging->currentIndex());
+    settings.averageCount = traceAverageCount->value();
+    traceProcessor->setTraceSettings(traceSelect->currentIndex(), settings);
+    
+    // Durdurulmuşken de kapatılan trace hemen silinsin
+    traceProcessor->copyTraces(traceData, traceDataVersion);
+    updatePlot();
+}
+
+void MainWindow::onTraceRestart()
+{
+    traceProcessor->restart();
+    traceProcessor->copyTraces(traceData, traceDataVersion);
+    updatePlot();
+}
+
 void MainWindow::onSaveTrace()
 {
     QString filename = QFileDialog::getSaveFileName(this,
@@ -349,9 +665,11 @@ void MainWindow::onSaveTrace()
     if (filename.isEmpty())
         return;
         
-    if (!dataManager->saveTrace(filename, frequencies, amplitudes)) {
+    const BBSettings settings = currentSweep ? currentSweep->settings() : device->getSettings();
+    const qint64 timestamp = currentSweep ? currentSweep->timestamp() : 0;
+    if (!dataManager->saveTrace(filename, frequencies, amplitudes(), settings, timestamp)) {
         QMessageBox::critical(this, tr("Hata"),
-            tr("Trace kaydedilemedi"));
+            tr("Trace kaydedilemedi: %1").arg(dataManager->getLastError()));
     }
 }
 
@@ -371,34 +689,62 @@ void MainWindow::onLoadTrace()
         return;
     }
     
-    frequencies = loadedFreqs;
-    amplitudes = loadedAmps;
+    setFrequencyAxis(FrequencyAxis::fromValues(loadedFreqs));
+    currentSweep = Sweep::fromTrace(frequencyAxis, loadedAmps);
+    peakIndex.build(amplitudes().constData(), amplitudes().size());
+    traceProcessor->process(*currentSweep);
+    traceProcessor->copyTraces(traceData, traceDataVersion);
+    updateMeasurements();
     updatePlot();
     updateWaterfall();
+    measurementEngine->submit(currentSweep);
 }
 
 void MainWindow::startAcquisition()
 {
+    // Her çalıştırma yeni bir worker ve sıfır sayaçlarla başlar
+    acquisitionWorker = std::make_unique<AcquisitionWorker>(device.get());
+    acquisitionWorker->setIQRingBuffer(iqRing.get());
+    acquisitionWorker->setIQRecorder(iqRecorder.get());
+    acquisitionWorker->setTraceWriter(traceWriter.get());
+    acquisitionWorker->setMeasurementEngine(measurementEngine.get());
+    acquisitionWorker->setTraceProcessor(traceProcessor.get());
+    connect(acquisitionWorker.get(), &AcquisitionWorker::sweepReady,
+            this, &MainWindow::updateData, Qt::QueuedConnection);
+    connect(acquisitionWorker.get(), &AcquisitionWorker::acquisitionError,
+            this, &MainWindow::onAcquisitionError, Qt::QueuedConnection);
+    connect(acquisitionWorker.get(), &AcquisitionWorker::traceWriteError,
+            this, &MainWindow::onTraceSessionError, Qt::QueuedConnection);
+    
     isRunning = true;
-    updateTimer->start(50);  // 50ms = 20 FPS
+    acquisitionWorker->start(QThread::HighPriority);
     statusBar()->showMessage(tr("Veri toplama başladı"));
 }
 
 void MainWindow::stopAcquisition()
 {
     isRunning = false;
-    updateTimer->stop();
+    if (acquisitionWorker) {
+        acquisitionWorker->stop();
+        updateSweepCounters();
+    }
     statusBar()->showMessage(tr("Veri toplama durdu"));
 }
 
+void MainWindow::createStatusBar()
+{
+    sweepCounterLabel = std::make_unique<QLabel>(this);
+    statusBar()->addPermanentWidget(sweepCounterLabel.get());
+}
+
 void MainWindow::updateMeasurements()
 {
-    if (frequencies.isEmpty() || amplitudes.isEmpty())
+    if (frequencies.isEmpty() || amplitudes().isEmpty())
         return;
         
-    // Aktif marker'ı güncelle
-    if (!markers.empty() && activeMarker < markers.size()) {
-        updateMarker(activeMarker);
+    // Marker'lar bin indeksi tuttuğundan her biri O(1) güncellenir
+    for (int i = 0; i < static_cast<int>(markers.size()); ++i) {
+        updateMarker(i);
     }
 }
 
@@ -423,7 +769,8 @@ void MainWindow::setupMarkers()
 
 void MainWindow::updateMarker(int index)
 {
-    if (index >= markers.size() || frequencies.isEmpty())
+    const QVector<double>& trace = amplitudes();
+    if (index >= markers.size() || !frequencyAxis || trace.isEmpty())
         return;
         
     auto& marker = markers[index];
@@ -431,9 +778,10 @@ void MainWindow::updateMarker(int index)
         return;
         
     // Marker pozisyonunu güncelle
-    int dataIndex = frequencies.size() / 2;  // Varsayılan olarak ortada
-    marker.frequency = frequencies[dataIndex];
-    marker.amplitude = amplitudes[dataIndex];
+    if (marker.bin < 0 || marker.bin >= trace.size())
+        marker.bin = trace.size() / 2;  // Varsayılan olarak ortada
+    marker.frequency = frequencyAxis->frequency(marker.bin);
+    marker.amplitude = trace[marker.bin];
     
     marker.tracer->setGraphKey(marker.frequency);
     marker.tracer->setGraphValue(marker.amplitude);
@@ -444,68 +792,70 @@ void MainWindow::updateMarker(int index)
         .arg(marker.frequency, 0, 'f', 0)
         .arg(marker.amplitude, 0, 'f', 1);
     marker.label->setText(labelText);
-    
+}
+
+void MainWindow::moveActiveMarker(int bin)
+{
+    if (bin < 0 || markers.empty() || activeMarker >= markers.size())
+        return;
+        
+    markers[activeMarker].bin = bin;
+    updateMarker(activeMarker);
     plotWidget->replot();
 }
 
+void MainWindow::onMarkerFreqChanged(double freq)
+{
+    if (frequencyAxis)
+        moveActiveMarker(frequencyAxis->indexOf(freq));
+}
+
 void MainWindow::onPeakSearch()
 {
-    if (frequencies.isEmpty() || amplitudes.isEmpty())
+    // En yüksek nokta dizin kurulurken bulunmuştur
+    moveActiveMarker(peakIndex.maximum());
+}
+
+void MainWindow::onNextPeak()
+{
+    if (markers.empty() || amplitudes().isEmpty())
         return;
         
-    // En yüksek genlikli noktayı bul
-    int peakIndex = 0;
-    double peakValue = amplitudes[0];
-    
-    for (int i = 1; i < amplitudes.size(); ++i) {
-        if (amplitudes[i] > peakValue) {
-            peakValue = amplitudes[i];
-            peakIndex = i;
-        }
-    }
-    
-    // Aktif marker'ı tepe noktasına taşı
-    if (!markers.empty() && activeMarker < markers.size()) {
-        auto& marker = markers[activeMarker];
-        marker.frequency = frequencies[peakIndex];
-        marker.amplitude = amplitudes[peakIndex];
-        updateMarker(activeMarker);
-    }
+    // Aktif marker'dan düşük genlikli en yüksek tepe
+    const int bin = markers[activeMarker].bin;
+    if (bin >= 0 && bin < amplitudes().size())
+        moveActiveMarker(peakIndex.nextLower(bin, amplitudes()[bin]));
 }
 
-void MainWindow::onNextPeak()
+void MainWindow::onNextPeakLeft()
+{
+    if (!markers.empty())
+        moveActiveMarker(peakIndex.nextLeft(markers[activeMarker].bin));
+}
+
+void MainWindow::onNextPeakRight()
+{
+    if (!markers.empty())
+        moveActiveMarker(peakIndex.nextRight(markers[activeMarker].bin));
+}
+
+void MainWindow::onMinSearch()
 {
-    if (frequencies.isEmpty() || amplitudes.isEmpty() || markers.empty())
+    moveActiveMarker(peakIndex.minimum());
+}
+
+void MainWindow::onMarkerToPeak()
+{
+    if (!markers.empty())
+        moveActiveMarker(peakIndex.nearest(markers[activeMarker].bin));
+}
+
+void MainWindow::onMarkerToCenter()
+{
+    if (markers.empty() || markers[activeMarker].bin < 0)
         return;
         
-    const auto& currentMarker = markers[activeMarker];
-    int currentIndex = 0;
-    
-    // Mevcut marker'ın indeksini bul
-    for (int i = 0; i < frequencies.size(); ++i) {
-        if (std::abs(frequencies[i] - currentMarker.frequency) < 1e-6) {
-            currentIndex = i;
-            break;
-        }
-    }
-    
-    // Sonraki tepe noktasını bul
-    int nextPeakIndex = -1;
-    double nextPeakValue = -INFINITY;
-    
-    for (int i = currentIndex + 1; i < amplitudes.size(); ++i) {
-        if (amplitudes[i] > nextPeakValue && amplitudes[i] < currentMarker.amplitude) {
-            nextPeakValue = amplitudes[i];
-            nextPeakIndex = i;
-        }
-    }
-    
-    if (nextPeakIndex != -1) {
-        auto& marker = markers[activeMarker];
-        marker.frequency = frequencies[nextPeakIndex];
-        marker.amplitude = amplitudes[nextPeakIndex];
-        updateMarker(activeMarker);
-    }
+    centerFreq->setValue(markers[activeMarker].frequency);
 }
 
 void MainWindow::onDeltaMarkerToggled(bool enabled)
@@ -527,104 +877,268 @@ void MainWindow::onDeltaMarkerToggled(bool enabled)
         marker.label->setText("Δ");
         marker.label->setColor(Qt::red);
         
+        marker.bin = markers[0].bin;  // Referans marker'ın bin'inden başlar
         markers.push_back(marker);
         activeMarker = 1;
         updateMarker(activeMarker);
+        plotWidget->replot();
     }
 }
 
-void MainWindow::onChannelPowerMeasure()
+MeasurementConfig MainWindow::channelPowerConfig() const
+{
+    MeasurementConfig config;
+    config.type = MeasurementConfig::Type::ChannelPower;
+    config.startFreq = centerFreq->value() - spanFreq->value() / 4;  // 25% span
+    config.stopFreq = centerFreq->value() + spanFreq->value() / 4;   // 25% span
+    return config;
+}
+
+void MainWindow::toggleMeasurement(const MeasurementConfig& config, bool enabled)
 {
-    if (frequencies.isEmpty() || amplitudes.isEmpty())
+    // Tür başına tek ölçüm; ayar değişince eskisi yenisiyle değiştirilir
+    auto it = measurementIds.find(config.type);
+    if (it != measurementIds.end()) {
+        measurementEngine->removeMeasurement(it->second);
+        measurementIds.erase(it);
+    }
+    
+    const int row = static_cast<int>(config.type);
+    if (!enabled) {
+        measureTable->item(row, 1)->setText(tr("Kapalı"));
+        measureTable->item(row, 2)->setText(QString());
         return;
-        
-    double startFreq = centerFreq->value() - spanFreq->value() / 4;  // 25% span
-    double stopFreq = centerFreq->value() + spanFreq->value() / 4;   // 25% span
+    }
     
-    double power = analyzer->measureChannelPower(frequencies, amplitudes, startFreq, stopFreq);
+    measurementIds[config.type] = measurementEngine->addMeasurement(config);
+    measureTable->item(row, 1)->setText(tr("Bekleniyor"));
     
-    QMessageBox::information(this, tr("Kanal Gücü"),
-        tr("Kanal Gücü: %1 dBm").arg(power, 0, 'f', 2));
+    // Sürekli mod kapalıyken ekrandaki sweep hemen ölçülür
+    if (!isRunning && currentSweep) {
+        measurementEngine->submit(currentSweep);
+    }
+}
+
+void MainWindow::refreshChannelPowerMeasurement()
+{
+    // Kanal merkez/span'e bağlı; açık ölçüm yeni pencereyle yenilenir
+    if (measurementIds.count(MeasurementConfig::Type::ChannelPower)) {
+        toggleMeasurement(channelPowerConfig(), true);
+    }
+}
+
+void MainWindow::onChannelPowerMeasure(bool enabled)
+{
+    toggleMeasurement(channelPowerConfig(), enabled);
+}
+
+void MainWindow::onOBWMeasure(bool enabled)
+{
+    MeasurementConfig config;
+    config.type = MeasurementConfig::Type::OBW;
+    config.percentPower = 99.0;  // 99% güç
+    toggleMeasurement(config, enabled);
+}
+
+void MainWindow::onACPRMeasure(bool enabled)
+{
+    MeasurementConfig config;
+    config.type = MeasurementConfig::Type::ACPR;
+    config.channelBW = 1e6;       // 1 MHz
+    config.channelSpacing = 2e6;  // 2 MHz
+    toggleMeasurement(config, enabled);
 }
 
-void MainWindow::onOBWMeasure()
+void MainWindow::onSpurSearch(bool enabled)
 {
-    if (frequencies.isEmpty() || amplitudes.isEmpty())
+    MeasurementConfig config;
+    config.type = MeasurementConfig::Type::Spurs;
+    config.spurSearch.threshold = -50.0;  // -50 dBm eşik değeri
+    config.spurSearch.excursion = 3.0;    // Gürültü sivrilikleri tepe sayılmaz
+    config.spurSearch.maxPeaks = 50;
+    toggleMeasurement(config, enabled);
+}
+
+void MainWindow::onMeasurementResults()
+{
+    QVector<MeasurementResult> results;
+    if (!measurementEngine->takeResults(results))
         return;
+    
+    for (const MeasurementResult& result : results) {
+        // Kapatılmış ya da değiştirilmiş ölçümün geç gelen sonucu yazılmaz
+        auto it = measurementIds.find(result.type);
+        if (it == measurementIds.end() || it->second != result.id)
+            continue;
         
-    double obw = analyzer->measureOBW(frequencies, amplitudes, 99.0);  // 99% güç
+        QString text;
+        switch (result.type) {
+        case MeasurementConfig::Type::ChannelPower:
+            text = tr("%1 dBm").arg(result.value, 0, 'f', 2);
+            break;
+        case MeasurementConfig::Type::OBW:
+            text = tr("%1 Hz").arg(result.value, 0, 'f', 0);
+            break;
+        case MeasurementConfig::Type::ACPR:
+            text = tr("Ana %1 dBm, Alt %2 dB, Üst %3 dB")
+                       .arg(result.acpr.mainChannelPower, 0, 'f', 2)
+                       .arg(result.acpr.lowerRatio, 0, 'f', 2)
+                       .arg(result.acpr.upperRatio, 0, 'f', 2);
+            break;
+        case MeasurementConfig::Type::Spurs:
+            if (result.spurs.isEmpty()) {
+                text = tr("Spur yok");
+            } else {
+                text = tr("%1 spur, en güçlü %2 Hz / %3 dBm")
+                           .arg(result.spurs.size())
+                           .arg(result.spurs.first().frequency, 0, 'f', 0)
+                           .arg(result.spurs.first().amplitude, 0, 'f', 1);
+            }
+            break;
+        }
+        
+        const int row = static_cast<int>(result.type);
+        measureTable->item(row, 1)->setText(text);
+        measureTable->item(row, 2)->setText(QString::number(result.sweepIndex));
+    }
+}
+
+void MainWindow::onMeasurementLog()
+{
+    // Kayıt açıksa ikinci seçim kaydı kapatır
+    if (!measurementEngine->logFile().isEmpty()) {
+        measurementEngine->setLogFile(QString());
+        statusBar()->showMessage(tr("Ölçüm kaydı kapatıldı"));
+        return;
+    }
     
-    QMessageBox::information(this, tr("OBW"),
-        tr("Occupied Bandwidth: %1 Hz").arg(obw, 0, 'f', 0));
+    QString filename = QFileDialog::getSaveFileName(this,
+        tr("Ölçüm Kaydı"), QString(),
+        tr("CSV Dosyaları (*.csv);;Tüm Dosyalar (*)"));
+        
+    if (filename.isEmpty())
+        return;
+        
+    if (!measurementEngine->setLogFile(filename)) {
+        QMessageBox::critical(this, tr("Hata"),
+            tr("Ölçüm kaydı açılamadı"));
+        return;
+    }
+    statusBar()->showMessage(tr("Ölçüm kaydı: %1").arg(filename));
 }
 
-void MainWindow::onACPRMeasure()
+void MainWindow::onMeasurementLogError(const QString& message)
 {
-    if (frequencies.isEmpty() || amplitudes.isEmpty())
+    QMessageBox::warning(this, tr("Uyarı"), message);
+}
+
+void MainWindow::onIQRecord()
+{
+    if (iqRecorder->isRecording()) {
+        iqRecorder->stopRecording();
+        statusBar()->showMessage(tr("IQ kaydı durdu: %1 örnek, %2 blok atlandı")
+            .arg(iqRecorder->samplesWritten())
+            .arg(iqRecorder->blocksDropped()));
         return;
+    }
+    
+    const QString int16Filter = tr("Kompakt int16 Kayıt (*.iq)");
+    const QString int8Filter = tr("Kompakt int8 Kayıt (*.iq)");
+    QString selectedFilter;
+    QString filename = QFileDialog::getSaveFileName(this,
+        tr("IQ Kaydı"), QString(),
+        tr("SigMF Kayıtları (*.sigmf-data)") + ";;" + int16Filter + ";;" + int8Filter
+            + ";;" + tr("Tüm Dosyalar (*)"),
+        &selectedFilter);
         
-    double channelBW = 1e6;     // 1 MHz
-    double channelSpacing = 2e6; // 2 MHz
+    if (filename.isEmpty())
+        return;
     
-    auto result = analyzer->measureACPR(frequencies, amplitudes, channelBW, channelSpacing);
+    // Kompakt kayıtta en hızlı kullanılabilir sıkıştırma seçilir
+    IQRecorderOptions options;
+    if (selectedFilter == int16Filter || selectedFilter == int8Filter) {
+        options.encoding.format = selectedFilter == int8Filter ? IQSampleFormat::CI8
+                                                               : IQSampleFormat::CI16;
+        options.encoding.compression = IQCodec::isAvailable(IQCompression::LZ4)
+            ? IQCompression::LZ4 : IQCompression::DeltaVarint;
+    }
     
-    QString message = tr("ACPR Ölçümü:\n\n"
-                        "Ana Kanal Gücü: %1 dBm\n"
-                        "Alt Kanal Gücü: %2 dBm\n"
-                        "Üst Kanal Gücü: %3 dBm\n"
-                        "Alt Kanal Oranı: %4 dB\n"
-                        "Üst Kanal Oranı: %5 dB")
-                        .arg(result.mainChannelPower, 0, 'f', 2)
-                        .arg(result.lowerChannelPower, 0, 'f', 2)
-                        .arg(result.upperChannelPower, 0, 'f', 2)
-                        .arg(result.lowerRatio, 0, 'f', 2)
-                        .arg(result.upperRatio, 0, 'f', 2);
-                        
-    QMessageBox::information(this, tr("ACPR"), message);
+    // Hata sonrası bitmiş kaydın thread'i toplanır
+    iqRecorder->stopRecording();
+    const BBSettings settings = device->getSettings();
+    if (!iqRecorder->startRecording(filename, settings.sampleRate, settings.centerFreq, options)) {
+        QMessageBox::critical(this, tr("Hata"),
+            tr("IQ kaydı başlatılamadı: %1").arg(iqRecorder->errorString()));
+        return;
+    }
+    statusBar()->showMessage(tr("IQ kaydı: %1").arg(iqRecorder->dataPath()));
 }
 
-void MainWindow::onSpurSearch()
+void MainWindow::onTraceSessionRecord()
 {
-    if (frequencies.isEmpty() || amplitudes.isEmpty())
+    if (traceWriter->isOpen()) {
+        const quint64 sweeps = traceWriter->sweepCount();
+        if (!traceWriter->close()) {
+            QMessageBox::warning(this, tr("Uyarı"),
+                tr("Trace oturumu kapatılamadı: %1").arg(traceWriter->errorString()));
+            return;
+        }
+        statusBar()->showMessage(tr("Trace oturumu kapandı: %1 sweep").arg(sweeps));
         return;
-        
-    double threshold = -50.0;  // -50 dBm eşik değeri
-    auto spurs = analyzer->findSpurs(frequencies, amplitudes, threshold);
+    }
     
-    if (spurs.isEmpty()) {
-        QMessageBox::information(this, tr("Spur Arama"),
-            tr("Eşik değerinin üzerinde spur bulunamadı."));
+    QString filename = QFileDialog::getSaveFileName(this,
+        tr("Trace Oturumu"), QString(),
+        tr("Trace Dosyaları (*.trace);;Tüm Dosyalar (*)"));
+        
+    if (filename.isEmpty())
         return;
-    }
     
-    QString message = tr("Bulunan Spurlar:\n\n");
-    for (int i = 0; i < spurs.size(); ++i) {
-        message += tr("Spur %1:\n"
-                     "  Frekans: %2 Hz\n"
-                     "  Genlik: %3 dBm\n"
-                     "  Bağıl Güç: %4 dB\n\n")
-                     .arg(i + 1)
-                     .arg(spurs[i].frequency, 0, 'f', 0)
-                     .arg(spurs[i].amplitude, 0, 'f', 1)
-                     .arg(spurs[i].relativePower, 0, 'f', 1);
+    if (!traceWriter->open(filename, device->getSettings(), QDateTime::currentMSecsSinceEpoch())) {
+        QMessageBox::critical(this, tr("Hata"),
+            tr("Trace oturumu açılamadı: %1").arg(traceWriter->errorString()));
+        return;
     }
-    
-    QMessageBox::information(this, tr("Spur Arama"), message);
+    statusBar()->showMessage(tr("Trace oturumu: %1").arg(filename));
+}
+
+void MainWindow::onTraceSessionError(const QString& message)
+{
+    // Hataya kadarki sweep'ler indekslenerek oturum kapatılır
+    const quint64 sweeps = traceWriter->sweepCount();
+    traceWriter->close();
+    QMessageBox::warning(this, tr("Uyarı"),
+        tr("Trace oturumuna yazılamadı, oturum %1 sweep ile kapatıldı: %2")
+            .arg(sweeps).arg(message));
+}
+
+void MainWindow::onIQRecordError(const QString& message)
+{
+    iqRecorder->stopRecording();
+    QMessageBox::warning(this, tr("Uyarı"), message);
 }
 
 void MainWindow::onPhaseNoiseMeasure()
 {
-    if (frequencies.isEmpty() || amplitudes.isEmpty())
+    if (frequencies.isEmpty() || amplitudes().isEmpty())
         return;
         
     // Faz gürültüsü ölçüm noktaları (offset frekansları)
     QVector<double> offsets = {1e3, 10e3, 100e3, 1e6};  // 1k, 10k, 100k, 1M Hz
     
-    // IQ verisi al
-    auto iqData = device->bb_fetch_iq_data();
+    // En yeni IQ bloğunu halkadan kopyalamadan al
+    fetchIQBlock();
+    IQRingBuffer::BlockView block;
+    if (!analyzerReader.latest(block))
+        return;
     double sampleRate = device->getSampleRate();
     
-    auto phaseNoise = analyzer->measurePhaseNoise(iqData, sampleRate, offsets);
+    auto phaseNoise = analyzer->measurePhaseNoise(block.data, block.count, sampleRate, offsets);
+    if (!analyzerReader.isValid(block)) {
+        QMessageBox::warning(this, tr("Uyarı"),
+            tr("IQ bloğu ölçüm sırasında üzerine yazıldı, tekrar deneyin"));
+        return;
+    }
     
     QString message = tr("Faz Gürültüsü Ölçümü:\n\n");
     for (int i = 0; i < offsets.size(); ++i) {
@@ -668,14 +1182,24 @@ void MainWindow::updateDemodulation()
     if (!device || !demodulator)
         return;
         
-    // IQ verisi al
-    auto iqData = device->bb_fetch_iq_data();
+    // Kanallaştırıcı planı giriş hızına bağlı; değişmediyse işlem yapılmaz
+    demodulator->setSampleRate(device->getSampleRate());
     
-    // Demodüle et
-    auto audioData = demodulator->demodulate(iqData);
+    // Sürekli mod kapalıyken bloğu GUI thread'i çeker
+    fetchIQBlock();
     
-    // Audio verisi işleme/oynatma kodu buraya gelecek
-    // ...
+    IQRingBuffer::BlockView block;
+    while (demodReader.next(block)) {
+        // Demodüle et
+        auto audioData = demodulator->demodulate(block.data, block.count);
+        
+        // İşlem sırasında blok üzerine yazıldıysa sonucu at
+        if (!demodReader.isValid(block))
+            continue;
+        
+        // Audio verisi işleme/oynatma kodu buraya gelecek
+        // ...
+    }
 }
 
 void MainWindow::processIQData()
@@ -684,11 +1208,8 @@ void MainWindow::processIQData()
         return;
         
     try {
-        // IQ verisi al
-        auto iqData = device->bb_fetch_iq_data();
-        
         // Demodülasyon aktif ise
-        if (demodType->currentIndex() != 0) {  // 0 = Demodülasyon yok
+        if (demodType && demodType->currentIndex() != 0) {  // 0 = Demodülasyon yok
             updateDemodulation();
         }
         
@@ -698,4 +1219,19 @@ void MainWindow::processIQData()
     }
 }
 
-// Diğer slot implementasyonları... 
\ No newline at end of file
+bool MainWindow::fetchIQBlock()
+{
+    // Veri toplama sürerken halkanın tek yazıcısı acquisition thread'idir
+    if (isRunning || !device || !device->isConnected())
+        return false;
+        
+    std::complex<float>* block = iqRing->beginWrite();
+    const int count = device->bb_fetch_iq_data(block, iqRing->blockSize());
+    iqRing->commitWrite(count);
+    // Tek tek çekilen bloklar arasında zaman boşluğu vardır
+    iqRecorder->markDiscontinuity();
+    iqRecorder->submit(block, count);
+    return true;
+}
+
+// Diğer slot implementasyonları...
\ No newline at end of file
@@ -15,6 +15,7 @@
 #include <QToolBar>
 #include <QStatusBar>
 #include <QSlider>
+#include <QTableWidget>
 
 // Qt Custom Widgets
 #include <QCustomPlot>
@@ -23,6 +24,8 @@
 #include <complex>
 #include <vector>
 #include <memory>
+#include <map>
+#include <array>
 
 // Project Headers
 #include "bb_api.h"
@@ -30,6 +33,17 @@
 #include "demodulator.h"
 #include "analyzer.h"
 #include "datamanager.h"
+#include "acquisitionworker.h"
+#include "iqringbuffer.h"
+#include "iqrecorder.h"
+#include "tracedecimator.h"
+#include "frequencyaxis.h"
+#include "sweep.h"
+#include "measurementengine.h"
+#include "peakindex.h"
+#include "traceprocessor.h"
+#include "tracefile.h"
+#include "sweepplanner.h"
 
 // Forward declarations
 class BbDeviceInterface;
@@ -61,7 +75,11 @@ private slots:
     void onMarkerFreqChanged(double freq);
     void onPeakSearch();
     void onNextPeak();
+    void onNextPeakLeft();
+    void onNextPeakRight();
+    void onMinSearch();
     void onMarkerToPeak();
+    void onMarkerToCenter();
     void onDeltaMarkerToggled(bool enabled);
     
     // Trigger
@@ -74,6 +92,11 @@ private slots:
     void onDemodFreqChanged(double freq);
     void onDemodBWChanged(double bw);
     
+    // Trace matematiği
+    void onTraceSelected(int index);
+    void onTraceSettingsChanged();
+    void onTraceRestart();
+    
     // Veri kaydetme/yükleme
     void onSaveTrace();
     void onLoadTrace();
@@ -81,15 +104,30 @@ private slots:
     void onLoadState();
     void onExportData();
     
-    // Analiz araçları
-    void onChannelPowerMeasure();
-    void onOBWMeasure();
-    void onACPRMeasure();
-    void onSpurSearch();
+    // Analiz araçları; sürekli ölçümler menüden açılıp kapatılır
+    void onChannelPowerMeasure(bool enabled);
+    void onOBWMeasure(bool enabled);
+    void onACPRMeasure(bool enabled);
+    void onSpurSearch(bool enabled);
     void onPhaseNoiseMeasure();
+    void onMeasurementLog();
+    // Sürekli IQ kaydı (SigMF); ikinci seçim kaydı durdurur
+    void onIQRecord();
+    void onIQRecordError(const QString& message);
+    // Her sweep'i ikili trace oturum dosyasına ekler; ikinci seçim kapatır
+    void onTraceSessionRecord();
+    void onTraceSessionError(const QString& message);
+    
+    // Ölçüm motorundan gelen sonuçlar (görüntüleme hızında)
+    void onMeasurementResults();
+    void onMeasurementLogError(const QString& message);
 
-    // Veri güncelleme - slot olarak tanımlandı
+    // Veri güncelleme - acquisition thread'inden gelen sweep'ler için
     void updateData();
+    void onAcquisitionError(const QString& message);
+    
+    // Yakınlaştırma/kaydırmada görüntü seyreltmesini yenile
+    void onPlotRangeChanged(const QCPRange& range);
 
 private:
     // GUI bileşenleri
@@ -110,6 +148,8 @@ private:
     std::unique_ptr<QComboBox> rbwSelect;
     std::unique_ptr<QComboBox> vbwSelect;
     std::unique_ptr<QDoubleSpinBox> refLevel;
+    // Geniş span'de segment sayısı ve tahmini sweep süresi
+    std::unique_ptr<QLabel> sweepPlanLabel;
     
     // Trigger kontrolleri
     std::unique_ptr<QComboBox> triggerSource;
@@ -122,9 +162,21 @@ private:
     std::unique_ptr<QDoubleSpinBox> demodBW;
     std::unique_ptr<QSlider> volumeSlider;
     
+    // Trace paneli: seçili trace'in modu ve ortalama ayarları
+    std::unique_ptr<QComboBox> traceSelect;
+    std::unique_ptr<QComboBox> traceMode;
+    std::unique_ptr<QComboBox> traceAveraging;
+    std::unique_ptr<QSpinBox> traceAverageCount;
+    
+    // Ölçüm paneli: her ölçüm türü için bir satır
+    std::unique_ptr<QTableWidget> measureTable;
+    
     // Marker sistemi
+    // Marker bin indeksini tutar; frekans ve genlik her sweep'te o
+    // bin'den okunur (frekansla yeniden arama yapılmaz)
     struct Marker {
         bool active{false};
+        int bin{-1};
         double frequency{0.0};
         double amplitude{-120.0};
         QCPItemTracer* tracer{nullptr};
@@ -144,11 +196,42 @@ private:
     std::unique_ptr<Analyzer> analyzer;
     std::unique_ptr<DataManager> dataManager;
     
+    // Sürekli ölçümler kendi thread'inde her sweep'te hesaplanır
+    std::unique_ptr<MeasurementEngine> measurementEngine;
+    std::map<MeasurementConfig::Type, int> measurementIds;
+    
+    // Trace matematiği acquisition thread'inde her sweep'e uygulanır;
+    // GUI görüntüleme hızında son durumun kopyasını alır
+    std::unique_ptr<TraceProcessor> traceProcessor;
+    std::array<std::vector<float>, TraceProcessor::TRACE_COUNT> traceData;
+    quint64 traceDataVersion{0};
+    
+    // Acquisition thread'inden gelen IQ bloklarını diske yazar
+    std::unique_ptr<IQRecorder> iqRecorder;
+    
+    // Acquisition thread'inin sweep'lerini oturum dosyasına yazar
+    std::unique_ptr<TraceFileWriter> traceWriter;
+    
     // Veri toplama ve işleme
-    std::unique_ptr<QTimer> updateTimer;
+    std::unique_ptr<AcquisitionWorker> acquisitionWorker;
+    std::unique_ptr<QLabel> sweepCounterLabel;
+    FrequencyAxisPtr frequencyAxis;  // frequencies bu eksenin değerlerini paylaşır
     QVector<double> frequencies;
-    QVector<double> amplitudes;
-    QVector<std::complex<float>> iqData;
+    // Gösterilen sweep; genlikler kopyalanmaz, amplitudes() ile okunur
+    SweepPtr currentSweep;
+    quint64 waterfallAxisVersion{0};
+    
+    // Gösterilen sweep'in tepe dizini; sweep geldiğinde bir kez kurulur
+    PeakIndex peakIndex;
+    
+    // Grafiğe piksel sütunu başına min/max çiftleri verilir
+    std::array<TraceDecimator, TraceProcessor::TRACE_COUNT> traceDecimators;
+    
+    // IQ blokları: cihaz bir kez yazar, tüketiciler kopyalamadan okur
+    static constexpr int IQ_RING_BLOCKS = 256;  // ~100 ms @ 40 MS/s
+    std::unique_ptr<IQRingBuffer> iqRing;
+    IQRingBuffer::Reader demodReader;
+    IQRingBuffer::Reader analyzerReader;
     
     // Yardımcı fonksiyonlar
     void setupUI();
@@ -157,15 +240,26 @@ private:
     void createDockWindows();
     void createStatusBar();
     void setupPlot();
+    void applySweep(const SweepPtr& sweep);
+    const QVector<double>& amplitudes() const;
+    void setFrequencyAxis(const FrequencyAxisPtr& axis);
+    void updateSweepCounters();
+    void updateSweepPlanInfo();
     void updatePlot();
+    void refreshPlotData();
     void updateWaterfall();
     void updateMeasurements();
+    void toggleMeasurement(const MeasurementConfig& config, bool enabled);
+    void refreshChannelPowerMeasurement();
+    MeasurementConfig channelPowerConfig() const;
     void updateDemodulation();
     void processIQData();
+    bool fetchIQBlock();
     void startAcquisition();
     void stopAcquisition();
     void setupMarkers();
     void updateMarker(int index);
+    void moveActiveMarker(int bin);
 };
 
 #endif // MAINWINDOW_H 
\ No newline at end of file
@@ -0,0 +1,323 @@
+#include "measurementengine.h"
+#include <QFile>
+#include <QMutexLocker>
+#include <QTextStream>
+#include <algorithm>
+
+namespace {
+
+const char* typeName(MeasurementConfig::Type type)
+{
+    switch (type) {
+    case MeasurementConfig::Type::ChannelPower: return "channel_power";
+    case MeasurementConfig::Type::OBW:          return "obw";
+    case MeasurementConfig::Type::ACPR:         return "acpr";
+    case MeasurementConfig::Type::Spurs:        return "spurs";
+    }
+    return "unknown";
+}
+
+} // namespace
+
+// PIMPL implementation
+struct MeasurementEngine::Impl {
+    struct Entry {
+        int id{0};
+        MeasurementConfig config;
+    };
+
+    // Kayıtlı ölçümler; motor kendi kopyasını yalnızca sürüm değişince yeniler
+    mutable QMutex configMutex;
+    std::vector<Entry> entries;
+    int nextId{1};
+    quint64 configVersion{1};
+    std::atomic<int> measurementCount{0};
+
+    // Motor thread'ine ait
+    std::vector<Entry> active;
+    quint64 activeVersion{0};
+    QVector<MeasurementResult> results;
+    Analyzer analyzer;  // Yalnızca motor thread'inden kullanılır
+
+    // Sabit kapasiteli giriş halkası
+    QMutex queueMutex;
+    QWaitCondition queueNotEmpty;
+    std::vector<SweepPtr> queue{std::vector<SweepPtr>(DEFAULT_QUEUE_CAPACITY)};
+    int queueHead{0};
+    int queueCount{0};
+
+    // GUI'ye giden en son sonuçlar
+    QMutex resultMutex;
+    QVector<MeasurementResult> latest;
+    bool hasNewResults{false};
+    bool notifyPending{false};
+
+    // Sonuç kaydı (her sweep)
+    mutable QMutex logMutex;
+    QFile log;
+    QTextStream logStream;
+};
+
+MeasurementEngine::MeasurementEngine(QObject *parent)
+    : QThread(parent)
+    , pimpl(std::make_unique<Impl>())
+{
+}
+
+MeasurementEngine::~MeasurementEngine()
+{
+    stop();
+}
+
+int MeasurementEngine::addMeasurement(const MeasurementConfig& config)
+{
+    QMutexLocker locker(&pimpl->configMutex);
+    const int id = pimpl->nextId++;
+    pimpl->entries.push_back({id, config});
+    ++pimpl->configVersion;
+    pimpl->measurementCount.store(static_cast<int>(pimpl->entries.size()));
+    return id;
+}
+
+void MeasurementEngine::removeMeasurement(int id)
+{
+    {
+        QMutexLocker locker(&pimpl->configMutex);
+        auto& entries = pimpl->entries;
+        entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                     [id](const Impl::Entry& e) { return e.id == id; }),
+                      entries.end());
+        ++pimpl->configVersion;
+        pimpl->measurementCount.store(static_cast<int>(entries.size()));
+    }
+
+    // Kaldırılan ölçümün eski sonucu GUI'ye bir daha verilmez
+    QMutexLocker locker(&pimpl->resultMutex);
+    auto& latest = pimpl->latest;
+    latest.erase(std::remove_if(latest.begin(), latest.end(),
+                                [id](const MeasurementResult& r) { return r.id == id; }),
+                 latest.end());
+}
+
+void MeasurementEngine::clearMeasurements()
+{
+    {
+        QMutexLocker locker(&pimpl->configMutex);
+        pimpl->entries.clear();
+        ++pimpl->configVersion;
+        pimpl->measurementCount.store(0);
+    }
+
+    QMutexLocker locker(&pimpl->resultMutex);
+    pimpl->latest.clear();
+}
+
+bool MeasurementEngine::hasMeasurements() const
+{
+    return pimpl->measurementCount.load() > 0;
+}
+
+bool MeasurementEngine::setLogFile(const QString& filename)
+{
+    QMutexLocker locker(&pimpl->logMutex);
+    if (pimpl->log.isOpen()) {
+        pimpl->logStream.flush();
+        pimpl->log.close();
+    }
+    pimpl->logStream.setDevice(nullptr);
+
+    if (filename.isEmpty())
+        return true;
+
+    pimpl->log.setFileName(filename);
+    if (!pimpl->log.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+        return false;
+
+    pimpl->logStream.setDevice(&pimpl->log);
+    // Varsayılan 6 anlamlı basamak 935.2125 MHz'i 9.35212e+08 yazar;
+    // frekanslar Hz, seviyeler dB cinsinden sabit iki ondalıkla yazılır
+    pimpl->logStream.setRealNumberNotation(QTextStream::FixedNotation);
+    pimpl->logStream.setRealNumberPrecision(2);
+    pimpl->logStream << "sweep,timestamp_ms,id,type,value,"
+                        "main_dbm,lower_dbm,upper_dbm,lower_db,upper_db,"
+                        "peak_hz,peak_dbm\n";
+    return true;
+}
+
+QString MeasurementEngine::logFile() const
+{
+    QMutexLocker locker(&pimpl->logMutex);
+    return pimpl->log.isOpen() ? pimpl->log.fileName() : QString();
+}
+
+void MeasurementEngine::submit(const SweepPtr& sweep)
+{
+    if (!sweep || !hasMeasurements())
+        return;
+
+    QMutexLocker locker(&pimpl->queueMutex);
+    const int capacity = static_cast<int>(pimpl->queue.size());
+
+    // Motor yetişemiyorsa en eski sweep atılır; acquisition asla beklemez
+    if (pimpl->queueCount >= capacity) {
+        pimpl->queue[pimpl->queueHead].reset();
+        pimpl->queueHead = (pimpl->queueHead + 1) % capacity;
+        --pimpl->queueCount;
+        dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+    pimpl->queue[(pimpl->queueHead + pimpl->queueCount) % capacity] = sweep;
+    ++pimpl->queueCount;
+    pimpl->queueNotEmpty.wakeOne();
+}
+
+void MeasurementEngine::stop()
+{
+    stopRequested.store(true);
+    {
+        QMutexLocker locker(&pimpl->queueMutex);
+        pimpl->queueNotEmpty.wakeAll();
+    }
+    if (isRunning()) {
+        wait();
+    }
+}
+
+bool MeasurementEngine::takeResults(QVector<MeasurementResult>& results)
+{
+    QMutexLocker locker(&pimpl->resultMutex);
+    pimpl->notifyPending = false;
+
+    if (!pimpl->hasNewResults)
+        return false;
+
+    results = pimpl->latest;
+    pimpl->hasNewResults = false;
+    return true;
+}
+
+void MeasurementEngine::run()
+{
+    while (!stopRequested.load()) {
+        SweepPtr sweep;
+        {
+            QMutexLocker locker(&pimpl->queueMutex);
+            while (pimpl->queueCount == 0 && !stopRequested.load()) {
+                pimpl->queueNotEmpty.wait(&pimpl->queueMutex);
+            }
+            if (stopRequested.load())
+                break;
+
+            const int capacity = static_cast<int>(pimpl->queue.size());
+            sweep = std::move(pimpl->queue[pimpl->queueHead]);
+            pimpl->queueHead = (pimpl->queueHead + 1) % capacity;
+            --pimpl->queueCount;
+        }
+
+        evaluate(*sweep);
+        evaluated.fetch_add(1, std::memory_order_relaxed);
+        publish();
+    }
+}
+
+void MeasurementEngine::evaluate(const Sweep& sweep)
+{
+    {
+        QMutexLocker locker(&pimpl->configMutex);
+        if (pimpl->activeVersion != pimpl->configVersion) {
+            pimpl->active = pimpl->entries;
+            pimpl->activeVersion = pimpl->configVersion;
+        }
+    }
+
+    const int count = static_cast<int>(pimpl->active.size());
+    pimpl->results.resize(count);
+    if (count == 0 || !sweep.axis())
+        return;
+
+    Analyzer& analyzer = pimpl->analyzer;
+    for (int i = 0; i < count; ++i) {
+        const Impl::Entry& entry = pimpl->active[i];
+        const MeasurementConfig& config = entry.config;
+        MeasurementResult& result = pimpl->results[i];
+        result.id = entry.id;
+        result.type = config.type;
+        result.sweepIndex = sweep.index();
+        result.timestamp = sweep.timestamp();
+        result.spurs.clear();
+
+        switch (config.type) {
+        case MeasurementConfig::Type::ChannelPower:
+            result.value = analyzer.measureChannelPower(sweep, config.startFreq, config.stopFreq);
+            break;
+        case MeasurementConfig::Type::OBW:
+            result.value = analyzer.measureOBW(sweep, config.percentPower);
+            break;
+        case MeasurementConfig::Type::ACPR:
+            result.acpr = analyzer.measureACPR(sweep, config.channelBW, config.channelSpacing);
+            result.value = result.acpr.mainChannelPower;
+            break;
+        case MeasurementConfig::Type::Spurs:
+            result.spurs = analyzer.findSpurs(sweep.axis()->values(), sweep.amplitudes(), config.spurSearch);
+            result.value = result.spurs.size();
+            break;
+        }
+    }
+
+    // Görüntülenmeyen sweep'ler dahil her sonuç kayda geçer
+    QMutexLocker locker(&pimpl->logMutex);
+    if (!pimpl->log.isOpen())
+        return;
+
+    QTextStream& out = pimpl->logStream;
+    for (const MeasurementResult& result : pimpl->results) {
+        out << result.sweepIndex << ',' << result.timestamp << ',' << result.id << ','
+            << typeName(result.type) << ',';
+        // Spur sonucu sayıdır; sabit gösterimde "3.00" yazılmasın
+        if (result.type == MeasurementConfig::Type::Spurs) {
+            out << result.spurs.size() << ',';
+        } else {
+            out << result.value << ',';
+        }
+        if (result.type == MeasurementConfig::Type::ACPR) {
+            out << result.acpr.mainChannelPower << ',' << result.acpr.lowerChannelPower << ','
+                << result.acpr.upperChannelPower << ',' << result.acpr.lowerRatio << ','
+                << result.acpr.upperRatio << ',';
+        } else {
+            out << ",,,,,";
+        }
+        if (!result.spurs.isEmpty()) {
+            out << result.spurs.first().frequency << ',' << result.spurs.first().amplitude;
+        } else {
+            out << ',';
+        }
+        out << '\n';
+    }
+
+    if (out.status() != QTextStream::Ok) {
+        pimpl->log.close();
+        emit logError(tr("Ölçüm kaydı yazılamadı: %1").arg(pimpl->log.fileName()));
+    }
+}
+
+void MeasurementEngine::publish()
+{
+    bool notify = false;
+    {
+        QMutexLocker locker(&pimpl->resultMutex);
+
+        // Kayıt değişmiş olabilir; yalnızca hâlâ etkin ölçümler yayınlanır
+        if (pimpl->measurementCount.load() == 0 && pimpl->latest.isEmpty())
+            return;
+
+        pimpl->latest = pimpl->results;
+        pimpl->hasNewResults = true;
+
+        // GUI okuyana kadar tek bir bildirim yeterli
+        notify = !pimpl->notifyPending;
+        pimpl->notifyPending = true;
+    }
+
+    if (notify) {
+        emit resultsReady();
+    }
+}
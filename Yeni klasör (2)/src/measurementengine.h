@@ -0,0 +1,100 @@
+#ifndef MEASUREMENTENGINE_H
+#define MEASUREMENTENGINE_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QVector>
+#include <QString>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "analyzer.h"
+#include "sweep.h"
+
+// Sürekli ölçüm tanımı. Yalnızca türle ilgili alanlar kullanılır.
+struct MeasurementConfig {
+    enum class Type {
+        ChannelPower,
+        OBW,
+        ACPR,
+        Spurs
+    };
+
+    Type type{Type::ChannelPower};
+    double startFreq{0.0};        // Kanal gücü (Hz)
+    double stopFreq{0.0};         // Kanal gücü (Hz)
+    double percentPower{99.0};    // OBW (%)
+    double channelBW{1e6};        // ACPR (Hz)
+    double channelSpacing{2e6};   // ACPR (Hz)
+    PeakSearchSettings spurSearch;  // Spur
+};
+
+// Bir sweep üzerinde bir ölçümün sonucu
+struct MeasurementResult {
+    int id{0};
+    MeasurementConfig::Type type{MeasurementConfig::Type::ChannelPower};
+    quint64 sweepIndex{0};
+    qint64 timestamp{0};
+    double value{0.0};            // Kanal gücü (dBm) / OBW (Hz) / spur sayısı
+    ACPRResult acpr;
+    QVector<SpurResult> spurs;
+};
+
+// Kayıtlı ölçümleri gelen her sweep'te kendi thread'inde yeniden
+// hesaplayan motor. Sweep'ler acquisition thread'inden tutamaçla gelir
+// (kopya yok); aynı sweep üzerindeki ölçümler Analyzer'ın sweep başına
+// önbelleğini paylaşır. GUI'ye görüntüleme hızında yalnızca en son
+// sonuçlar verilir; her sweep'in sonuçları ise isteğe bağlı CSV kaydına
+// eksiksiz yazılır. Motor yetişemezse en eski sweep atılır ve sayılır.
+class MeasurementEngine : public QThread {
+    Q_OBJECT
+public:
+    explicit MeasurementEngine(QObject *parent = nullptr);
+    ~MeasurementEngine() override;
+
+    static constexpr int DEFAULT_QUEUE_CAPACITY = 16;
+
+    // Ölçüm yönetimi (herhangi bir thread'den)
+    int addMeasurement(const MeasurementConfig& config);
+    void removeMeasurement(int id);
+    void clearMeasurements();
+    bool hasMeasurements() const;
+
+    // Sonuçlar her sweep için bu dosyaya eklenir (boş: kayıt kapalı)
+    bool setLogFile(const QString& filename);
+    QString logFile() const;
+
+    // Acquisition thread'i (veya GUI) her yeni sweep'i buraya verir
+    void submit(const SweepPtr& sweep);
+
+    void stop();
+
+    // GUI tarafı: her ölçümün en son sonucu
+    bool takeResults(QVector<MeasurementResult>& results);
+
+    // Sayaçlar
+    quint64 sweepsEvaluated() const { return evaluated.load(std::memory_order_relaxed); }
+    quint64 sweepsDropped() const { return dropped.load(std::memory_order_relaxed); }
+
+signals:
+    // GUI sonuçları alana kadar tekrar yayınlanmaz
+    void resultsReady();
+    void logError(const QString& message);
+
+protected:
+    void run() override;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pimpl;
+
+    std::atomic<bool> stopRequested{false};
+    std::atomic<quint64> evaluated{0};
+    std::atomic<quint64> dropped{0};
+
+    void evaluate(const Sweep& sweep);
+    void publish();
+};
+
+#endif // MEASUREMENTENGINE_H
@@ -0,0 +1,55 @@
+#include "nco.h"
+#include <algorithm>
+#include <cmath>
+
+void Nco::setFrequency(double freq, double sampleRate)
+{
+    freqHz = freq;
+    phaseIncrement = sampleRate > 0.0 ? 2.0 * M_PI * freq / sampleRate : 0.0;
+}
+
+void Nco::mix(const std::complex<float>* in, std::complex<float>* out, int count)
+{
+    const float* src = reinterpret_cast<const float*>(in);
+    float* dst = reinterpret_cast<float*>(out);
+
+    for (int offset = 0; offset < count; offset += RESEED_INTERVAL) {
+        const int n = std::min(RESEED_INTERVAL, count - offset);
+
+        // Fazörler tam fazdan kurulur: lane k, faz + k * artış
+        float laneRe[LANES];
+        float laneIm[LANES];
+        for (int k = 0; k < LANES; ++k) {
+            const double p = phase + k * phaseIncrement;
+            laneRe[k] = static_cast<float>(std::cos(p));
+            laneIm[k] = static_cast<float>(std::sin(p));
+        }
+        const float rotRe = static_cast<float>(std::cos(LANES * phaseIncrement));
+        const float rotIm = static_cast<float>(std::sin(LANES * phaseIncrement));
+
+        const float* x = src + 2 * offset;
+        float* y = dst + 2 * offset;
+
+        int i = 0;
+        for (; i + LANES <= n; i += LANES) {
+            for (int k = 0; k < LANES; ++k) {
+                const float xr = x[2 * (i + k)];
+                const float xi = x[2 * (i + k) + 1];
+                y[2 * (i + k)] = xr * laneRe[k] - xi * laneIm[k];
+                y[2 * (i + k) + 1] = xr * laneIm[k] + xi * laneRe[k];
+
+                const float r = laneRe[k] * rotRe - laneIm[k] * rotIm;
+                laneIm[k] = laneRe[k] * rotIm + laneIm[k] * rotRe;
+                laneRe[k] = r;
+            }
+        }
+        for (int k = 0; i < n; ++i, ++k) {
+            const float xr = x[2 * i];
+            const float xi = x[2 * i + 1];
+            y[2 * i] = xr * laneRe[k] - xi * laneIm[k];
+            y[2 * i + 1] = xr * laneIm[k] + xi * laneRe[k];
+        }
+
+        phase = std::remainder(phase + n * phaseIncrement, 2.0 * M_PI);
+    }
+}
@@ -0,0 +1,32 @@
+#ifndef NCO_H
+#define NCO_H
+
+#include <complex>
+
+// Sayısal kontrollü osilatör (NCO) ve karıştırıcı. Faz çift hassasiyette
+// tutulur; örnek başına dönüş 8 paralel fazör ile yapılır ve fazörler
+// her RESEED_INTERVAL örnekte tam fazdan yeniden kurulur, böylece iç
+// döngü vektörleşir ve uzun sürede genlik/faz kayması birikmez.
+class Nco {
+public:
+    Nco() = default;
+
+    // freq Hz cinsinden, sampleRate'e göre; negatif frekans desteklenir
+    void setFrequency(double freq, double sampleRate);
+    void reset() { phase = 0.0; }
+
+    // out[i] = in[i] * exp(j * faz[i]); in == out olabilir
+    void mix(const std::complex<float>* in, std::complex<float>* out, int count);
+
+    double frequency() const { return freqHz; }
+
+private:
+    static constexpr int LANES = 8;
+    static constexpr int RESEED_INTERVAL = 4096;
+
+    double freqHz{0.0};
+    double phaseIncrement{0.0};  // radyan/örnek
+    double phase{0.0};           // [-pi, pi)
+};
+
+#endif // NCO_H
@@ -0,0 +1,146 @@
+#include "peakdetector.h"
+#include <algorithm>
+#include <cstdlib>
+
+const std::vector<Peak>& PeakDetector::find(const double* amplitudes, int count,
+                                            const PeakSearchSettings& settings)
+{
+    result.clear();
+    scan(amplitudes, count, settings);
+    selectPeaks(count, settings);
+    return result;
+}
+
+const std::vector<Peak>& PeakDetector::scan(const double* amplitudes, int count,
+                                            const PeakSearchSettings& settings)
+{
+    candidates.clear();
+    if (!amplitudes || count < 3)
+        return candidates;
+
+    if (settings.relativeToFloor) {
+        estimateNoiseFloor(amplitudes, count, settings.floorWindow);
+    }
+
+    // Tek geçiş: çukur -> tepe -> çukur. Tepe, ardından excursion kadar
+    // düşüş görülünce onaylanır; izin sonunda düşmeyen aday tepe sayılmaz.
+    const double excursion = std::max(settings.excursion, 0.0);
+    bool rising = true;
+    double valley = amplitudes[0];
+    double top = amplitudes[0];
+    int topIndex = 0;
+
+    for (int i = 1; i < count; ++i) {
+        const double a = amplitudes[i];
+        if (rising) {
+            if (a > top) {
+                top = a;
+                topIndex = i;
+            } else if (a < top - excursion && top > valley + excursion) {
+                if (top >= settings.threshold) {
+                    Peak peak{topIndex, top, 0.0};
+                    if (settings.relativeToFloor) {
+                        peak.noiseFloor = noiseFloorAt(topIndex);
+                    }
+                    if (!settings.relativeToFloor || top >= peak.noiseFloor + settings.floorOffset) {
+                        candidates.push_back(peak);
+                    }
+                }
+                rising = false;
+                valley = a;
+            } else if (a < valley) {
+                // Yeterli yükseliş olmadan yeni dip: tepe adayı sıfırlanır
+                valley = a;
+                top = a;
+                topIndex = i;
+            }
+        } else {
+            if (a < valley) {
+                valley = a;
+            } else if (a > valley + excursion) {
+                rising = true;
+                top = a;
+                topIndex = i;
+            }
+        }
+    }
+
+    return candidates;
+}
+
+void PeakDetector::estimateNoiseFloor(const double* amplitudes, int count, int window)
+{
+    floorBlock = std::clamp(window, 3, count);
+    const int blocks = (count + floorBlock - 1) / floorBlock;
+    blockMedians.resize(blocks);
+    medianScratch.resize(floorBlock);
+
+    for (int b = 0; b < blocks; ++b) {
+        const int begin = b * floorBlock;
+        const int size = std::min(floorBlock, count - begin);
+        std::copy(amplitudes + begin, amplitudes + begin + size, medianScratch.begin());
+        auto middle = medianScratch.begin() + size / 2;
+        std::nth_element(medianScratch.begin(), middle, medianScratch.begin() + size);
+        blockMedians[b] = *middle;
+    }
+}
+
+double PeakDetector::noiseFloorAt(int index) const
+{
+    // Blok merkezleri arasında doğrusal aradeğer; uçlarda sabit
+    const double position = (index + 0.5) / floorBlock - 0.5;
+    const int last = static_cast<int>(blockMedians.size()) - 1;
+    if (position <= 0.0 || last == 0)
+        return blockMedians.front();
+    if (position >= last)
+        return blockMedians.back();
+
+    const int b = static_cast<int>(position);
+    const double t = position - b;
+    return blockMedians[b] + t * (blockMedians[b + 1] - blockMedians[b]);
+}
+
+void PeakDetector::selectPeaks(int count, const PeakSearchSettings& settings)
+{
+    const int available = static_cast<int>(candidates.size());
+    const int limit = settings.maxPeaks > 0 ? std::min(settings.maxPeaks, available) : available;
+    if (limit == 0)
+        return;
+
+    if (settings.minDistance <= 1) {
+        // Eleme yok: yalnızca ilk K kısmi sıralanır
+        std::partial_sort(candidates.begin(), candidates.begin() + limit, candidates.end(),
+                          strongerPeak);
+        result.assign(candidates.begin(), candidates.begin() + limit);
+        return;
+    }
+
+    // Kova genişliği minDistance: aynı kovada iki kabul edilmiş tepe
+    // olamaz, |i - j| < minDistance olan tepe yalnızca komşu kovalardadır
+    const int width = settings.minDistance;
+    const int buckets = count / width + 1;
+    occupied.assign(buckets, -1);
+
+    auto tooClose = [&](int index) {
+        const int bucket = index / width;
+        for (int b = std::max(bucket - 1, 0); b <= std::min(bucket + 1, buckets - 1); ++b) {
+            if (occupied[b] >= 0 && std::abs(occupied[b] - index) < width)
+                return true;
+        }
+        return false;
+    };
+
+    // Yığın O(P) kurulur; adaylar yalnızca K tepe kabul edilene kadar çekilir
+    auto weaker = [](const Peak& a, const Peak& b) { return strongerPeak(b, a); };
+    std::make_heap(candidates.begin(), candidates.end(), weaker);
+    auto heapEnd = candidates.end();
+    while (heapEnd != candidates.begin() && static_cast<int>(result.size()) < limit) {
+        std::pop_heap(candidates.begin(), heapEnd, weaker);
+        --heapEnd;
+        const Peak& peak = *heapEnd;
+        if (!tooClose(peak.index)) {
+            occupied[peak.index / width] = peak.index;
+            result.push_back(peak);
+        }
+    }
+}
@@ -0,0 +1,68 @@
+#ifndef PEAKDETECTOR_H
+#define PEAKDETECTOR_H
+
+#include <vector>
+
+// Tepe arama ayarları. Genlikler dBm, mesafeler bin cinsindendir.
+struct PeakSearchSettings {
+    double threshold{-200.0};     // Mutlak eşik (dBm)
+    double excursion{0.0};        // Tepe iki yandaki çukurdan en az bu kadar yüksek olmalı (dB)
+    bool relativeToFloor{false};  // Eşiğe ek olarak gürültü tabanı + floorOffset aranır
+    double floorOffset{10.0};     // Gürültü tabanı üstü (dB)
+    int floorWindow{256};         // Gürültü tabanı medyan penceresi (bin)
+    int minDistance{1};           // Kabul edilen iki tepe arası en az mesafe (bin)
+    int maxPeaks{0};              // En güçlü K tepe (0: hepsi)
+};
+
+struct Peak {
+    int index{0};                 // Bin indeksi
+    double amplitude{0.0};        // dBm
+    double noiseFloor{0.0};       // Tahmini gürültü tabanı (relativeToFloor kapalıysa 0)
+};
+
+// Tepe sırası: güçlü tepe önce, eşitlikte düşük indeks önce. PeakDetector
+// ve PeakIndex aynı sırayı kullanır.
+inline bool strongerPeak(const Peak& a, const Peak& b)
+{
+    if (a.amplitude != b.amplitude)
+        return a.amplitude > b.amplitude;
+    return a.index < b.index;
+}
+
+// Trace üzerinde tek geçişli tepe bulucu:
+//  - Tepeler histerezisle bulunur: iz bir önceki çukurdan excursion kadar
+//    yükselip ardından excursion kadar düştüğünde en yüksek nokta tepedir
+//    (excursion 0 ise her yerel maksimum).
+//  - Gürültü tabanı floorWindow'luk blokların medyanlarıyla (nth_element,
+//    toplam O(N)) tahmin edilir ve blok merkezleri arasında aradeğerlenir.
+//  - Yakın tepeler güçlüden zayıfa elenir; kabul edilen tepeler minDistance
+//    genişliğinde konum kovalarında tutulur, komşu denetimi O(1)'dir.
+//  - Adaylar yığına alınır ve yalnızca K tepe kabul edilene kadar çekilir.
+// Tamponlar çağrılar arasında korunur; aynı boyutta tekrar bellek ayırmaz.
+class PeakDetector {
+public:
+    // Sonuç genliğe göre azalan sıradadır (eşitlikte düşük indeks önce)
+    const std::vector<Peak>& find(const double* amplitudes, int count,
+                                  const PeakSearchSettings& settings);
+
+    const std::vector<Peak>& peaks() const { return result; }
+
+    // Yalnızca tek geçiş: eşikleri geçen tüm tepeler indeks sırasında
+    // (minDistance ve maxPeaks uygulanmaz)
+    const std::vector<Peak>& scan(const double* amplitudes, int count,
+                                  const PeakSearchSettings& settings);
+
+private:
+    std::vector<Peak> candidates;
+    std::vector<Peak> result;
+    std::vector<double> blockMedians;
+    std::vector<double> medianScratch;
+    std::vector<int> occupied;
+    int floorBlock{0};
+
+    void estimateNoiseFloor(const double* amplitudes, int count, int window);
+    double noiseFloorAt(int index) const;
+    void selectPeaks(int count, const PeakSearchSettings& settings);
+};
+
+#endif // PEAKDETECTOR_H
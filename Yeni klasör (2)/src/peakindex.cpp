@@ -0,0 +1,75 @@
+#include "peakindex.h"
+#include <algorithm>
+#include <iterator>
+
+namespace {
+
+bool lowerIndex(const Peak& peak, int bin) { return peak.index < bin; }
+
+} // namespace
+
+void PeakIndex::build(const double* amplitudes, int count, double excursion)
+{
+    clear();
+    if (!amplitudes || count <= 0)
+        return;
+
+    binCount = count;
+    maxBin = 0;
+    minBin = 0;
+    for (int i = 1; i < count; ++i) {
+        if (amplitudes[i] > amplitudes[maxBin]) maxBin = i;
+        if (amplitudes[i] < amplitudes[minBin]) minBin = i;
+    }
+
+    PeakSearchSettings settings;
+    settings.excursion = excursion;
+    const std::vector<Peak>& peaks = detector.scan(amplitudes, count, settings);
+    byIndex.assign(peaks.begin(), peaks.end());
+}
+
+void PeakIndex::clear()
+{
+    byIndex.clear();
+    byAmplitude.clear();
+    amplitudeSorted = false;
+    binCount = 0;
+    maxBin = -1;
+    minBin = -1;
+}
+
+int PeakIndex::nextLower(int bin, double amplitude)
+{
+    if (!amplitudeSorted) {
+        byAmplitude.assign(byIndex.begin(), byIndex.end());
+        std::sort(byAmplitude.begin(), byAmplitude.end(), strongerPeak);
+        amplitudeSorted = true;
+    }
+
+    // Sıralamada (amplitude, bin) anahtarından sonra gelen ilk tepe; eşit
+    // genlikli tepeler indeks sırasıyla gezilir
+    const Peak key{bin, amplitude, 0.0};
+    auto it = std::upper_bound(byAmplitude.begin(), byAmplitude.end(), key, strongerPeak);
+    return it != byAmplitude.end() ? it->index : -1;
+}
+
+int PeakIndex::nextLeft(int bin) const
+{
+    auto it = std::lower_bound(byIndex.begin(), byIndex.end(), bin, lowerIndex);
+    return it != byIndex.begin() ? std::prev(it)->index : -1;
+}
+
+int PeakIndex::nextRight(int bin) const
+{
+    auto it = std::lower_bound(byIndex.begin(), byIndex.end(), bin + 1, lowerIndex);
+    return it != byIndex.end() ? it->index : -1;
+}
+
+int PeakIndex::nearest(int bin) const
+{
+    const int left = nextLeft(bin + 1);  // bin'in kendisi de olabilir
+    const int right = nextRight(bin);
+    if (left < 0) return right;
+    if (right < 0) return left;
+    return bin - left <= right - bin ? left : right;
+}
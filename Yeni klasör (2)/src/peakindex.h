@@ -0,0 +1,43 @@
+#ifndef PEAKINDEX_H
+#define PEAKINDEX_H
+
+#include <vector>
+#include "peakdetector.h"
+
+// Sweep başına bir kez kurulan tepe dizini. Marker gezinmesi (en yüksek,
+// sonraki tepe, soldaki/sağdaki tepe, en düşük nokta) trace'i yeniden
+// taramadan yapılır:
+//  - Kurulum O(N): tepeler indeks sırasında bulunur, global maksimum ve
+//    minimum aynı anda kaydedilir.
+//  - Sol/sağ/en yakın tepe indeks sırasındaki dizide ikili arama, O(log P).
+//  - Genlik sırası yalnızca ilk "sonraki tepe" sorgusunda sıralanır;
+//    sonraki sorgular ikili arama, O(log P).
+// Tüm sorgular bin indeksi alır ve döndürür; bulunamazsa -1.
+class PeakIndex {
+public:
+    void build(const double* amplitudes, int count, double excursion = 0.0);
+    void clear();
+
+    bool isEmpty() const { return binCount == 0; }
+    int peakCount() const { return static_cast<int>(byIndex.size()); }
+
+    int maximum() const { return maxBin; }
+    int minimum() const { return minBin; }
+
+    // Genliği verilen bin'inkinden düşük olan en yüksek tepe
+    int nextLower(int bin, double amplitude);
+    int nextLeft(int bin) const;
+    int nextRight(int bin) const;
+    int nearest(int bin) const;
+
+private:
+    PeakDetector detector;
+    std::vector<Peak> byIndex;
+    std::vector<Peak> byAmplitude;
+    bool amplitudeSorted{false};
+    int binCount{0};
+    int maxBin{-1};
+    int minBin{-1};
+};
+
+#endif // PEAKINDEX_H
@@ -0,0 +1,358 @@
+#include "powerkernels.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+#include <immintrin.h>
+#define POWERKERNELS_AVX2 1
+#endif
+
+namespace {
+
+constexpr double LOG2_10_OVER_10 = 0.33219280948873623479;  // log2(10) / 10
+constexpr double LN2 = 0.69314718055994530942;
+constexpr double TEN_OVER_LN10 = 4.34294481903251827651;    // 10 / ln(10)
+constexpr double SQRT2 = 1.41421356237309504880;
+constexpr double MIN_EXPONENT = -1022.0;
+constexpr double MAX_EXPONENT = 1023.0;
+constexpr double MIN_NORMAL = 2.2250738585072014e-308;
+
+constexpr std::uint64_t MANTISSA_MASK = 0x000FFFFFFFFFFFFFull;
+constexpr std::uint64_t ONE_BITS = 0x3FF0000000000000ull;
+
+// Float sürümleri için sınırlar
+constexpr float MIN_EXPONENT_F = -126.0f;
+constexpr float MAX_EXPONENT_F = 127.0f;
+constexpr float MIN_NORMAL_F = 1.17549435e-38f;
+constexpr std::uint32_t MANTISSA_MASK_F = 0x007FFFFFu;
+constexpr std::uint32_t ONE_BITS_F = 0x3F800000u;
+
+// 2^f = e^g, g = f*ln2 in [-0.347, 0.347]; Taylor katsayıları
+constexpr double EXP_C2 = 1.0 / 2;
+constexpr double EXP_C3 = 1.0 / 6;
+constexpr double EXP_C4 = 1.0 / 24;
+constexpr double EXP_C5 = 1.0 / 120;
+constexpr double EXP_C6 = 1.0 / 720;
+constexpr double EXP_C7 = 1.0 / 5040;
+
+// ln m = 2*atanh(s), s = (m-1)/(m+1), |s| <= 0.1716
+constexpr double LOG_C3 = 1.0 / 3;
+constexpr double LOG_C5 = 1.0 / 5;
+constexpr double LOG_C7 = 1.0 / 7;
+constexpr double LOG_C9 = 1.0 / 9;
+
+inline double bitsToDouble(std::uint64_t bits)
+{
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+inline std::uint64_t doubleToBits(double value)
+{
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline double expPolynomial(double g)
+{
+    double p = EXP_C7;
+    p = p * g + EXP_C6;
+    p = p * g + EXP_C5;
+    p = p * g + EXP_C4;
+    p = p * g + EXP_C3;
+    p = p * g + EXP_C2;
+    p = p * g + 1.0;
+    return p * g + 1.0;
+}
+
+inline double logPolynomial(double s)
+{
+    const double s2 = s * s;
+    double p = LOG_C9;
+    p = p * s2 + LOG_C7;
+    p = p * s2 + LOG_C5;
+    p = p * s2 + LOG_C3;
+    p = p * s2 + 1.0;
+    return 2.0 * s * p;
+}
+
+inline double scalarDbToLinear(double db)
+{
+    const double t = std::clamp(db * LOG2_10_OVER_10, MIN_EXPONENT, MAX_EXPONENT);
+    const double n = static_cast<double>(static_cast<std::int64_t>(t + (t < 0.0 ? -0.5 : 0.5)));
+    const double scale = bitsToDouble(static_cast<std::uint64_t>(static_cast<std::int64_t>(n) + 1023) << 52);
+    return expPolynomial((t - n) * LN2) * scale;
+}
+
+inline double scalarLinearToDb(double linear)
+{
+    // NaN karşılaştırması false döner; NaN da MIN_NORMAL'a düşer
+    const double v = linear > MIN_NORMAL ? linear : MIN_NORMAL;
+    const std::uint64_t bits = doubleToBits(v);
+    double e = static_cast<double>(static_cast<std::int64_t>(bits >> 52) - 1023);
+    double m = bitsToDouble((bits & MANTISSA_MASK) | ONE_BITS);
+    if (m > SQRT2) {
+        m *= 0.5;
+        e += 1.0;
+    }
+    return (e * LN2 + logPolynomial((m - 1.0) / (m + 1.0))) * TEN_OVER_LN10;
+}
+
+inline float expPolynomialF(float g)
+{
+    float p = static_cast<float>(EXP_C6);
+    p = p * g + static_cast<float>(EXP_C5);
+    p = p * g + static_cast<float>(EXP_C4);
+    p = p * g + static_cast<float>(EXP_C3);
+    p = p * g + static_cast<float>(EXP_C2);
+    p = p * g + 1.0f;
+    return p * g + 1.0f;
+}
+
+inline float logPolynomialF(float s)
+{
+    const float s2 = s * s;
+    float p = static_cast<float>(LOG_C7);
+    p = p * s2 + static_cast<float>(LOG_C5);
+    p = p * s2 + static_cast<float>(LOG_C3);
+    p = p * s2 + 1.0f;
+    return 2.0f * s * p;
+}
+
+inline float scalarDbToLinearF(float db)
+{
+    const float t = std::clamp(db * static_cast<float>(LOG2_10_OVER_10), MIN_EXPONENT_F, MAX_EXPONENT_F);
+    const float n = static_cast<float>(static_cast<std::int32_t>(t + (t < 0.0f ? -0.5f : 0.5f)));
+    const std::uint32_t scaleBits = static_cast<std::uint32_t>(static_cast<std::int32_t>(n) + 127) << 23;
+    float scale;
+    std::memcpy(&scale, &scaleBits, sizeof(scale));
+    return expPolynomialF((t - n) * static_cast<float>(LN2)) * scale;
+}
+
+inline float scalarLinearToDbF(float linear)
+{
+    const float v = linear > MIN_NORMAL_F ? linear : MIN_NORMAL_F;
+    std::uint32_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    float e = static_cast<float>(static_cast<std::int32_t>(bits >> 23) - 127);
+    const std::uint32_t mantissaBits = (bits & MANTISSA_MASK_F) | ONE_BITS_F;
+    float m;
+    std::memcpy(&m, &mantissaBits, sizeof(m));
+    if (m > static_cast<float>(SQRT2)) {
+        m *= 0.5f;
+        e += 1.0f;
+    }
+    return (e * static_cast<float>(LN2) + logPolynomialF((m - 1.0f) / (m + 1.0f)))
+        * static_cast<float>(TEN_OVER_LN10);
+}
+
+#if defined(POWERKERNELS_AVX2)
+
+inline __m256d avxDbToLinear(__m256d db)
+{
+    const __m256d t = _mm256_min_pd(_mm256_max_pd(_mm256_mul_pd(db, _mm256_set1_pd(LOG2_10_OVER_10)),
+                                                  _mm256_set1_pd(MIN_EXPONENT)),
+                                    _mm256_set1_pd(MAX_EXPONENT));
+    const __m256d n = _mm256_round_pd(t, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    const __m256d g = _mm256_mul_pd(_mm256_sub_pd(t, n), _mm256_set1_pd(LN2));
+
+    __m256d p = _mm256_set1_pd(EXP_C7);
+    p = _mm256_fmadd_pd(p, g, _mm256_set1_pd(EXP_C6));
+    p = _mm256_fmadd_pd(p, g, _mm256_set1_pd(EXP_C5));
+    p = _mm256_fmadd_pd(p, g, _mm256_set1_pd(EXP_C4));
+    p = _mm256_fmadd_pd(p, g, _mm256_set1_pd(EXP_C3));
+    p = _mm256_fmadd_pd(p, g, _mm256_set1_pd(EXP_C2));
+    p = _mm256_fmadd_pd(p, g, _mm256_set1_pd(1.0));
+    p = _mm256_fmadd_pd(p, g, _mm256_set1_pd(1.0));
+
+    // n tamsayısı 1.5*2^52 eklenerek mantisin alt bitlerine taşınır
+    const __m256d magic = _mm256_set1_pd(6755399441055744.0);
+    const __m256i ni = _mm256_sub_epi64(_mm256_castpd_si256(_mm256_add_pd(n, magic)),
+                                        _mm256_castpd_si256(magic));
+    const __m256i scale = _mm256_slli_epi64(_mm256_add_epi64(ni, _mm256_set1_epi64x(1023)), 52);
+    return _mm256_mul_pd(p, _mm256_castsi256_pd(scale));
+}
+
+inline __m256d avxLinearToDb(__m256d linear)
+{
+    // max_pd ikinci işleneni NaN'da döndürür: NaN da MIN_NORMAL'a düşer
+    const __m256i bits = _mm256_castpd_si256(_mm256_max_pd(linear, _mm256_set1_pd(MIN_NORMAL)));
+
+    // Yanlı üs 2^52 tabanlı double'a gömülerek dönüştürülür
+    const __m256d twoTo52 = _mm256_set1_pd(4503599627370496.0);
+    const __m256i biased = _mm256_or_si256(_mm256_srli_epi64(bits, 52), _mm256_castpd_si256(twoTo52));
+    __m256d e = _mm256_sub_pd(_mm256_castsi256_pd(biased), _mm256_set1_pd(4503599627370496.0 + 1023.0));
+
+    __m256d m = _mm256_castsi256_pd(_mm256_or_si256(
+        _mm256_and_si256(bits, _mm256_set1_epi64x(static_cast<long long>(MANTISSA_MASK))),
+        _mm256_set1_epi64x(static_cast<long long>(ONE_BITS))));
+    const __m256d big = _mm256_cmp_pd(m, _mm256_set1_pd(SQRT2), _CMP_GT_OQ);
+    m = _mm256_blendv_pd(m, _mm256_mul_pd(m, _mm256_set1_pd(0.5)), big);
+    e = _mm256_add_pd(e, _mm256_and_pd(big, _mm256_set1_pd(1.0)));
+
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d s = _mm256_div_pd(_mm256_sub_pd(m, one), _mm256_add_pd(m, one));
+    const __m256d s2 = _mm256_mul_pd(s, s);
+    __m256d p = _mm256_set1_pd(LOG_C9);
+    p = _mm256_fmadd_pd(p, s2, _mm256_set1_pd(LOG_C7));
+    p = _mm256_fmadd_pd(p, s2, _mm256_set1_pd(LOG_C5));
+    p = _mm256_fmadd_pd(p, s2, _mm256_set1_pd(LOG_C3));
+    p = _mm256_fmadd_pd(p, s2, one);
+    const __m256d lnm = _mm256_mul_pd(_mm256_add_pd(s, s), p);
+
+    return _mm256_mul_pd(_mm256_fmadd_pd(e, _mm256_set1_pd(LN2), lnm), _mm256_set1_pd(TEN_OVER_LN10));
+}
+
+inline __m256 avxDbToLinearF(__m256 db)
+{
+    const __m256 t = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(db, _mm256_set1_ps(static_cast<float>(LOG2_10_OVER_10))),
+                                                 _mm256_set1_ps(MIN_EXPONENT_F)),
+                                   _mm256_set1_ps(MAX_EXPONENT_F));
+    const __m256 n = _mm256_round_ps(t, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    const __m256 g = _mm256_mul_ps(_mm256_sub_ps(t, n), _mm256_set1_ps(static_cast<float>(LN2)));
+
+    __m256 p = _mm256_set1_ps(static_cast<float>(EXP_C6));
+    p = _mm256_fmadd_ps(p, g, _mm256_set1_ps(static_cast<float>(EXP_C5)));
+    p = _mm256_fmadd_ps(p, g, _mm256_set1_ps(static_cast<float>(EXP_C4)));
+    p = _mm256_fmadd_ps(p, g, _mm256_set1_ps(static_cast<float>(EXP_C3)));
+    p = _mm256_fmadd_ps(p, g, _mm256_set1_ps(static_cast<float>(EXP_C2)));
+    p = _mm256_fmadd_ps(p, g, _mm256_set1_ps(1.0f));
+    p = _mm256_fmadd_ps(p, g, _mm256_set1_ps(1.0f));
+
+    const __m256i scale = _mm256_slli_epi32(_mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127)), 23);
+    return _mm256_mul_ps(p, _mm256_castsi256_ps(scale));
+}
+
+inline __m256 avxLinearToDbF(__m256 linear)
+{
+    const __m256i bits = _mm256_castps_si256(_mm256_max_ps(linear, _mm256_set1_ps(MIN_NORMAL_F)));
+    __m256 e = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(127)));
+    __m256 m = _mm256_castsi256_ps(_mm256_or_si256(
+        _mm256_and_si256(bits, _mm256_set1_epi32(static_cast<int>(MANTISSA_MASK_F))),
+        _mm256_set1_epi32(static_cast<int>(ONE_BITS_F))));
+    const __m256 big = _mm256_cmp_ps(m, _mm256_set1_ps(static_cast<float>(SQRT2)), _CMP_GT_OQ);
+    m = _mm256_blendv_ps(m, _mm256_mul_ps(m, _mm256_set1_ps(0.5f)), big);
+    e = _mm256_add_ps(e, _mm256_and_ps(big, _mm256_set1_ps(1.0f)));
+
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 s = _mm256_div_ps(_mm256_sub_ps(m, one), _mm256_add_ps(m, one));
+    const __m256 s2 = _mm256_mul_ps(s, s);
+    __m256 p = _mm256_set1_ps(static_cast<float>(LOG_C7));
+    p = _mm256_fmadd_ps(p, s2, _mm256_set1_ps(static_cast<float>(LOG_C5)));
+    p = _mm256_fmadd_ps(p, s2, _mm256_set1_ps(static_cast<float>(LOG_C3)));
+    p = _mm256_fmadd_ps(p, s2, one);
+    const __m256 lnm = _mm256_mul_ps(_mm256_add_ps(s, s), p);
+
+    return _mm256_mul_ps(_mm256_fmadd_ps(e, _mm256_set1_ps(static_cast<float>(LN2)), lnm),
+                         _mm256_set1_ps(static_cast<float>(TEN_OVER_LN10)));
+}
+
+#endif
+
+} // namespace
+
+void PowerKernels::dbToLinear(const double* db, double* linear, int count)
+{
+    int i = 0;
+#if defined(POWERKERNELS_AVX2)
+    for (; i + 4 <= count; i += 4) {
+        _mm256_storeu_pd(linear + i, avxDbToLinear(_mm256_loadu_pd(db + i)));
+    }
+#endif
+    for (; i < count; ++i) {
+        linear[i] = scalarDbToLinear(db[i]);
+    }
+}
+
+void PowerKernels::linearToDb(const double* linear, double* db, int count)
+{
+    int i = 0;
+#if defined(POWERKERNELS_AVX2)
+    for (; i + 4 <= count; i += 4) {
+        _mm256_storeu_pd(db + i, avxLinearToDb(_mm256_loadu_pd(linear + i)));
+    }
+#endif
+    for (; i < count; ++i) {
+        db[i] = scalarLinearToDb(linear[i]);
+    }
+}
+
+void PowerKernels::dbToLinear(const float* db, float* linear, int count)
+{
+    int i = 0;
+#if defined(POWERKERNELS_AVX2)
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(linear + i, avxDbToLinearF(_mm256_loadu_ps(db + i)));
+    }
+#endif
+    for (; i < count; ++i) {
+        linear[i] = scalarDbToLinearF(db[i]);
+    }
+}
+
+void PowerKernels::linearToDb(const float* linear, float* db, int count)
+{
+    int i = 0;
+#if defined(POWERKERNELS_AVX2)
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(db + i, avxLinearToDbF(_mm256_loadu_ps(linear + i)));
+    }
+#endif
+    for (; i < count; ++i) {
+        db[i] = scalarLinearToDbF(linear[i]);
+    }
+}
+
+double PowerKernels::dbToLinear(double db)
+{
+    return scalarDbToLinear(db);
+}
+
+double PowerKernels::linearToDb(double linear)
+{
+    return scalarLinearToDb(linear);
+}
+
+double PowerKernels::sum(const double* values, int count)
+{
+    int i = 0;
+#if defined(POWERKERNELS_AVX2)
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    for (; i + 8 <= count; i += 8) {
+        acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(values + i));
+        acc1 = _mm256_add_pd(acc1, _mm256_loadu_pd(values + i + 4));
+    }
+    double acc[4];
+    _mm256_storeu_pd(acc, _mm256_add_pd(acc0, acc1));
+#else
+    // Lane'ler bağımsız olduğundan derleyici döngüyü vektörleştirebilir
+    double acc[4] = {0.0, 0.0, 0.0, 0.0};
+    for (; i + 4 <= count; i += 4) {
+        for (int k = 0; k < 4; ++k) {
+            acc[k] += values[i + k];
+        }
+    }
+#endif
+    double total = (acc[0] + acc[1]) + (acc[2] + acc[3]);
+    for (; i < count; ++i) {
+        total += values[i];
+    }
+    return total;
+}
+
+void PowerKernels::dbToPrefixSum(const double* db, double* prefix, int count)
+{
+    prefix[0] = 0.0;
+    dbToLinear(db, prefix + 1, count);
+
+    // Toplama sıralıdır; mW değerleri negatif olmadığından önekler monoton
+    double running = 0.0;
+    for (int i = 1; i <= count; ++i) {
+        running += prefix[i];
+        prefix[i] = running;
+    }
+}
@@ -0,0 +1,39 @@
+#ifndef POWERKERNELS_H
+#define POWERKERNELS_H
+
+// dBm <-> mW dönüşümü ve toplama çekirdekleri. std::pow/log10 yerine
+// üs/mantis ayrıştırması ve polinom yaklaşımı kullanılır:
+//   10^(x/10) = 2^n * 2^f,  |f| <= 0.5, 2^f 7. derece Taylor (bağıl hata < 6e-9)
+//   log10(v)  = (e*ln2 + ln m) / ln10,  m in [0.707, 1.414), atanh serisi
+// Her iki yönde hata MAX_ERROR_DB'nin altındadır (0.01 dB'den kat kat
+// küçük). AVX2/FMA ile derlenince 4 double birlikte işlenir.
+// Sınırlar: dB girişi [-3076, 3079] aralığına sıkıştırılır; sıfır, negatif
+// ve NaN doğrusal değerler en küçük normal double'ın dB karşılığını verir.
+class PowerKernels {
+public:
+    static constexpr double MAX_ERROR_DB = 1e-6;
+
+    // linear[i] = 10^(db[i]/10); yerinde çağrılabilir (db == linear)
+    static void dbToLinear(const double* db, double* linear, int count);
+    // db[i] = 10*log10(linear[i]); yerinde çağrılabilir
+    static void linearToDb(const double* linear, double* db, int count);
+
+    static double dbToLinear(double db);
+    static double linearToDb(double linear);
+
+    // Float sürümleri (AVX2 ile 8'li). Aynı yöntem, daha kısa polinomlar;
+    // hata float çözünürlüğü düzeyindedir (1e-4 dB altı). dB girişi
+    // [-379, 382] aralığına sıkıştırılır.
+    static void dbToLinear(const float* db, float* linear, int count);
+    static void linearToDb(const float* linear, float* db, int count);
+
+    // Dört ayrı akümülatörle toplam; sıralı toplamdan yalnızca yuvarlama
+    // kadar farklıdır
+    static double sum(const double* values, int count);
+
+    // prefix[0] = 0, prefix[i+1] = prefix[i] + 10^(db[i]/10); prefix
+    // count + 1 eleman olmalı. Aralık gücü: prefix[b+1] - prefix[a]
+    static void dbToPrefixSum(const double* db, double* prefix, int count);
+};
+
+#endif // POWERKERNELS_H
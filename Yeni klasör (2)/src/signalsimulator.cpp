@@ -0,0 +1,466 @@
+#include "signalsimulator.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#if defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+#include <immintrin.h>
+#define SIGNALSIMULATOR_AVX2 1
+#endif
+
+namespace {
+
+// Blok boyutu: çalışma tamponları (5 x 4 KB) L1'de kalır; fazörler her
+// blokta yeniden kurulur
+constexpr int BLOCK = 1024;
+constexpr int LANES = 8;
+
+// Irwin-Hall: dört U[0, 65535] toplamının ortalaması ve standart sapması
+constexpr float UNIFORM_SUM_MEAN = 131070.0f;
+constexpr float UNIFORM_SUM_SIGMA = 37837.23f;  // 65536 * sqrt(4 / 12)
+
+// RNG akışları: aynı örnek indeksi her akışta farklı sayı verir
+constexpr std::uint32_t STREAM_NOISE = 0x6a09e667u;
+constexpr std::uint32_t STREAM_PHASE = 0xbb67ae85u;
+constexpr std::uint32_t STREAM_SYMBOL = 0x3c6ef372u;
+
+// NCO tablosu: kaba (üst 10 bit) ve ince (sonraki 10 bit) faz
+constexpr int NCO_BITS = 10;
+constexpr int NCO_SIZE = 1 << NCO_BITS;
+
+constexpr double TWO_PI = 6.28318530717958647692;
+constexpr double TWO_POW_32 = 4294967296.0;
+
+// Sayaç tabanlı RNG: durumsuz 32 bit karıştırıcı (lowbias32)
+inline std::uint32_t hash32(std::uint32_t x)
+{
+    x ^= x >> 16;
+    x *= 0x7feb352du;
+    x ^= x >> 15;
+    x *= 0x846ca68bu;
+    x ^= x >> 16;
+    return x;
+}
+
+inline float uniformSum(std::uint32_t a, std::uint32_t b)
+{
+    return static_cast<float>((a & 0xffffu) + (a >> 16) + (b & 0xffffu) + (b >> 16));
+}
+
+// 2^28 örnekte bir değişen akış anahtarı; sayaç (indeks * 4 + k) bu
+// aralıkta tekildir
+inline std::uint32_t streamKey(std::uint32_t seed, std::uint32_t stream, quint64 index)
+{
+    return hash32(seed ^ stream ^ hash32(static_cast<std::uint32_t>(index >> 28)));
+}
+
+#if defined(SIGNALSIMULATOR_AVX2)
+inline __m256i hash32(__m256i x)
+{
+    x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 16));
+    x = _mm256_mullo_epi32(x, _mm256_set1_epi32(0x7feb352d));
+    x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 15));
+    x = _mm256_mullo_epi32(x, _mm256_set1_epi32(static_cast<int>(0x846ca68bu)));
+    x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 16));
+    return x;
+}
+
+inline __m256 uniformSum(__m256i a, __m256i b)
+{
+    const __m256i mask = _mm256_set1_epi32(0xffff);
+    const __m256i sum = _mm256_add_epi32(
+        _mm256_add_epi32(_mm256_and_si256(a, mask), _mm256_srli_epi32(a, 16)),
+        _mm256_add_epi32(_mm256_and_si256(b, mask), _mm256_srli_epi32(b, 16)));
+    return _mm256_cvtepi32_ps(sum);
+}
+#endif
+
+// (re, im) += amplitude * env * exp(j * (phase + i * increment)); env
+// null ise 1, envIm null ise gerçel. Fazörler LANES paralel zincirde
+// döner; dönüş çift hassasiyetli fazdan kurulduğu için blok içinde
+// biriken hata float yuvarlaması düzeyindedir.
+void accumulateCarrier(float* re, float* im, const float* envRe, const float* envIm,
+                       float amplitude, double phase, double increment, int n)
+{
+    alignas(32) float laneRe[LANES];
+    alignas(32) float laneIm[LANES];
+    for (int k = 0; k < LANES; ++k) {
+        const double p = phase + k * increment;
+        laneRe[k] = amplitude * static_cast<float>(std::cos(p));
+        laneIm[k] = amplitude * static_cast<float>(std::sin(p));
+    }
+    const float rotRe = static_cast<float>(std::cos(LANES * increment));
+    const float rotIm = static_cast<float>(std::sin(LANES * increment));
+
+    int i = 0;
+#if defined(SIGNALSIMULATOR_AVX2)
+    __m256 pr = _mm256_load_ps(laneRe);
+    __m256 pi = _mm256_load_ps(laneIm);
+    const __m256 wr = _mm256_set1_ps(rotRe);
+    const __m256 wi = _mm256_set1_ps(rotIm);
+    for (; i + LANES <= n; i += LANES) {
+        __m256 cr = pr;
+        __m256 ci = pi;
+        if (envRe && envIm) {
+            const __m256 er = _mm256_loadu_ps(envRe + i);
+            const __m256 ei = _mm256_loadu_ps(envIm + i);
+            cr = _mm256_fmsub_ps(pr, er, _mm256_mul_ps(pi, ei));
+            ci = _mm256_fmadd_ps(pr, ei, _mm256_mul_ps(pi, er));
+        } else if (envRe) {
+            const __m256 er = _mm256_loadu_ps(envRe + i);
+            cr = _mm256_mul_ps(pr, er);
+            ci = _mm256_mul_ps(pi, er);
+        }
+        _mm256_storeu_ps(re + i, _mm256_add_ps(_mm256_loadu_ps(re + i), cr));
+        _mm256_storeu_ps(im + i, _mm256_add_ps(_mm256_loadu_ps(im + i), ci));
+
+        const __m256 r = _mm256_fmsub_ps(pr, wr, _mm256_mul_ps(pi, wi));
+        pi = _mm256_fmadd_ps(pr, wi, _mm256_mul_ps(pi, wr));
+        pr = r;
+    }
+    _mm256_store_ps(laneRe, pr);
+    _mm256_store_ps(laneIm, pi);
+#else
+    for (; i + LANES <= n; i += LANES) {
+        for (int k = 0; k < LANES; ++k) {
+            float cr = laneRe[k];
+            float ci = laneIm[k];
+            if (envRe && envIm) {
+                cr = laneRe[k] * envRe[i + k] - laneIm[k] * envIm[i + k];
+                ci = laneRe[k] * envIm[i + k] + laneIm[k] * envRe[i + k];
+            } else if (envRe) {
+                cr *= envRe[i + k];
+                ci *= envRe[i + k];
+            }
+            re[i + k] += cr;
+            im[i + k] += ci;
+
+            const float r = laneRe[k] * rotRe - laneIm[k] * rotIm;
+            laneIm[k] = laneRe[k] * rotIm + laneIm[k] * rotRe;
+            laneRe[k] = r;
+        }
+    }
+#endif
+    for (int k = 0; i < n; ++i, ++k) {
+        float cr = laneRe[k];
+        float ci = laneIm[k];
+        if (envRe && envIm) {
+            cr = laneRe[k] * envRe[i] - laneIm[k] * envIm[i];
+            ci = laneRe[k] * envIm[i] + laneIm[k] * envRe[i];
+        } else if (envRe) {
+            cr *= envRe[i];
+            ci *= envRe[i];
+        }
+        re[i] += cr;
+        im[i] += ci;
+    }
+}
+
+// Sayaç indeksinden Gauss yaklaşımı: out[i] = sigma * g(index + i)
+void gaussian(float* out, float sigma, std::uint32_t key, quint64 index, int n)
+{
+    const float scale = sigma / UNIFORM_SUM_SIGMA;
+    const std::uint32_t base = static_cast<std::uint32_t>(index) * 2u;
+    int i = 0;
+#if defined(SIGNALSIMULATOR_AVX2)
+    const __m256i k = _mm256_set1_epi32(static_cast<int>(key));
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256 mean = _mm256_set1_ps(UNIFORM_SUM_MEAN);
+    const __m256 s = _mm256_set1_ps(scale);
+    __m256i c = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(base)),
+                                 _mm256_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14));
+    const __m256i step = _mm256_set1_epi32(2 * LANES);
+    for (; i + LANES <= n; i += LANES) {
+        const __m256i a = hash32(_mm256_xor_si256(c, k));
+        const __m256i b = hash32(_mm256_xor_si256(_mm256_add_epi32(c, one), k));
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_sub_ps(uniformSum(a, b), mean), s));
+        c = _mm256_add_epi32(c, step);
+    }
+#endif
+    for (; i < n; ++i) {
+        const std::uint32_t c = base + 2u * static_cast<std::uint32_t>(i);
+        out[i] = (uniformSum(hash32(c ^ key), hash32((c + 1u) ^ key)) - UNIFORM_SUM_MEAN) * scale;
+    }
+}
+
+// out[i] = (re[i] + sigma * gI, im[i] + sigma * gQ), aralıklı karmaşık
+void addNoiseInterleave(const float* re, const float* im, float sigma, std::uint32_t key,
+                        quint64 index, std::complex<float>* out, int n)
+{
+    float* dst = reinterpret_cast<float*>(out);
+    const float scale = sigma / UNIFORM_SUM_SIGMA;
+    const std::uint32_t base = static_cast<std::uint32_t>(index) * 4u;
+    int i = 0;
+#if defined(SIGNALSIMULATOR_AVX2)
+    const __m256i k = _mm256_set1_epi32(static_cast<int>(key));
+    const __m256 mean = _mm256_set1_ps(UNIFORM_SUM_MEAN);
+    const __m256 s = _mm256_set1_ps(scale);
+    __m256i c = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(base)),
+                                 _mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28));
+    const __m256i step = _mm256_set1_epi32(4 * LANES);
+    const __m256i c1 = _mm256_set1_epi32(1);
+    const __m256i c2 = _mm256_set1_epi32(2);
+    const __m256i c3 = _mm256_set1_epi32(3);
+    for (; i + LANES <= n; i += LANES) {
+        const __m256 gi = _mm256_sub_ps(uniformSum(hash32(_mm256_xor_si256(c, k)),
+                                                   hash32(_mm256_xor_si256(_mm256_add_epi32(c, c1), k))), mean);
+        const __m256 gq = _mm256_sub_ps(uniformSum(hash32(_mm256_xor_si256(_mm256_add_epi32(c, c2), k)),
+                                                   hash32(_mm256_xor_si256(_mm256_add_epi32(c, c3), k))), mean);
+        const __m256 vr = _mm256_fmadd_ps(gi, s, _mm256_loadu_ps(re + i));
+        const __m256 vi = _mm256_fmadd_ps(gq, s, _mm256_loadu_ps(im + i));
+
+        // (r0..r7, i0..i7) -> r0 i0 r1 i1 ...
+        const __m256 lo = _mm256_unpacklo_ps(vr, vi);
+        const __m256 hi = _mm256_unpackhi_ps(vr, vi);
+        _mm256_storeu_ps(dst + 2 * i, _mm256_permute2f128_ps(lo, hi, 0x20));
+        _mm256_storeu_ps(dst + 2 * i + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+        c = _mm256_add_epi32(c, step);
+    }
+#endif
+    for (; i < n; ++i) {
+        const std::uint32_t c = base + 4u * static_cast<std::uint32_t>(i);
+        const float gi = uniformSum(hash32(c ^ key), hash32((c + 1u) ^ key)) - UNIFORM_SUM_MEAN;
+        const float gq = uniformSum(hash32((c + 2u) ^ key), hash32((c + 3u) ^ key)) - UNIFORM_SUM_MEAN;
+        dst[2 * i] = re[i] + gi * scale;
+        dst[2 * i + 1] = im[i] + gq * scale;
+    }
+}
+
+// (re, im) *= exp(j * theta) ~ (1 - theta^2 / 2) + j * theta; |theta| << 1
+void applySmallPhase(float* re, float* im, const float* theta, int n)
+{
+    int i = 0;
+#if defined(SIGNALSIMULATOR_AVX2)
+    const __m256 half = _mm256_set1_ps(-0.5f);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    for (; i + LANES <= n; i += LANES) {
+        const __m256 t = _mm256_loadu_ps(theta + i);
+        const __m256 c = _mm256_fmadd_ps(_mm256_mul_ps(t, t), half, one);
+        const __m256 r = _mm256_loadu_ps(re + i);
+        const __m256 q = _mm256_loadu_ps(im + i);
+        _mm256_storeu_ps(re + i, _mm256_fnmadd_ps(q, t, _mm256_mul_ps(r, c)));
+        _mm256_storeu_ps(im + i, _mm256_fmadd_ps(r, t, _mm256_mul_ps(q, c)));
+    }
+#endif
+    for (; i < n; ++i) {
+        const float t = theta[i];
+        const float c = 1.0f - 0.5f * t * t;
+        const float r = re[i];
+        re[i] = r * c - im[i] * t;
+        im[i] = r * t + im[i] * c;
+    }
+}
+
+} // namespace
+
+SimulatorScene SimulatorScene::defaultScene()
+{
+    using Type = SimulatedSignal::Type;
+    SimulatorScene scene;
+    scene.sources = {
+        {Type::FM, 98.0e6, -45.0, 1e3, 75e3},          // FM yayını
+        {Type::AM, 1.0e9, -20.0, 10e3, 0.5},           // Varsayılan merkezde AM
+        {Type::Tone, 433.92e6, -60.0, 0.0, 0.0},       // ISM telemetri
+        {Type::QPSK, 935.2e6, -50.0, 270.833e3, 0.0},  // GSM benzeri
+        {Type::QPSK, 1842.6e6, -65.0, 3.84e6, 0.0},    // Geniş bantlı taşıyıcı
+        {Type::Tone, 2437.0e6, -40.0, 0.0, 0.0},
+        {Type::QPSK, 5180.0e6, -70.0, 10e6, 0.0},
+        {Type::Spur, 7.5e6, -95.0, 0.0, 0.0},          // LO'ya bağlı iç spurlar
+        {Type::Spur, -12.25e6, -100.0, 0.0, 0.0},
+    };
+    return scene;
+}
+
+// PIMPL implementation
+struct SignalSimulator::Impl {
+    struct SignalState {
+        double carrierPhase{0.0};     // Taban bantta (rad)
+        double modulationPhase{0.0};  // AM/FM modülasyon tonu (rad)
+        std::uint32_t fmPhase{0};     // FM taşıyıcı fazı (tur * 2^32)
+        quint64 symbolClock{0};       // QPSK: sembol * 2^32
+    };
+
+    SimulatorScene scene;
+    std::vector<SignalState> states;
+    quint64 sample{0};
+    float theta{0.0f};                // Faz gürültüsü durumu (rad)
+
+    // Blok tamponları
+    std::vector<float> re = std::vector<float>(BLOCK);
+    std::vector<float> im = std::vector<float>(BLOCK);
+    std::vector<float> envRe = std::vector<float>(BLOCK);
+    std::vector<float> envIm = std::vector<float>(BLOCK);
+    std::vector<float> scratch = std::vector<float>(BLOCK);
+
+    // İki seviyeli NCO tablosu: exp(j2pi(c/2^10 + f/2^20)) = coarse[c] * fine[f]
+    std::vector<std::complex<float>> coarse;
+    std::vector<std::complex<float>> fine;
+
+    Impl()
+        : scene(SimulatorScene::defaultScene())
+        , states(scene.sources.size())
+        , coarse(NCO_SIZE)
+        , fine(NCO_SIZE)
+    {
+        for (int k = 0; k < NCO_SIZE; ++k) {
+            coarse[k] = std::polar(1.0f, static_cast<float>(TWO_PI * k / NCO_SIZE));
+            fine[k] = std::polar(1.0f, static_cast<float>(TWO_PI * k / (double(NCO_SIZE) * NCO_SIZE)));
+        }
+    }
+
+    void addSignal(const SimulatedSignal& signal, SignalState& state,
+                   double centerFreq, double sampleRate, int n)
+    {
+        const double offset = signal.type == SimulatedSignal::Type::Spur
+            ? signal.frequency : signal.frequency - centerFreq;
+        if (std::abs(offset) >= sampleRate / 2)
+            return;
+
+        const float amplitude = static_cast<float>(std::sqrt(std::pow(10.0, signal.power / 10.0)));
+        const double increment = TWO_PI * offset / sampleRate;
+        const double modIncrement = TWO_PI * signal.rate / sampleRate;
+
+        switch (signal.type) {
+        case SimulatedSignal::Type::Tone:
+        case SimulatedSignal::Type::Spur:
+            accumulateCarrier(re.data(), im.data(), nullptr, nullptr,
+                              amplitude, state.carrierPhase, increment, n);
+            break;
+
+        case SimulatedSignal::Type::AM: {
+            // Zarf 1 + m cos(wm n); sinüs kısmı kullanılmaz
+            std::fill(envRe.begin(), envRe.begin() + n, 1.0f);
+            accumulateCarrier(envRe.data(), scratch.data(), nullptr, nullptr,
+                              static_cast<float>(signal.depth), state.modulationPhase, modIncrement, n);
+            accumulateCarrier(re.data(), im.data(), envRe.data(), nullptr,
+                              amplitude, state.carrierPhase, increment, n);
+            state.modulationPhase = std::remainder(state.modulationPhase + n * modIncrement, TWO_PI);
+            break;
+        }
+
+        case SimulatedSignal::Type::FM: {
+            // Anlık frekans offset + sapma * cos(wm n); faz tamsayı
+            // akümülatörde, sin/cos tablodan
+            std::fill(envRe.begin(), envRe.begin() + n, 0.0f);
+            accumulateCarrier(envRe.data(), scratch.data(), nullptr, nullptr,
+                              1.0f, state.modulationPhase, modIncrement, n);
+            const std::uint32_t carrierStep = static_cast<std::uint32_t>(
+                static_cast<std::int64_t>(std::llround(offset / sampleRate * TWO_POW_32)));
+            const float deviationStep = static_cast<float>(signal.depth / sampleRate * TWO_POW_32);
+            std::uint32_t phase = state.fmPhase;
+            for (int i = 0; i < n; ++i) {
+                phase += carrierStep + static_cast<std::uint32_t>(
+                    static_cast<std::int32_t>(deviationStep * envRe[i]));
+                const std::complex<float> v = coarse[phase >> (32 - NCO_BITS)]
+                    * fine[(phase >> (32 - 2 * NCO_BITS)) & (NCO_SIZE - 1)];
+                re[i] += amplitude * v.real();
+                im[i] += amplitude * v.imag();
+            }
+            state.fmPhase = phase;
+            state.modulationPhase = std::remainder(state.modulationPhase + n * modIncrement, TWO_PI);
+            return;
+        }
+
+        case SimulatedSignal::Type::QPSK: {
+            // Semboller sayaç tabanlı RNG'den; sembol sınırına kadar sabit
+            constexpr float s = 0.70710678f;
+            const quint64 step = static_cast<quint64>(signal.rate / sampleRate * TWO_POW_32);
+            const std::uint32_t key = hash32(scene.seed ^ STREAM_SYMBOL
+                                             ^ static_cast<std::uint32_t>(static_cast<quint64>(signal.frequency)));
+            quint64 clock = state.symbolClock;
+            for (int i = 0; i < n;) {
+                const std::uint32_t bits = hash32(static_cast<std::uint32_t>(clock >> 32) ^ key);
+                const float vr = (bits & 1u) ? s : -s;
+                const float vi = (bits & 2u) ? s : -s;
+                // Bu sembolde kalan örnek sayısı
+                const quint64 fraction = TWO_POW_32 - (clock & 0xffffffffull);
+                const quint64 run = step ? (fraction + step - 1) / step : static_cast<quint64>(n);
+                const int end = static_cast<int>(std::min<quint64>(n, i + run));
+                std::fill(envRe.begin() + i, envRe.begin() + end, vr);
+                std::fill(envIm.begin() + i, envIm.begin() + end, vi);
+                clock += step * static_cast<quint64>(end - i);
+                i = end;
+            }
+            state.symbolClock = clock;
+            accumulateCarrier(re.data(), im.data(), envRe.data(), envIm.data(),
+                              amplitude, state.carrierPhase, increment, n);
+            break;
+        }
+        }
+
+        state.carrierPhase = std::remainder(state.carrierPhase + n * increment, TWO_PI);
+    }
+
+    // Ornstein-Uhlenbeck faz: theta[n] = a theta[n-1] + sigma g[n]. Köşenin
+    // üstünde S(f) = sigma^2 fs / (2 pi)^2 / (fc^2 + f^2), L(f) ~ S(f)
+    void applyPhaseNoise(double sampleRate, int n)
+    {
+        const double fc = scene.phaseNoiseCorner;
+        const double fo = scene.phaseNoiseOffset;
+        const double level = std::pow(10.0, scene.phaseNoise / 10.0);
+        const float sigma = static_cast<float>(std::sqrt(level * TWO_PI * TWO_PI * (fc * fc + fo * fo) / sampleRate));
+        const float a = static_cast<float>(1.0 - TWO_PI * fc / sampleRate);
+
+        gaussian(scratch.data(), sigma, streamKey(scene.seed, STREAM_PHASE, sample), sample, n);
+        float t = theta;
+        for (int i = 0; i < n; ++i) {
+            t = a * t + scratch[i];
+            scratch[i] = t;
+        }
+        theta = t;
+        applySmallPhase(re.data(), im.data(), scratch.data(), n);
+    }
+};
+
+SignalSimulator::SignalSimulator()
+    : pimpl(std::make_unique<Impl>())
+{
+}
+
+SignalSimulator::~SignalSimulator() = default;
+
+void SignalSimulator::setScene(const SimulatorScene& scene)
+{
+    pimpl->scene = scene;
+    pimpl->states.assign(scene.sources.size(), Impl::SignalState());
+    pimpl->theta = 0.0f;
+}
+
+const SimulatorScene& SignalSimulator::scene() const
+{
+    return pimpl->scene;
+}
+
+quint64 SignalSimulator::sampleCount() const
+{
+    return pimpl->sample;
+}
+
+void SignalSimulator::generate(double centerFreq, double sampleRate,
+                               std::complex<float>* out, int count)
+{
+    if (!out || count <= 0 || sampleRate <= 0.0)
+        return;
+
+    Impl& d = *pimpl;
+    const float noiseSigma = static_cast<float>(
+        std::sqrt(std::pow(10.0, d.scene.noiseDensity / 10.0) * sampleRate / 2.0));
+
+    for (int offset = 0; offset < count; offset += BLOCK) {
+        const int n = std::min(BLOCK, count - offset);
+
+        std::fill(d.re.begin(), d.re.begin() + n, 0.0f);
+        std::fill(d.im.begin(), d.im.begin() + n, 0.0f);
+        for (size_t s = 0; s < d.scene.sources.size(); ++s) {
+            d.addSignal(d.scene.sources[s], d.states[s], centerFreq, sampleRate, n);
+        }
+        if (d.scene.phaseNoiseEnabled) {
+            d.applyPhaseNoise(sampleRate, n);
+        }
+
+        addNoiseInterleave(d.re.data(), d.im.data(), noiseSigma,
+                           streamKey(d.scene.seed, STREAM_NOISE, d.sample), d.sample,
+                           out + offset, n);
+        d.sample += n;
+    }
+}
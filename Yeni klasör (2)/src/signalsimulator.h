@@ -0,0 +1,79 @@
+#ifndef SIGNALSIMULATOR_H
+#define SIGNALSIMULATOR_H
+
+#include <QtGlobal>
+#include <complex>
+#include <memory>
+#include <vector>
+
+// Simüle edilen bir sinyal. Güçler dBm; frekanslar mutlak (Spur hariç).
+struct SimulatedSignal {
+    enum class Type {
+        Tone,   // Sürekli dalga
+        AM,     // Tek tonla genlik modülasyonu
+        FM,     // Tek tonla frekans modülasyonu
+        QPSK,   // Rastgele semboller, dikdörtgen darbe
+        Spur    // Cihaz içi: LO'ya göre sabit ofsette ton
+    };
+
+    Type type{Type::Tone};
+    double frequency{1e9};   // Taşıyıcı (Hz); Spur için LO ofseti
+    double power{-30.0};     // Ortalama güç (dBm); AM için taşıyıcı gücü
+    double rate{1e3};        // AM/FM modülasyon tonu ya da QPSK sembol hızı (Hz)
+    double depth{0.5};       // AM: modülasyon indeksi (0..1); FM: tepe sapma (Hz)
+};
+
+// Simülatör sahnesi
+struct SimulatorScene {
+    double noiseDensity{-150.0};     // Termal gürültü (dBm/Hz)
+    // LO faz gürültüsü: phaseNoiseOffset'te dBc/Hz; köşe frekansının
+    // altında düz, üstünde 1/f^2 (Ornstein-Uhlenbeck faz). Tüm sinyallere
+    // ve spurlara uygulanır, termal gürültüye uygulanmaz.
+    double phaseNoise{-95.0};
+    double phaseNoiseOffset{10e3};
+    double phaseNoiseCorner{1e3};
+    bool phaseNoiseEnabled{true};
+    quint32 seed{0x5eed1234u};
+    std::vector<SimulatedSignal> sources;
+
+    // Geniş span'de görünen yayın/hücresel/ISM taşıyıcıları ve birkaç spur
+    static SimulatorScene defaultScene();
+};
+
+// Sahneyi LO'ya göre karmaşık taban bant IQ'su (sqrt(mW)) olarak üretir.
+// Tek çekirdekte 40 MS/s'in üstünde çalışacak şekilde düzenlenmiştir:
+//  - Gürültü sayaç tabanlı RNG'den gelir (örnek indeksinin 32 bit hash'i,
+//    durum yok): dört 16 bitlik düzgün değişkenin toplamı (Irwin-Hall)
+//    Gauss yaklaşımıdır. AVX2 ile 8 örnek birlikte üretilir.
+//  - Ton, AM, QPSK ve spurlar Nco'daki gibi 8 paralel fazörle taşınır;
+//    fazörler her blokta çift hassasiyetli fazdan yeniden kurulur.
+//  - FM fazı 32 bitlik tamsayı akümülatörde tutulur; sin/cos iki seviyeli
+//    NCO tablosundan (1024 x 1024, faz çözünürlüğü 2^-20 tur) okunur.
+//  - Faz gürültüsü sinyal toplamına küçük açı yaklaşımıyla uygulanır.
+// Zaman süreklidir: ardışık generate() çağrıları kesintisiz akış verir;
+// LO değişince taşıyıcı fazları sıçrar (gerçek yeniden ayardaki gibi).
+// Tek thread içindir.
+class SignalSimulator {
+public:
+    SignalSimulator();
+    ~SignalSimulator();
+
+    SignalSimulator(const SignalSimulator&) = delete;
+    SignalSimulator& operator=(const SignalSimulator&) = delete;
+
+    void setScene(const SimulatorScene& scene);
+    const SimulatorScene& scene() const;
+
+    // count örnek; centerFreq LO, sampleRate örnekleme hızı (Hz)
+    void generate(double centerFreq, double sampleRate,
+                  std::complex<float>* out, int count);
+
+    // Başlangıçtan beri üretilen örnek sayısı
+    quint64 sampleCount() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pimpl;
+};
+
+#endif // SIGNALSIMULATOR_H
@@ -0,0 +1,61 @@
+#include "sweep.h"
+#include <algorithm>
+#include <atomic>
+
+namespace {
+
+std::atomic<quint64> nextSweepId{1};
+
+} // namespace
+
+void Sweep::prepare(quint64 index, qint64 timestamp,
+                    const FrequencyAxisPtr& axis, const BBSettings& settings)
+{
+    sequence = index;
+    sweepId = nextSweepId.fetch_add(1, std::memory_order_relaxed);
+    captureTime = timestamp;
+    frequencyAxis = axis;
+    settingsSnapshot = settings;
+    amps.resize(axis ? axis->size() : 0);
+}
+
+SweepPtr Sweep::fromTrace(const FrequencyAxisPtr& axis,
+                          const QVector<double>& amplitudes)
+{
+    auto sweep = std::make_shared<Sweep>();
+    sweep->sweepId = nextSweepId.fetch_add(1, std::memory_order_relaxed);
+    sweep->frequencyAxis = axis;
+    sweep->amps = amplitudes;
+    return sweep;
+}
+
+SweepPool::SweepPool(int maxPooled)
+    : maxPooled(std::max(maxPooled, 1))
+{
+    sweeps.reserve(this->maxPooled);
+}
+
+std::shared_ptr<Sweep> SweepPool::acquire()
+{
+    for (const auto& sweep : sweeps) {
+        // Tek sahip havuzsa başka referans kalmamıştır ve yeni referans
+        // ancak buradan verilebilir. Son tüketicinin okumaları, tampon
+        // yeniden yazılmadan önce tamamlanmış olmalı.
+        if (sweep.use_count() == 1) {
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return sweep;
+        }
+    }
+
+    auto sweep = std::make_shared<Sweep>();
+    if (pooled() < maxPooled) {
+        sweeps.push_back(sweep);
+    }
+    return sweep;
+}
+
+int SweepPool::inUse() const
+{
+    return static_cast<int>(std::count_if(sweeps.begin(), sweeps.end(),
+        [](const std::shared_ptr<Sweep>& sweep) { return sweep.use_count() > 1; }));
+}
@@ -0,0 +1,73 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include <QVector>
+#include <memory>
+#include <vector>
+#include "bb_api.h"
+#include "frequencyaxis.h"
+
+class Sweep;
+using SweepPtr = std::shared_ptr<const Sweep>;
+
+// Cihaz katmanının bir kez ürettiği değişmez sweep. Plot, waterfall,
+// marker'lar, ölçümler ve kayıt aynı nesneyi SweepPtr ile paylaşır;
+// genlikler hiçbir aşamada kopyalanmaz. Tüketiciler amplitudes()'ı
+// referansla kullanmalı: QVector kopyası tutmak, havuz sweep'i yeniden
+// doldurduğunda ayrışmaya (ve bellek ayırmaya) yol açar.
+class Sweep {
+public:
+    quint64 index() const { return sequence; }           // 1'den başlar
+    // Süreç içinde tekil; havuz sweep'i her yeniden doldurduğunda değişir.
+    // Sweep'e bağlı önbellekler (örn. Analyzer'ın mW dizisi) bununla
+    // geçersizlenir.
+    quint64 id() const { return sweepId; }
+    qint64 timestamp() const { return captureTime; }      // ms, epoch
+    const FrequencyAxisPtr& axis() const { return frequencyAxis; }
+    const BBSettings& settings() const { return settingsSnapshot; }
+    const QVector<double>& amplitudes() const { return amps; }
+    int size() const { return amps.size(); }
+
+    // Üretici tarafı: yalnızca SweepPool::acquire ile alınmış, henüz
+    // paylaşılmamış sweep üzerinde çağrılır. Genlik tamponu eksen
+    // boyutuna getirilir; kapasite yetiyorsa bellek ayrılmaz.
+    void prepare(quint64 index, qint64 timestamp,
+                 const FrequencyAxisPtr& axis, const BBSettings& settings);
+    double* amplitudeData() { return amps.data(); }
+
+    // Havuz dışı sweep (örn. dosyadan yüklenen trace)
+    static SweepPtr fromTrace(const FrequencyAxisPtr& axis,
+                              const QVector<double>& amplitudes);
+
+private:
+    quint64 sequence{0};
+    quint64 sweepId{0};
+    qint64 captureTime{0};
+    FrequencyAxisPtr frequencyAxis;
+    BBSettings settingsSnapshot;
+    QVector<double> amps;
+};
+
+// Sweep nesnelerini geri dönüştüren havuz. Tüm tüketiciler bir sweep'i
+// bıraktığında (kullanım sayısı yalnızca havuza düştüğünde) sweep tampon
+// ve kontrol bloğuyla birlikte yeniden kullanılır; kararlı durumda
+// acquire() bellek ayırmaz. Tek üretici içindir.
+class SweepPool {
+public:
+    static constexpr int DEFAULT_MAX_POOLED = 32;
+
+    explicit SweepPool(int maxPooled = DEFAULT_MAX_POOLED);
+
+    // Boşta sweep yoksa yenisi oluşturulur; havuz sınırı aşıldıysa
+    // yeni sweep havuza alınmaz ve bırakıldığında serbest kalır
+    std::shared_ptr<Sweep> acquire();
+
+    int pooled() const { return static_cast<int>(sweeps.size()); }
+    int inUse() const;
+
+private:
+    int maxPooled;
+    std::vector<std::shared_ptr<Sweep>> sweeps;
+};
+
+#endif // SWEEP_H
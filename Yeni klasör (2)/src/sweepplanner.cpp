@@ -0,0 +1,72 @@
+#include "sweepplanner.h"
+#include <algorithm>
+#include <cmath>
+
+double SweepPlanner::equivalentNoiseBandwidth(WindowType window)
+{
+    switch (window) {
+    case WindowType::Rectangular:
+        return 1.0;
+    case WindowType::Hann:
+        return 1.5;
+    case WindowType::Blackman:
+        return 1.7268;
+    case WindowType::FlatTop:
+        return 3.7702;
+    }
+    return 1.0;
+}
+
+SweepPlan SweepPlanner::plan(double startFreq, double stopFreq, double rbw, const Config& config)
+{
+    SweepPlan plan;
+    if (config.sampleRate <= 0.0 || rbw <= 0.0 || stopFreq < startFreq)
+        return plan;
+
+    const double enbw = equivalentNoiseBandwidth(config.window);
+    const int minSize = std::max(FftEngine::floorPowerOfTwo(config.minFftSize), 2);
+    const int maxSize = std::max(FftEngine::floorPowerOfTwo(config.maxFftSize), minSize);
+    // Çıkış bin sayısı sınırı aşılacaksa RBW istenenden geniş kalır
+    const double span = stopFreq - startFreq;
+    int n = minSize;
+    while (n < maxSize && enbw * config.sampleRate / n > rbw
+           && span * (2.0 * n) / config.sampleRate + 1.0 <= config.maxOutputBins) {
+        n <<= 1;
+    }
+
+    plan.startFreq = startFreq;
+    plan.sampleRate = config.sampleRate;
+    plan.window = config.window;
+    plan.fftSize = n;
+    plan.binWidth = config.sampleRate / n;
+    plan.rbw = enbw * plan.binWidth;
+
+    // Tutulan bant IF bant genişliğiyle ve FFT'nin kendisiyle sınırlı
+    const double usable = std::min(config.ifBandwidth, config.sampleRate);
+    plan.keptBins = std::clamp(static_cast<int>(usable / plan.binWidth), 1, n);
+    plan.firstKeptBin = (n - plan.keptBins) / 2;
+    plan.outputBins = static_cast<int>(std::floor(span / plan.binWidth + 0.5)) + 1;
+    // Tek segmentte LO span'in ortasına gelir: tutulan bant çıkış kadar
+    if (plan.outputBins <= plan.keptBins) {
+        plan.keptBins = plan.outputBins;
+        plan.firstKeptBin = (n - plan.keptBins) / 2;
+    }
+
+    // Merkezlenmiş FFT'de i. bin'in frekansı LO + (i - n/2) * binWidth;
+    // k. segmentin firstKeptBin'i çıkışın k * keptBins'ine denk gelir
+    const int count = (plan.outputBins + plan.keptBins - 1) / plan.keptBins;
+    plan.segments.resize(count);
+    for (int k = 0; k < count; ++k) {
+        SweepSegment& segment = plan.segments[k];
+        segment.outputBin = k * plan.keptBins;
+        segment.binCount = std::min(plan.keptBins, plan.outputBins - segment.outputBin);
+        segment.centerFreq = startFreq
+            + (segment.outputBin - plan.firstKeptBin + n / 2) * plan.binWidth;
+    }
+
+    plan.segmentAcquireTime = config.retuneTime + n / config.sampleRate;
+    plan.segmentProcessTime = config.fftCost * n * std::log2(static_cast<double>(n));
+    plan.sweepTime = plan.segmentAcquireTime + plan.segmentProcessTime
+        + (count - 1) * std::max(plan.segmentAcquireTime, plan.segmentProcessTime);
+    return plan;
+}
@@ -0,0 +1,69 @@
+#ifndef SWEEPPLANNER_H
+#define SWEEPPLANNER_H
+
+#include <vector>
+#include "fftengine.h"
+
+// Geniş sweep'in bir LO adımı. Segmentin tutulan bin'leri çıkış trace'inde
+// [outputBin, outputBin + binCount) aralığına yazılır.
+struct SweepSegment {
+    double centerFreq{0.0};   // LO (Hz)
+    int outputBin{0};
+    int binCount{0};
+};
+
+// Bir span/RBW yapılandırmasının segment planı ve süre tahmini. Tüm
+// segmentler aynı FFT boyutunu kullanır; çıkış ızgarası
+// startFreq + i * binWidth'tir.
+struct SweepPlan {
+    double startFreq{0.0};
+    double binWidth{0.0};         // fs / fftSize (Hz)
+    double rbw{0.0};              // Gerçekleşen RBW: ENBW * binWidth (Hz)
+    double sampleRate{0.0};
+    WindowType window{WindowType::FlatTop};
+    int fftSize{0};
+    int firstKeptBin{0};          // Merkezlenmiş FFT sırasında ilk tutulan bin
+    int keptBins{0};              // Segment başına tutulan bin (son segment daha az olabilir)
+    int outputBins{0};
+    std::vector<SweepSegment> segments;
+
+    // Süre tahmini (s)
+    double segmentAcquireTime{0.0};   // Yeniden ayar + oturma + yakalama
+    double segmentProcessTime{0.0};   // Pencere + FFT + dB + yerleştirme
+    double sweepTime{0.0};            // Boru hattıyla tüm sweep
+
+    bool isValid() const { return outputBins > 0 && !segments.empty(); }
+    int segmentCount() const { return static_cast<int>(segments.size()); }
+    double stopFreq() const { return startFreq + (outputBins - 1) * binWidth; }
+};
+
+// Anlık IF bant genişliğinden geniş span'i LO adımlarına böler:
+//  - FFT boyutu istenen RBW'ye göre seçilir: ENBW * fs / N <= RBW olan en
+//    küçük ikinin kuvveti; çıkış maxOutputBins'i aşacaksa daha küçüğü.
+//  - Her segmentte yalnızca ortadaki ifBandwidth'lik bin'ler tutulur;
+//    kenarlar (anti-alias filtresinin geçiş bandı) atılır. Segmentlerin
+//    ham FFT kapsamları bu kenarlar kadar örtüşür.
+//  - LO'lar, tutulan bin'ler ortak çıkış ızgarasına tam oturacak şekilde
+//    seçilir; birleştirmede enterpolasyon ve çift sayım olmaz.
+//  - Yakalama (yeniden ayar + IQ) ile işleme boru hattında örtüşür:
+//    sweepTime = acquire + process + (segment - 1) * max(acquire, process)
+class SweepPlanner {
+public:
+    struct Config {
+        double sampleRate{40e6};
+        double ifBandwidth{27e6};        // Segment başına kullanılan bant
+        WindowType window{WindowType::FlatTop};  // Bin arası tonlarda genlik doğruluğu
+        double retuneTime{250e-6};       // LO yeniden ayar + oturma (s)
+        double fftCost{1.2e-9};          // İşleme süresi: fftCost * N * log2(N) (s)
+        int minFftSize{64};
+        int maxFftSize{1 << 16};
+        int maxOutputBins{1 << 20};      // Sweep belleği sınırı
+    };
+
+    static SweepPlan plan(double startFreq, double stopFreq, double rbw, const Config& config);
+
+    // Pencerenin eşdeğer gürültü bant genişliği (bin)
+    static double equivalentNoiseBandwidth(WindowType window);
+};
+
+#endif // SWEEPPLANNER_H
@@ -0,0 +1,213 @@
+#include "sweepstitcher.h"
+#include "powerkernels.h"
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+#include <QWaitCondition>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+// PIMPL implementation
+struct SweepStitcher::Impl {
+    // Yakalama döngüsünü çalıştıran kalıcı thread
+    struct CaptureThread : public QThread {
+        Impl* impl{nullptr};
+        void run() override { impl->captureLoop(); }
+    };
+
+    bool pipelined{true};
+    double lastTime{0.0};
+
+    // İşleme tarafı (çağıran thread)
+    FftEngine fft;
+    std::vector<std::complex<float>> work;
+    double powerScale{1.0};       // 1 / (sum w)^2: bin merkezindeki ton gücü korunur
+    int preparedSize{0};
+    WindowType preparedWindow{WindowType::Rectangular};
+
+    // Yakalama ile paylaşılan durum; mutex altında
+    QMutex mutex;
+    QWaitCondition changed;
+    CaptureThread thread;
+    bool threadStarted{false};
+    bool quit{false};
+    const SweepPlan* plan{nullptr};
+    const SegmentSource* source{nullptr};
+    std::vector<std::complex<float>> buffers[2];
+    int counts[2]{0, 0};
+    int nextCapture{0};   // Yakalanacak sıradaki segment
+    int captured{0};      // Tamponu dolu segment sayısı
+    int released{0};      // Tamponu yakalamaya geri verilmiş segment sayısı
+
+    void captureLoop()
+    {
+        QMutexLocker locker(&mutex);
+        while (!quit) {
+            // İki tampon: segment k, k-2 bırakılmadan yazılamaz
+            if (!plan || nextCapture >= plan->segmentCount() || nextCapture - released >= 2) {
+                changed.wait(&mutex);
+                continue;
+            }
+
+            const int k = nextCapture++;
+            const int slot = k & 1;
+            const double centerFreq = plan->segments[k].centerFreq;
+            const int size = plan->fftSize;
+            std::complex<float>* iq = buffers[slot].data();
+            const SegmentSource& fetch = *source;
+
+            locker.unlock();
+            const int count = fetch(centerFreq, iq, size);
+            locker.relock();
+
+            counts[slot] = count;
+            captured = k + 1;
+            changed.wakeAll();
+        }
+    }
+
+    void prepare(const SweepPlan& p)
+    {
+        const int n = p.fftSize;
+        if (n == preparedSize && p.window == preparedWindow)
+            return;
+
+        fft.prepare(n, p.window);
+        const std::vector<float>& window = fft.window(p.window, n);
+        double coherent = 0.0;
+        for (float w : window) {
+            coherent += w;
+        }
+        powerScale = coherent > 0.0 ? 1.0 / (coherent * coherent) : 1.0;
+        work.resize(n);
+        for (auto& buffer : buffers) {
+            buffer.resize(n);
+        }
+        preparedSize = n;
+        preparedWindow = p.window;
+    }
+
+    // Ham IQ'yu pencereleyip çalışma tamponuna alır; eksik örnekler sıfır
+    void load(const SweepPlan& p, const std::complex<float>* iq, int count)
+    {
+        const int n = p.fftSize;
+        const float* window = fft.window(p.window, n).data();
+        const int valid = std::clamp(count, 0, n);
+        for (int i = 0; i < valid; ++i) {
+            work[i] = iq[i] * window[i];
+        }
+        std::fill(work.begin() + valid, work.end(), std::complex<float>());
+    }
+
+    // FFT, güç ve dB; tutulan bin'ler çıkıştaki yerlerine yazılır
+    void place(const SweepPlan& p, const SweepSegment& segment, double* output)
+    {
+        const int n = p.fftSize;
+        fft.forward(work.data(), n);
+
+        // Merkezlenmiş i. bin ham FFT'de (i + n/2) mod n'dedir
+        double* out = output + segment.outputBin;
+        const int first = p.firstKeptBin + n / 2;
+        for (int m = 0; m < segment.binCount; ++m) {
+            const std::complex<float> x = work[(first + m) & (n - 1)];
+            out[m] = (static_cast<double>(x.real()) * x.real()
+                      + static_cast<double>(x.imag()) * x.imag()) * powerScale;
+        }
+        PowerKernels::linearToDb(out, out, segment.binCount);
+    }
+};
+
+SweepStitcher::SweepStitcher()
+    : pimpl(std::make_unique<Impl>())
+{
+    pimpl->thread.impl = pimpl.get();
+}
+
+SweepStitcher::~SweepStitcher()
+{
+    {
+        QMutexLocker locker(&pimpl->mutex);
+        pimpl->quit = true;
+        pimpl->changed.wakeAll();
+    }
+    if (pimpl->threadStarted) {
+        pimpl->thread.wait();
+    }
+}
+
+void SweepStitcher::setPipelined(bool enabled)
+{
+    pimpl->pipelined = enabled;
+}
+
+bool SweepStitcher::isPipelined() const
+{
+    return pimpl->pipelined;
+}
+
+bool SweepStitcher::run(const SweepPlan& plan, const SegmentSource& source, double* output)
+{
+    if (!plan.isValid() || !source || !output || !FftEngine::isPowerOfTwo(plan.fftSize))
+        return false;
+
+    const auto start = std::chrono::steady_clock::now();
+    Impl& d = *pimpl;
+    const int count = plan.segmentCount();
+
+    // Yakalama thread'i bu noktada boştadır; tamponlar güvenle boyutlanır
+    d.prepare(plan);
+
+    if (!d.pipelined || count == 1) {
+        std::complex<float>* iq = d.buffers[0].data();
+        for (const SweepSegment& segment : plan.segments) {
+            d.load(plan, iq, source(segment.centerFreq, iq, plan.fftSize));
+            d.place(plan, segment, output);
+        }
+    } else {
+        {
+            QMutexLocker locker(&d.mutex);
+            d.plan = &plan;
+            d.source = &source;
+            d.nextCapture = 0;
+            d.captured = 0;
+            d.released = 0;
+            if (!d.threadStarted) {
+                d.thread.start(QThread::HighPriority);
+                d.threadStarted = true;
+            }
+            d.changed.wakeAll();
+        }
+
+        for (int k = 0; k < count; ++k) {
+            const int slot = k & 1;
+            {
+                QMutexLocker locker(&d.mutex);
+                while (d.captured <= k) {
+                    d.changed.wait(&d.mutex);
+                }
+            }
+
+            // Pencereleme kopyası tamponu serbest bırakır; k+2 yakalanabilir
+            d.load(plan, d.buffers[slot].data(), d.counts[slot]);
+            {
+                QMutexLocker locker(&d.mutex);
+                d.released = k + 1;
+                d.changed.wakeAll();
+            }
+            d.place(plan, plan.segments[k], output);
+        }
+
+        QMutexLocker locker(&d.mutex);
+        d.plan = nullptr;
+        d.source = nullptr;
+    }
+
+    d.lastTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+double SweepStitcher::lastSweepTime() const
+{
+    return pimpl->lastTime;
+}
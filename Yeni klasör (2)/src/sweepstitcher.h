@@ -0,0 +1,44 @@
+#ifndef SWEEPSTITCHER_H
+#define SWEEPSTITCHER_H
+
+#include <complex>
+#include <functional>
+#include <memory>
+#include "sweepplanner.h"
+
+// SweepPlan'daki segmentleri yakalayıp tek trace'e (dBm) birleştirir.
+// Yakalama kalıcı bir yardımcı thread'de yürür: segment k işlenirken
+// (pencere, FFT, güç, dB) segment k+1 için LO ayarlanır ve IQ alınır. İki
+// IQ tamponu dönüşümlü kullanılır; tampon pencerelenip çalışma tamponuna
+// alınır alınmaz yakalamaya geri verilir. Aynı FFT boyutunda tekrarlanan
+// sweep'ler bellek ayırmaz. Tek çağıran içindir.
+class SweepStitcher {
+public:
+    // LO'yu centerFreq'e ayarlar ve en çok count örnek yazar; yazılan
+    // örnek sayısını döndürür (eksik kısım sıfırla doldurulur). Boru
+    // hattı açıkken yakalama thread'inden çağrılır.
+    using SegmentSource = std::function<int(double centerFreq,
+                                            std::complex<float>* iq, int count)>;
+
+    SweepStitcher();
+    ~SweepStitcher();
+
+    SweepStitcher(const SweepStitcher&) = delete;
+    SweepStitcher& operator=(const SweepStitcher&) = delete;
+
+    // Kapalıyken segmentler çağıran thread'de sırayla yakalanır
+    void setPipelined(bool enabled);
+    bool isPipelined() const;
+
+    // output plan.outputBins eleman olmalı. Geçersiz planda false.
+    bool run(const SweepPlan& plan, const SegmentSource& source, double* output);
+
+    // Son run() çağrısının süresi (s)
+    double lastSweepTime() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pimpl;
+};
+
+#endif // SWEEPSTITCHER_H
@@ -0,0 +1,79 @@
+#include "tracedecimator.h"
+#include <algorithm>
+#include <cmath>
+
+template <typename T>
+void TraceDecimator::append(const double* x, const T* y, int index)
+{
+    outKeys.push_back(x[index]);
+    outValues.push_back(static_cast<double>(y[index]));
+}
+
+int TraceDecimator::decimate(const double* x, const double* y, int count,
+                             double lower, double upper, int columns)
+{
+    return decimateValues(x, y, count, lower, upper, columns);
+}
+
+int TraceDecimator::decimate(const double* x, const float* y, int count,
+                             double lower, double upper, int columns)
+{
+    return decimateValues(x, y, count, lower, upper, columns);
+}
+
+template <typename T>
+int TraceDecimator::decimateValues(const double* x, const T* y, int count,
+                                   double lower, double upper, int columns)
+{
+    outKeys.clear();
+    outValues.clear();
+    if (!x || !y || count <= 0)
+        return 0;
+
+    // Görünür aralık ikili arama ile bulunur, iki yandan birer komşu eklenir
+    int first = static_cast<int>(std::lower_bound(x, x + count, lower) - x);
+    int last = static_cast<int>(std::upper_bound(x, x + count, upper) - x);
+    first = std::max(first - 1, 0);
+    last = std::min(last + 1, count);
+
+    columns = std::max(columns, 1);
+    outKeys.reserve(2 * columns + 2);
+    outValues.reserve(2 * columns + 2);
+
+    // Piksel sayısından az nokta varsa seyreltmeye gerek yok
+    if (last - first <= 2 * columns || upper <= lower) {
+        for (int i = first; i < last; ++i) {
+            append(x, y, i);
+        }
+        return size();
+    }
+
+    // Komşu noktalar -1 ve columns sütunlarına düşer, kendi başlarına kalır
+    const double scale = columns / (upper - lower);
+    auto columnOf = [&](int i) {
+        const double c = std::floor((x[i] - lower) * scale);
+        return static_cast<int>(std::clamp(c, -1.0, static_cast<double>(columns)));
+    };
+
+    int i = first;
+    while (i < last) {
+        const int column = columnOf(i);
+        int minIndex = i;
+        int maxIndex = i;
+        for (++i; i < last && columnOf(i) == column; ++i) {
+            if (y[i] < y[minIndex])
+                minIndex = i;
+            if (y[i] > y[maxIndex])
+                maxIndex = i;
+        }
+
+        // Anahtarlar sıralı kalsın diye önce gelen önce eklenir
+        if (minIndex == maxIndex) {
+            append(x, y, minIndex);
+        } else {
+            append(x, y, std::min(minIndex, maxIndex));
+            append(x, y, std::max(minIndex, maxIndex));
+        }
+    }
+    return size();
+}
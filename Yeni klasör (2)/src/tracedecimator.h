@@ -0,0 +1,36 @@
+#ifndef TRACEDECIMATOR_H
+#define TRACEDECIMATOR_H
+
+#include <vector>
+
+// Görüntüleme için tepe korumalı seyreltme. Görünür aralıktaki noktalar
+// piksel sütunlarına bölünür; her sütundan en küçük ve en büyük değer
+// (orijinal sıralarıyla) tutulur. Böylece çizilen nokta sayısı en fazla
+// 2 * sütun olur ve tek binlik spurlar hiçbir yakınlaştırmada kaybolmaz.
+// Çıkış tamponları çağrılar arasında korunur; sabit boyutta bellek ayırmaz.
+class TraceDecimator {
+public:
+    // x artan sırada olmalı. [lower, upper] dışındaki birer komşu nokta da
+    // eklenir ki çizgi eksen kenarına kadar uzansın. Nokta sayısını döndürür.
+    int decimate(const double* x, const double* y, int count,
+                 double lower, double upper, int columns);
+    // Trace işlemcisinin float çıkışları için
+    int decimate(const double* x, const float* y, int count,
+                 double lower, double upper, int columns);
+
+    const std::vector<double>& keys() const { return outKeys; }
+    const std::vector<double>& values() const { return outValues; }
+    int size() const { return static_cast<int>(outKeys.size()); }
+
+private:
+    std::vector<double> outKeys;
+    std::vector<double> outValues;
+
+    template <typename T>
+    int decimateValues(const double* x, const T* y, int count,
+                       double lower, double upper, int columns);
+    template <typename T>
+    void append(const double* x, const T* y, int index);
+};
+
+#endif // TRACEDECIMATOR_H
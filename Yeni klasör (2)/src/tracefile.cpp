@@ -0,0 +1,549 @@
+#include "tracefile.h"
+#include "sweep.h"
+#include <QFile>
+#include <QMutexLocker>
+#include <QObject>
+#include <QtEndian>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace {
+
+constexpr char TRACE_MAGIC[4] = {'B', 'B', 'T', 'R'};
+constexpr char INDEX_MAGIC[4] = {'B', 'B', 'T', 'I'};
+constexpr char RECORD_MAGIC[4] = {'B', 'B', 'T', 'S'};
+
+// 64 bitte tüm dosya tek seferde eşlenir; 32 bitte kayıt kayıt
+constexpr bool MAP_WHOLE_FILE = sizeof(void*) >= 8;
+
+quint64 doubleBits(double value)
+{
+    quint64 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+double bitsToDouble(quint64 bits)
+{
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Kayıt başlığının alanları
+struct RecordInfo {
+    qint64 timestamp{0};
+    double startFreq{0.0};
+    double stepFreq{0.0};
+    quint32 count{0};
+
+    qint64 bytes() const
+    {
+        return TraceFileHeader::RECORD_HEADER_SIZE + qint64(count) * qint64(sizeof(float));
+    }
+
+    void write(char* out) const
+    {
+        qToLittleEndian<qint64>(timestamp, out);
+        qToLittleEndian<quint64>(doubleBits(startFreq), out + 8);
+        qToLittleEndian<quint64>(doubleBits(stepFreq), out + 16);
+        qToLittleEndian<quint32>(count, out + 24);
+        std::memcpy(out + 28, RECORD_MAGIC, sizeof(RECORD_MAGIC));
+    }
+
+    // Kurtarma taramasında kayıt sınırı doğrulaması
+    static bool matches(const char* in)
+    {
+        return std::memcmp(in + 28, RECORD_MAGIC, sizeof(RECORD_MAGIC)) == 0;
+    }
+
+    void read(const char* in)
+    {
+        timestamp = qFromLittleEndian<qint64>(in);
+        startFreq = bitsToDouble(qFromLittleEndian<quint64>(in + 8));
+        stepFreq = bitsToDouble(qFromLittleEndian<quint64>(in + 16));
+        count = qFromLittleEndian<quint32>(in + 24);
+    }
+};
+
+} // namespace
+
+void TraceFileHeader::write(char* out) const
+{
+    std::memset(out, 0, HEADER_SIZE);
+    std::memcpy(out, TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    qToLittleEndian<quint32>(VERSION, out + 4);
+    qToLittleEndian<quint32>(HEADER_SIZE, out + 8);
+    qToLittleEndian<quint64>(doubleBits(settings.centerFreq), out + 16);
+    qToLittleEndian<quint64>(doubleBits(settings.span), out + 24);
+    qToLittleEndian<quint64>(doubleBits(settings.refLevel), out + 32);
+    qToLittleEndian<quint64>(doubleBits(settings.sampleRate), out + 40);
+    qToLittleEndian<qint32>(settings.rbw, out + 48);
+    qToLittleEndian<qint32>(settings.vbw, out + 52);
+    qToLittleEndian<qint64>(startTime, out + 56);
+}
+
+bool TraceFileHeader::read(const char* in, QString& error)
+{
+    if (!matches(in, HEADER_SIZE)) {
+        error = QObject::tr("Geçersiz trace dosyası");
+        return false;
+    }
+    if (qFromLittleEndian<quint32>(in + 4) != VERSION
+        || qFromLittleEndian<quint32>(in + 8) != quint32(HEADER_SIZE)) {
+        error = QObject::tr("Desteklenmeyen dosya versiyonu");
+        return false;
+    }
+
+    settings.centerFreq = bitsToDouble(qFromLittleEndian<quint64>(in + 16));
+    settings.span = bitsToDouble(qFromLittleEndian<quint64>(in + 24));
+    settings.refLevel = bitsToDouble(qFromLittleEndian<quint64>(in + 32));
+    settings.sampleRate = bitsToDouble(qFromLittleEndian<quint64>(in + 40));
+    settings.rbw = qFromLittleEndian<qint32>(in + 48);
+    settings.vbw = qFromLittleEndian<qint32>(in + 52);
+    startTime = qFromLittleEndian<qint64>(in + 56);
+    return true;
+}
+
+bool TraceFileHeader::matches(const char* data, qint64 size)
+{
+    return size >= qint64(sizeof(TRACE_MAGIC))
+        && std::memcmp(data, TRACE_MAGIC, sizeof(TRACE_MAGIC)) == 0;
+}
+
+// PIMPL implementation
+struct TraceFileWriter::Impl {
+    QFile file;
+    QString error;
+    qint64 position{0};
+    std::vector<char> record;   // Kayıt başlığı + float32 sütun
+    std::vector<char> index;    // INDEX_ENTRY_SIZE'lık girişler
+    quint64 count{0};
+    bool failed{false};         // Bir yazma başarısız oldu; ekleme yapılmaz
+
+    bool write(const char* data, qint64 length)
+    {
+        if (file.write(data, length) != length) {
+            error = file.errorString();
+            // Yarım kalan kayıt kesilir: dosya son tam kayıtta biter ve
+            // indeks ofsetleri geçerli kalır
+            failed = true;
+            file.resize(position);
+            file.seek(position);
+            return false;
+        }
+        position += length;
+        return true;
+    }
+};
+
+TraceFileWriter::TraceFileWriter()
+    : pimpl(std::make_unique<Impl>())
+{
+}
+
+TraceFileWriter::~TraceFileWriter()
+{
+    close();
+}
+
+bool TraceFileWriter::open(const QString& filename, const BBSettings& settings, qint64 startTime)
+{
+    close();
+    QMutexLocker locker(&mutex);
+    Impl& d = *pimpl;
+    d.error.clear();
+    d.file.setFileName(filename);
+    // Tamponsuz: kayıt zaten tek parça yazılır ve hata anında diskte ne
+    // olduğu bilinir (yarım kayıt kesilebilir)
+    if (!d.file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Unbuffered)) {
+        d.error = d.file.errorString();
+        return false;
+    }
+
+    TraceFileHeader info;
+    info.settings = settings;
+    info.startTime = startTime;
+    char header[TraceFileHeader::HEADER_SIZE];
+    info.write(header);
+    d.position = 0;
+    d.index.clear();
+    d.count = 0;
+    d.failed = false;
+    if (!d.write(header, sizeof(header))) {
+        d.file.close();
+        return false;
+    }
+    return true;
+}
+
+bool TraceFileWriter::close()
+{
+    QMutexLocker locker(&mutex);
+    Impl& d = *pimpl;
+    if (!d.file.isOpen())
+        return true;
+
+    char trailer[TraceFileHeader::TRAILER_SIZE];
+    qToLittleEndian<quint64>(quint64(d.position), trailer);
+    qToLittleEndian<quint64>(d.count, trailer + 8);
+    std::memcpy(trailer + 16, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    qToLittleEndian<quint32>(TraceFileHeader::VERSION, trailer + 20);
+
+    // Hatadan sonra da o ana kadarki kayıtlar indekslenir, ama oturum
+    // eksik kaldığından sonuç false olur
+    const bool appended = !d.failed;
+    const bool ok = d.write(d.index.data(), qint64(d.index.size()))
+        && d.write(trailer, sizeof(trailer))
+        && d.file.flush()
+        && appended;
+    if (!ok && d.error.isEmpty()) {
+        d.error = d.file.errorString();
+    }
+    d.file.close();
+    d.index.clear();
+    d.index.shrink_to_fit();
+    return ok;
+}
+
+bool TraceFileWriter::isOpen() const
+{
+    QMutexLocker locker(&mutex);
+    return pimpl->file.isOpen();
+}
+
+QString TraceFileWriter::errorString() const
+{
+    QMutexLocker locker(&mutex);
+    return pimpl->error;
+}
+
+QString TraceFileWriter::fileName() const
+{
+    QMutexLocker locker(&mutex);
+    return pimpl->file.fileName();
+}
+
+bool TraceFileWriter::append(qint64 timestamp, double startFreq, double stepFreq,
+                             const double* amplitudes, int count)
+{
+    QMutexLocker locker(&mutex);
+    Impl& d = *pimpl;
+    if (!d.file.isOpen() || d.failed || count < 0 || (count > 0 && !amplitudes))
+        return false;
+
+    RecordInfo info;
+    info.timestamp = timestamp;
+    info.startFreq = startFreq;
+    info.stepFreq = stepFreq;
+    info.count = quint32(count);
+    d.record.resize(size_t(info.bytes()));
+    info.write(d.record.data());
+
+    // Küçük-endian float32 sütun; big-endian sistemde bayt sırası çevrilir
+    float* column = reinterpret_cast<float*>(d.record.data() + TraceFileHeader::RECORD_HEADER_SIZE);
+    for (int i = 0; i < count; ++i) {
+        column[i] = static_cast<float>(amplitudes[i]);
+    }
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+    qbswap<quint32>(column, count, column);
+#endif
+
+    const qint64 offset = d.position;
+    if (!d.write(d.record.data(), qint64(d.record.size())))
+        return false;
+
+    char entry[TraceFileHeader::INDEX_ENTRY_SIZE];
+    qToLittleEndian<quint64>(quint64(offset), entry);
+    qToLittleEndian<qint64>(timestamp, entry + 8);
+    d.index.insert(d.index.end(), entry, entry + sizeof(entry));
+    ++d.count;
+    return true;
+}
+
+bool TraceFileWriter::append(const Sweep& sweep)
+{
+    const FrequencyAxisPtr& axis = sweep.axis();
+    const double start = axis ? axis->start() : 0.0;
+    const double step = axis ? axis->step() : 0.0;
+    return append(sweep.timestamp(), start, step, sweep.amplitudes().constData(), sweep.size());
+}
+
+quint64 TraceFileWriter::sweepCount() const
+{
+    QMutexLocker locker(&mutex);
+    return pimpl->count;
+}
+
+quint64 TraceFileWriter::bytesWritten() const
+{
+    QMutexLocker locker(&mutex);
+    return quint64(pimpl->position);
+}
+
+// PIMPL implementation
+struct TraceFileReader::Impl {
+    QFile file;
+    TraceFileHeader header;
+    QString error;
+    qint64 fileSize{0};
+    std::vector<char> index;   // INDEX_ENTRY_SIZE'lık girişler
+    int count{0};
+    bool recovered{false};
+
+    // 64 bitte tüm dosya; 32 bitte son istenen kayıt
+    uchar* mapped{nullptr};
+    qint64 mappedOffset{0};
+
+    void unmap()
+    {
+        if (mapped) {
+            file.unmap(mapped);
+            mapped = nullptr;
+        }
+    }
+
+    qint64 offsetOf(int k) const
+    {
+        return qint64(qFromLittleEndian<quint64>(index.data() + size_t(k) * TraceFileHeader::INDEX_ENTRY_SIZE));
+    }
+
+    qint64 timestampOf(int k) const
+    {
+        return qFromLittleEndian<qint64>(index.data() + size_t(k) * TraceFileHeader::INDEX_ENTRY_SIZE + 8);
+    }
+
+    // Son ekteki indeksi okur; son ek yoksa ya da tutarsızsa false
+    bool readIndex()
+    {
+        if (fileSize < TraceFileHeader::HEADER_SIZE + TraceFileHeader::TRAILER_SIZE)
+            return false;
+        char trailer[TraceFileHeader::TRAILER_SIZE];
+        if (!file.seek(fileSize - TraceFileHeader::TRAILER_SIZE)
+            || file.read(trailer, sizeof(trailer)) != qint64(sizeof(trailer))
+            || std::memcmp(trailer + 16, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0
+            || qFromLittleEndian<quint32>(trailer + 20) != TraceFileHeader::VERSION)
+            return false;
+
+        const quint64 indexOffset = qFromLittleEndian<quint64>(trailer);
+        const quint64 sweeps = qFromLittleEndian<quint64>(trailer + 8);
+        const quint64 indexBytes = sweeps * TraceFileHeader::INDEX_ENTRY_SIZE;
+        if (indexOffset < quint64(TraceFileHeader::HEADER_SIZE)
+            || sweeps > quint64(std::numeric_limits<int>::max())
+            || indexOffset + indexBytes + TraceFileHeader::TRAILER_SIZE != quint64(fileSize))
+            return false;
+
+        index.resize(size_t(indexBytes));
+        if (!file.seek(qint64(indexOffset))
+            || file.read(index.data(), qint64(indexBytes)) != qint64(indexBytes))
+            return false;
+        count = int(sweeps);
+        return true;
+    }
+
+    // Son ek yok (kayıt yarıda kaldı): kayıt başlıkları sırayla okunur;
+    // dosya sonundaki yarım kayıt ya da yarım yazılmış indeks atılır
+    bool scanRecords()
+    {
+        index.clear();
+        count = 0;
+        qint64 offset = TraceFileHeader::HEADER_SIZE;
+        char header[TraceFileHeader::RECORD_HEADER_SIZE];
+        while (offset + TraceFileHeader::RECORD_HEADER_SIZE <= fileSize
+               && count < std::numeric_limits<int>::max()) {
+            if (!file.seek(offset) || file.read(header, sizeof(header)) != qint64(sizeof(header)))
+                return false;
+            if (!RecordInfo::matches(header))
+                break;
+            RecordInfo info;
+            info.read(header);
+            if (offset + info.bytes() > fileSize)
+                break;
+            char entry[TraceFileHeader::INDEX_ENTRY_SIZE];
+            qToLittleEndian<quint64>(quint64(offset), entry);
+            qToLittleEndian<qint64>(info.timestamp, entry + 8);
+            index.insert(index.end(), entry, entry + sizeof(entry));
+            ++count;
+            offset += info.bytes();
+        }
+        recovered = true;
+        return true;
+    }
+};
+
+TraceFileReader::TraceFileReader()
+    : pimpl(std::make_unique<Impl>())
+{
+}
+
+TraceFileReader::~TraceFileReader()
+{
+    close();
+}
+
+bool TraceFileReader::open(const QString& filename)
+{
+    close();
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+    // Görünümler dosyadaki küçük-endian float'ları doğrudan gösterir
+    pimpl->error = QObject::tr("Büyük-endian sistemlerde eşleme desteklenmiyor");
+    return false;
+#endif
+
+    Impl& d = *pimpl;
+    d.file.setFileName(filename);
+    if (!d.file.open(QIODevice::ReadOnly)) {
+        d.error = d.file.errorString();
+        return false;
+    }
+    d.fileSize = d.file.size();
+
+    char header[TraceFileHeader::HEADER_SIZE];
+    if (d.file.read(header, sizeof(header)) != qint64(sizeof(header))) {
+        d.error = QObject::tr("Geçersiz trace dosyası");
+        close();
+        return false;
+    }
+    if (!d.header.read(header, d.error)) {
+        close();
+        return false;
+    }
+    if (!d.readIndex() && !d.scanRecords()) {
+        d.error = d.file.errorString();
+        close();
+        return false;
+    }
+
+    if (MAP_WHOLE_FILE && d.count > 0) {
+        d.mapped = d.file.map(0, d.fileSize);
+        if (!d.mapped) {
+            d.error = d.file.errorString();
+            close();
+            return false;
+        }
+    }
+    return true;
+}
+
+void TraceFileReader::close()
+{
+    Impl& d = *pimpl;
+    d.unmap();
+    d.file.close();
+    d.header = TraceFileHeader();
+    d.index.clear();
+    d.count = 0;
+    d.fileSize = 0;
+    d.recovered = false;
+}
+
+bool TraceFileReader::isOpen() const
+{
+    return pimpl->file.isOpen();
+}
+
+QString TraceFileReader::errorString() const
+{
+    return pimpl->error;
+}
+
+const TraceFileHeader& TraceFileReader::header() const
+{
+    return pimpl->header;
+}
+
+int TraceFileReader::sweepCount() const
+{
+    return pimpl->count;
+}
+
+bool TraceFileReader::isRecovered() const
+{
+    return pimpl->recovered;
+}
+
+TraceFileReader::Record TraceFileReader::sweep(int k)
+{
+    Record record;
+    Impl& d = *pimpl;
+    if (k < 0 || k >= d.count)
+        return record;
+
+    const qint64 offset = d.offsetOf(k);
+    if (offset < TraceFileHeader::HEADER_SIZE
+        || offset + TraceFileHeader::RECORD_HEADER_SIZE > d.fileSize)
+        return record;
+
+    const char* base;
+    if (MAP_WHOLE_FILE) {
+        base = reinterpret_cast<const char*>(d.mapped) + offset;
+    } else {
+        // Kayıt başlığı okunup yalnız bu kayıt eşlenir
+        char header[TraceFileHeader::RECORD_HEADER_SIZE];
+        if (!d.file.seek(offset) || d.file.read(header, sizeof(header)) != qint64(sizeof(header)))
+            return record;
+        RecordInfo info;
+        info.read(header);
+        if (offset + info.bytes() > d.fileSize)
+            return record;
+        d.unmap();
+        d.mapped = d.file.map(offset, info.bytes());
+        if (!d.mapped) {
+            d.error = d.file.errorString();
+            return record;
+        }
+        base = reinterpret_cast<const char*>(d.mapped);
+    }
+
+    RecordInfo info;
+    info.read(base);
+    if (offset + info.bytes() > d.fileSize)
+        return record;
+    record.timestamp = info.timestamp;
+    record.startFreq = info.startFreq;
+    record.stepFreq = info.stepFreq;
+    record.count = int(info.count);
+    record.amplitudes = reinterpret_cast<const float*>(base + TraceFileHeader::RECORD_HEADER_SIZE);
+    return record;
+}
+
+qint64 TraceFileReader::timestamp(int k) const
+{
+    return k >= 0 && k < pimpl->count ? pimpl->timestampOf(k) : 0;
+}
+
+int TraceFileReader::sweepAt(qint64 timestamp) const
+{
+    const Impl& d = *pimpl;
+    int low = 0;
+    int high = d.count;
+    while (low < high) {
+        const int mid = low + (high - low) / 2;
+        if (d.timestampOf(mid) <= timestamp) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low - 1;
+}
+
+bool TraceFileReader::readSweep(int k, QVector<double>& frequencies, QVector<double>& amplitudes)
+{
+    const Record record = sweep(k);
+    if (!record.amplitudes) {
+        if (pimpl->error.isEmpty())
+            pimpl->error = QObject::tr("Bozuk dosya formatı");
+        return false;
+    }
+
+    frequencies.resize(record.count);
+    amplitudes.resize(record.count);
+    for (int i = 0; i < record.count; ++i) {
+        frequencies[i] = record.frequency(i);
+        amplitudes[i] = record.amplitudes[i];
+    }
+    return true;
+}
@@ -0,0 +1,130 @@
+#ifndef TRACEFILE_H
+#define TRACEFILE_H
+
+#include <QMutex>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+#include <memory>
+#include "bb_api.h"
+
+class Sweep;
+
+// Sütunlu ikili trace dosyası. Düzen (tüm alanlar küçük-endian, double'lar
+// IEEE 754 bit deseni):
+//  - Başlık (HEADER_SIZE): "BBTR", sürüm, başlık boyu, ayrılmış, merkez
+//    frekans, span, referans seviyesi, örnekleme hızı, RBW, VBW ve
+//    oturumun başlangıç zamanı (ms, epoch) — ayarların anlık görüntüsü.
+//  - Sweep kayıtları (RECORD_HEADER_SIZE + 4 * nokta): zaman (ms, epoch),
+//    başlangıç frekansı, frekans adımı, nokta sayısı, "BBTS"; ardından
+//    bitişik float32 genlik sütunu (dBm). Frekans ekseni nokta başına
+//    saklanmaz: f(i) = başlangıç + i * adım.
+//  - İndeks (INDEX_ENTRY_SIZE * sweep): her sweep için kayıt ofseti ve
+//    zamanı; ardından TRAILER_SIZE baytlık son ek: indeks ofseti, sweep
+//    sayısı, "BBTI", sürüm. k. sweep'e dosya sonundan tek okumayla gidilir.
+// Kapatılmadan yarıda kalan dosyada son ek yoktur; okuyucu indeksi
+// kayıtları sırayla tarayarak yeniden kurar.
+struct TraceFileHeader {
+    static constexpr int HEADER_SIZE = 64;
+    static constexpr int RECORD_HEADER_SIZE = 32;
+    static constexpr int INDEX_ENTRY_SIZE = 16;
+    static constexpr int TRAILER_SIZE = 24;
+    static constexpr quint32 VERSION = 1;
+
+    BBSettings settings;
+    qint64 startTime{0};   // ms, epoch
+
+    // HEADER_SIZE baytı out'a yazar
+    void write(char* out) const;
+    // HEADER_SIZE baytlık başlığı çözer; hatada açıklama error'a yazılır
+    bool read(const char* in, QString& error);
+    // Veri trace dosyası sihirli baytlarıyla mı başlıyor (eski JSON
+    // trace'lerden ayırmak için)
+    static bool matches(const char* data, qint64 size);
+};
+
+// Sweep'leri trace dosyasına ekler. Her kayıt tamponsuz tek write() ile
+// sırayla yazılır; indeks bellekte biriktirilir ve close()'da dosya
+// sonuna eklenir. append() ve close() farklı thread'lerden çağrılabilir
+// (örn. acquisition thread'i ekler, GUI kapatır).
+class TraceFileWriter {
+public:
+    TraceFileWriter();
+    ~TraceFileWriter();
+
+    TraceFileWriter(const TraceFileWriter&) = delete;
+    TraceFileWriter& operator=(const TraceFileWriter&) = delete;
+
+    bool open(const QString& filename, const BBSettings& settings, qint64 startTime);
+    // İndeksi ve son eki yazar; oturumda bir ekleme başarısız olduysa
+    // o ana kadarki kayıtlar yine indekslenir ama false döner
+    bool close();
+    bool isOpen() const;
+    QString errorString() const;
+    QString fileName() const;
+
+    // Genlikler float32'ye çevrilerek yazılır. Yazma hatasında yarım kayıt
+    // dosyadan kesilir ve oturum kapanana kadar sonraki eklemeler reddedilir.
+    bool append(qint64 timestamp, double startFreq, double stepFreq,
+                const double* amplitudes, int count);
+    bool append(const Sweep& sweep);
+
+    quint64 sweepCount() const;
+    quint64 bytesWritten() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pimpl;
+    mutable QMutex mutex;
+};
+
+// Trace dosyasını belleğe eşleyerek okur. Açılışta yalnızca başlık, son
+// ek ve indeks (tek read(), sweep başına 16 bayt) okunur; genlik
+// sütunları eşlenmiş sayfalardan kopyasız verilir, sweep(k) O(1)'dir.
+// 64 bit derlemede tüm dosya bir kez eşlenir; 32 bitte her sweep(k)
+// yalnız o kaydı eşler. Tek thread içindir.
+class TraceFileReader {
+public:
+    // Salt okunur sweep görünümü
+    struct Record {
+        qint64 timestamp{0};
+        double startFreq{0.0};
+        double stepFreq{0.0};
+        int count{0};
+        const float* amplitudes{nullptr};
+
+        double frequency(int index) const { return startFreq + index * stepFreq; }
+    };
+
+    TraceFileReader();
+    ~TraceFileReader();
+
+    TraceFileReader(const TraceFileReader&) = delete;
+    TraceFileReader& operator=(const TraceFileReader&) = delete;
+
+    bool open(const QString& filename);
+    void close();
+    bool isOpen() const;
+    QString errorString() const;
+
+    const TraceFileHeader& header() const;
+    int sweepCount() const;
+    // Son ek yoktu, indeks kayıtlar taranarak kuruldu
+    bool isRecovered() const;
+
+    // k. sweep; geçersiz k'da count 0. Görünüm close()'a kadar geçerlidir;
+    // 32 bit derlemede bir sonraki sweep() çağrısına kadar.
+    Record sweep(int k);
+    qint64 timestamp(int k) const;
+    // Zamanı timestamp'ten büyük olmayan son sweep (ikili arama); yoksa -1
+    int sweepAt(qint64 timestamp) const;
+
+    // k. sweep'i double frekans/genlik vektörlerine açar
+    bool readSweep(int k, QVector<double>& frequencies, QVector<double>& amplitudes);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pimpl;
+};
+
+#endif // TRACEFILE_H
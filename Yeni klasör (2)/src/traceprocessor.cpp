@@ -0,0 +1,358 @@
+#include "traceprocessor.h"
+#include "powerkernels.h"
+#include "sweep.h"
+#include <QMutex>
+#include <QMutexLocker>
+#include <algorithm>
+
+#if defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+#include <immintrin.h>
+#define TRACEPROCESSOR_AVX2 1
+#endif
+
+namespace {
+
+// Parça boyutu: giriş dB, mW ve ara tampon (3 x 4 KB) L1'de kalır
+constexpr int CHUNK = 1024;
+
+void toFloat(const double* src, float* dst, int n)
+{
+    int i = 0;
+#if defined(TRACEPROCESSOR_AVX2)
+    for (; i + 8 <= n; i += 8) {
+        const __m128 lo = _mm256_cvtpd_ps(_mm256_loadu_pd(src + i));
+        const __m128 hi = _mm256_cvtpd_ps(_mm256_loadu_pd(src + i + 4));
+        _mm256_storeu_ps(dst + i, _mm256_set_m128(hi, lo));
+    }
+#endif
+    for (; i < n; ++i) {
+        dst[i] = static_cast<float>(src[i]);
+    }
+}
+
+void maxInPlace(float* dst, const float* src, int n)
+{
+    int i = 0;
+#if defined(TRACEPROCESSOR_AVX2)
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(dst + i, _mm256_max_ps(_mm256_loadu_ps(dst + i), _mm256_loadu_ps(src + i)));
+    }
+#endif
+    for (; i < n; ++i) {
+        dst[i] = std::max(dst[i], src[i]);
+    }
+}
+
+void minInPlace(float* dst, const float* src, int n)
+{
+    int i = 0;
+#if defined(TRACEPROCESSOR_AVX2)
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(dst + i, _mm256_min_ps(_mm256_loadu_ps(dst + i), _mm256_loadu_ps(src + i)));
+    }
+#endif
+    for (; i < n; ++i) {
+        dst[i] = std::min(dst[i], src[i]);
+    }
+}
+
+// dst += weight * (src - dst)
+void blendInPlace(float* dst, const float* src, float weight, int n)
+{
+    int i = 0;
+#if defined(TRACEPROCESSOR_AVX2)
+    const __m256 w = _mm256_set1_ps(weight);
+    for (; i + 8 <= n; i += 8) {
+        const __m256 d = _mm256_loadu_ps(dst + i);
+        _mm256_storeu_ps(dst + i, _mm256_fmadd_ps(w, _mm256_sub_ps(_mm256_loadu_ps(src + i), d), d));
+    }
+#endif
+    for (; i < n; ++i) {
+        dst[i] += weight * (src[i] - dst[i]);
+    }
+}
+
+void addInPlace(float* dst, const float* src, int n)
+{
+    int i = 0;
+#if defined(TRACEPROCESSOR_AVX2)
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i), _mm256_loadu_ps(src + i)));
+    }
+#endif
+    for (; i < n; ++i) {
+        dst[i] += src[i];
+    }
+}
+
+void scaleTo(float* dst, const float* src, float scale, int n)
+{
+    int i = 0;
+#if defined(TRACEPROCESSOR_AVX2)
+    const __m256 s = _mm256_set1_ps(scale);
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_loadu_ps(src + i), s));
+    }
+#endif
+    for (; i < n; ++i) {
+        dst[i] = src[i] * scale;
+    }
+}
+
+} // namespace
+
+// PIMPL implementation
+struct TraceProcessor::Impl {
+    struct Trace {
+        TraceSettings settings;
+        std::vector<float> output;  // Gösterilen dBm; log ortalamada durumun kendisi
+        std::vector<float> power;   // Üstel güç ortalaması durumu (mW)
+        std::vector<float> block;   // Blok toplamı (dB ya da mW)
+        quint64 sweeps{0};          // Yeniden başlatmadan beri
+        int blockFill{0};           // Geçerli bloktaki sweep sayısı
+        bool blockDone{false};      // En az bir blok tamamlandı
+
+        // Bu sweep için hesaplanan adım
+        enum class Step { None, Copy, Max, Min, Blend, PowerBlend, Accumulate };
+        Step step{Step::None};
+        float weight{1.0f};
+        bool emitBlock{false};      // Blok ortalaması çıkışa yazılacak
+        float blockScale{1.0f};
+    };
+
+    mutable QMutex mutex;
+    std::array<Trace, TRACE_COUNT> traces;
+    int size{0};
+    quint64 axisVersion{0};
+    quint64 version{0};
+
+    // Parça tamponları
+    std::vector<float> inputDb = std::vector<float>(CHUNK);
+    std::vector<float> inputPower = std::vector<float>(CHUNK);
+    std::vector<float> scratch = std::vector<float>(CHUNK);
+
+    void reset(Trace& trace)
+    {
+        trace.sweeps = 0;
+        trace.blockFill = 0;
+        trace.blockDone = false;
+        if (trace.settings.mode == Mode::Off)
+            return;
+
+        trace.output.resize(size);
+        const bool powerMode = trace.settings.mode == Mode::PowerAverage;
+        const bool block = trace.settings.averaging == Averaging::Block
+            && (powerMode || trace.settings.mode == Mode::LogAverage);
+        if (powerMode && !block)
+            trace.power.resize(size);
+        if (block)
+            trace.block.resize(size);
+    }
+
+    void plan(Trace& trace)
+    {
+        const TraceSettings& s = trace.settings;
+        trace.emitBlock = false;
+        if (s.mode == Mode::Off) {
+            trace.step = Trace::Step::None;
+            return;
+        }
+
+        const bool first = ++trace.sweeps == 1;
+        const int n = std::max(s.averageCount, 1);
+        switch (s.mode) {
+        case Mode::Off:
+            break;
+        case Mode::ClearWrite:
+            trace.step = Trace::Step::Copy;
+            return;
+        case Mode::MaxHold:
+            trace.step = first ? Trace::Step::Copy : Trace::Step::Max;
+            return;
+        case Mode::MinHold:
+            trace.step = first ? Trace::Step::Copy : Trace::Step::Min;
+            return;
+        case Mode::PowerAverage:
+        case Mode::LogAverage:
+            break;
+        }
+
+        if (s.averaging == Averaging::Exponential) {
+            trace.weight = 1.0f / static_cast<float>(std::min<quint64>(trace.sweeps, n));
+            trace.step = s.mode == Mode::PowerAverage ? Trace::Step::PowerBlend : Trace::Step::Blend;
+            return;
+        }
+
+        // Blok: ilk blok dolana kadar birikmiş ortalama gösterilir, sonra
+        // yalnızca tamamlanan bloklar
+        trace.step = Trace::Step::Accumulate;
+        ++trace.blockFill;
+        trace.emitBlock = trace.blockFill == n || !trace.blockDone;
+        trace.blockScale = 1.0f / static_cast<float>(trace.blockFill);
+        if (trace.blockFill == n) {
+            trace.blockDone = true;
+        }
+    }
+
+    void apply(Trace& trace, int offset, int n)
+    {
+        float* out = trace.output.data() + offset;
+        const float* db = inputDb.data();
+        const bool power = trace.settings.mode == Mode::PowerAverage;
+
+        switch (trace.step) {
+        case Trace::Step::None:
+            return;
+        case Trace::Step::Copy:
+            std::copy(db, db + n, out);
+            return;
+        case Trace::Step::Max:
+            maxInPlace(out, db, n);
+            return;
+        case Trace::Step::Min:
+            minInPlace(out, db, n);
+            return;
+        case Trace::Step::Blend:
+            blendInPlace(out, db, trace.weight, n);
+            return;
+        case Trace::Step::PowerBlend: {
+            float* state = trace.power.data() + offset;
+            blendInPlace(state, inputPower.data(), trace.weight, n);
+            PowerKernels::linearToDb(state, out, n);
+            return;
+        }
+        case Trace::Step::Accumulate: {
+            float* acc = trace.block.data() + offset;
+            const float* in = power ? inputPower.data() : db;
+            if (trace.blockFill == 1) {
+                std::copy(in, in + n, acc);
+            } else {
+                addInPlace(acc, in, n);
+            }
+            if (trace.emitBlock) {
+                if (power) {
+                    scaleTo(scratch.data(), acc, trace.blockScale, n);
+                    PowerKernels::linearToDb(scratch.data(), out, n);
+                } else {
+                    scaleTo(out, acc, trace.blockScale, n);
+                }
+            }
+            return;
+        }
+        }
+    }
+};
+
+TraceProcessor::TraceProcessor()
+    : pimpl(std::make_unique<Impl>())
+{
+    // Varsayılan: birinci trace canlı sweep'i gösterir
+    pimpl->traces[0].settings.mode = Mode::ClearWrite;
+}
+
+TraceProcessor::~TraceProcessor() = default;
+
+void TraceProcessor::setTraceSettings(int trace, const TraceSettings& settings)
+{
+    if (trace < 0 || trace >= TRACE_COUNT)
+        return;
+
+    QMutexLocker locker(&pimpl->mutex);
+    Impl::Trace& t = pimpl->traces[trace];
+    t.settings = settings;
+    t.settings.averageCount = std::max(settings.averageCount, 1);
+    pimpl->reset(t);
+    ++pimpl->version;
+}
+
+TraceProcessor::TraceSettings TraceProcessor::traceSettings(int trace) const
+{
+    if (trace < 0 || trace >= TRACE_COUNT)
+        return TraceSettings();
+
+    QMutexLocker locker(&pimpl->mutex);
+    return pimpl->traces[trace].settings;
+}
+
+void TraceProcessor::restart()
+{
+    QMutexLocker locker(&pimpl->mutex);
+    for (auto& trace : pimpl->traces) {
+        pimpl->reset(trace);
+    }
+    ++pimpl->version;
+}
+
+void TraceProcessor::process(const Sweep& sweep)
+{
+    process(sweep.amplitudes().constData(), sweep.size(),
+            sweep.axis() ? sweep.axis()->version() : 0);
+}
+
+void TraceProcessor::process(const double* amplitudes, int count, quint64 axisVersion)
+{
+    if (!amplitudes || count <= 0)
+        return;
+
+    QMutexLocker locker(&pimpl->mutex);
+    if (count != pimpl->size || axisVersion != pimpl->axisVersion) {
+        pimpl->size = count;
+        pimpl->axisVersion = axisVersion;
+        for (auto& trace : pimpl->traces) {
+            pimpl->reset(trace);
+        }
+    }
+
+    bool needPower = false;
+    for (auto& trace : pimpl->traces) {
+        pimpl->plan(trace);
+        needPower |= trace.settings.mode == Mode::PowerAverage;
+    }
+
+    // Tek geçiş: her parça bir kez dönüştürülür, tüm trace'ler onu kullanır
+    for (int offset = 0; offset < count; offset += CHUNK) {
+        const int n = std::min(CHUNK, count - offset);
+        toFloat(amplitudes + offset, pimpl->inputDb.data(), n);
+        if (needPower) {
+            PowerKernels::dbToLinear(pimpl->inputDb.data(), pimpl->inputPower.data(), n);
+        }
+        for (auto& trace : pimpl->traces) {
+            pimpl->apply(trace, offset, n);
+        }
+    }
+
+    for (auto& trace : pimpl->traces) {
+        if (trace.blockFill == trace.settings.averageCount) {
+            trace.blockFill = 0;
+        }
+    }
+    ++pimpl->version;
+}
+
+bool TraceProcessor::copyTraces(std::array<std::vector<float>, TRACE_COUNT>& traces,
+                                quint64& version) const
+{
+    QMutexLocker locker(&pimpl->mutex);
+    if (version == pimpl->version)
+        return false;
+
+    for (int t = 0; t < TRACE_COUNT; ++t) {
+        const Impl::Trace& trace = pimpl->traces[t];
+        if (trace.settings.mode == Mode::Off || trace.sweeps == 0) {
+            traces[t].clear();
+        } else {
+            traces[t].assign(trace.output.begin(), trace.output.begin() + pimpl->size);
+        }
+    }
+    version = pimpl->version;
+    return true;
+}
+
+quint64 TraceProcessor::sweepCount(int trace) const
+{
+    if (trace < 0 || trace >= TRACE_COUNT)
+        return 0;
+
+    QMutexLocker locker(&pimpl->mutex);
+    return pimpl->traces[trace].sweeps;
+}
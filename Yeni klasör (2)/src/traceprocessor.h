@@ -0,0 +1,67 @@
+#ifndef TRACEPROCESSOR_H
+#define TRACEPROCESSOR_H
+
+#include <QtGlobal>
+#include <array>
+#include <memory>
+#include <vector>
+
+class Sweep;
+
+// Sweep'ler üzerinde trace matematiği: clear/write, max/min hold, güç
+// (mW) ve log (dB) ortalaması; ortalama üstel ya da N sweep'lik bloklar
+// halinde. Durum float tamponlarda yerinde güncellenir. Tüm trace'ler
+// tek geçişte işlenir: giriş L1'e sığan parçalar halinde bir kez float'a
+// (ve gerekiyorsa mW'a) çevrilir, her trace'in çekirdeği aynı parça
+// üzerinde çalışır. Acquisition thread'inden her sweep için çağrılır;
+// böylece ekranın atladığı sweep'ler de hold/ortalamaya girer.
+// Eksen değişince tüm trace'ler yeniden başlar.
+class TraceProcessor {
+public:
+    static constexpr int TRACE_COUNT = 3;
+
+    enum class Mode {
+        Off,
+        ClearWrite,
+        MaxHold,
+        MinHold,
+        PowerAverage,
+        LogAverage
+    };
+
+    enum class Averaging {
+        Exponential,  // Ağırlık 1/min(k, N): ilk N sweep'te tam ortalama
+        Block         // N sweep toplanır, blok bitince gösterilir
+    };
+
+    struct TraceSettings {
+        Mode mode{Mode::Off};
+        Averaging averaging{Averaging::Exponential};
+        int averageCount{10};
+    };
+
+    TraceProcessor();
+    ~TraceProcessor();
+
+    // Ayar değişince o trace yeniden başlar (herhangi bir thread'den)
+    void setTraceSettings(int trace, const TraceSettings& settings);
+    TraceSettings traceSettings(int trace) const;
+    void restart();
+
+    void process(const Sweep& sweep);
+    void process(const double* amplitudes, int count, quint64 axisVersion);
+
+    // GUI tarafı: son kopyadan beri yeni sweep işlendiyse trace'leri
+    // (dBm) kopyalar; kapalı trace'ler boş döner
+    bool copyTraces(std::array<std::vector<float>, TRACE_COUNT>& traces,
+                    quint64& version) const;
+
+    // Yeniden başlatmadan beri trace'e giren sweep sayısı
+    quint64 sweepCount(int trace) const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pimpl;
+};
+
+#endif // TRACEPROCESSOR_H
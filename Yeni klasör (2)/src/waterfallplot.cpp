@@ -1,96 +1,485 @@
-cmake_minimum_required(VERSION 3.15)
-    project(BB60C_Analyzer VERSION 1.0)
-
-    set(CMAKE_CXX_STANDARD 17)
-    set(CMAKE_CXX_STANDARD_REQUIRED ON)
-    set(CMAKE_AUTOMOC ON)
-    set(CMAKE_AUTORCC ON)
-    set(CMAKE_AUTOUIC ON)
-
-# Qt yolunu belirt
-    set(CMAKE_PREFIX_PATH "C:/Qt/6.5.2/msvc2019_64")
-
-    find_package(Qt6 REQUIRED COMPONENTS
-                     Core
-                         Gui
-                             Widgets
-                                 PrintSupport
-                 )
-
-# Kaynak dosyaları
-    set(SOURCES
-            src/main.cpp
-              src/mainwindow.cpp
-              src/waterfallplot.cpp
-              src/demodulator.cpp
-              src/analyzer.cpp
-              src/datamanager.cpp
-              resources.qrc
-        )
-
-    set(HEADERS
-            src/mainwindow.h
-              src/waterfallplot.h
-              src/demodulator.h
-              src/analyzer.h
-              src/datamanager.h
-        )
-
-# QCustomPlot'u ekle
-    add_library(qcustomplot STATIC
-                    include/qcustomplot/qcustomplot.cpp
-                )
-
-    target_include_directories(qcustomplot PUBLIC
-                                   include/qcustomplot
-                                   ${Qt6Core_INCLUDE_DIRS}
-                               ${Qt6Widgets_INCLUDE_DIRS}
-                               ${Qt6Gui_INCLUDE_DIRS}
-                               ${Qt6PrintSupport_INCLUDE_DIRS}
-                               )
-
-    target_link_libraries(qcustomplot PUBLIC
-                              Qt6::Core
-                                  Qt6::Gui
-                                      Qt6::Widgets
-                                          Qt6::PrintSupport
-                          )
-
-# Executable oluştur
-    add_executable(BB60C_Analyzer
-                       ${SOURCES}
-                   ${HEADERS}
-                   )
-
-# Include dizinleri
-    target_include_directories(BB60C_Analyzer PRIVATE
-                                   ${CMAKE_SOURCE_DIR}/src
-                                   ${CMAKE_SOURCE_DIR}/include
-                                   ${CMAKE_SOURCE_DIR}/include/qcustomplot
-                                   ${CMAKE_SOURCE_DIR}/include/bb_api
-                               )
-
-# Kütüphaneleri bağla
-    target_link_libraries(BB60C_Analyzer PRIVATE
-                              Qt6::Core
-                                  Qt6::Gui
-                                      Qt6::Widgets
-                                          Qt6::PrintSupport
-                                              qcustomplot
-                          )
-
-# DLL'leri kopyala
-    add_custom_command(TARGET BB60C_Analyzer POST_BUILD
-                               COMMAND ${CMAKE_COMMAND} -E copy_if_different
-                           "${CMAKE_SOURCE_DIR}/include/bb_api/bb_api.dll"
-                           $<TARGET_FILE_DIR:BB60C_Analyzer>
-                       )
-
-# Qt DLL'lerini kopyala
-    if(WIN32)
-    add_custom_command(TARGET BB60C_Analyzer POST_BUILD
-                               COMMAND ${CMAKE_COMMAND} -E copy_directory
-                           "${CMAKE_PREFIX_PATH}/bin"
-                           $<TARGET_FILE_DIR:BB60C_Analyzer>
-                       )
-    endif()
+#include "waterfallplot.h"
+#include <QPainter>
+#include <QPaintEvent>
+#include <QResizeEvent>
+#include <QMouseEvent>
+#include <QWheelEvent>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace {
+constexpr double MAX_ZOOM = 64.0;
+constexpr double ZOOM_STEP = 1.25;     // Tekerlek adımı başına
+
+// Geçmiş halkası için bellek bütçesi; aşılırsa satırlar tepe korunarak
+// seyreltilir (en az MIN_ROW_BINS bin saklanır)
+constexpr size_t HISTORY_BUDGET_BYTES = 64u * 1024 * 1024;
+constexpr int MIN_ROW_BINS = 2048;
+
+// inBins değeri outBins gruba bölünür, her grubun en büyüğü alınır
+template <typename T>
+void decimateMax(const T* in, int inBins, float* out, int outBins)
+{
+    for (int i = 0; i < outBins; ++i) {
+        const int first = static_cast<int>(static_cast<qint64>(i) * inBins / outBins);
+        const int last = std::max(static_cast<int>(static_cast<qint64>(i + 1) * inBins / outBins),
+                                  first + 1);
+        T peak = in[first];
+        for (int b = first + 1; b < last; ++b) {
+            peak = std::max(peak, in[b]);
+        }
+        out[i] = static_cast<float>(peak);
+    }
+}
+}
+
+// PIMPL implementation
+struct WaterfallPlot::Impl {
+    // Geçmiş: sabit kapasiteli float satır halkası, tek ardışık ayırma.
+    // Yeni satır yalnızca head'i ilerletir; bellek kaydırılmaz.
+    std::vector<float> rows;
+    int capacity{0};
+    int rowBins{0};         // Saklanan satır genişliği
+    int sourceBins{0};      // Gelen spektrumun bin sayısı
+    int head{0};            // En yeni satırın slotu
+    int count{0};
+
+    // age = 0 en yeni satır
+    const float* row(int age) const
+    {
+        return rows.data() + static_cast<size_t>((head - age + capacity) % capacity) * rowBins;
+    }
+
+    int rowBinsFor(int bins, int lines) const
+    {
+        const size_t fit = HISTORY_BUDGET_BYTES / (sizeof(float) * std::max(lines, 1));
+        return std::min(bins, std::max(MIN_ROW_BINS, static_cast<int>(fit)));
+    }
+
+    // Kapasite veya satır genişliği değişir; en yeni satırlar korunur
+    void reshape(int lines, int bins)
+    {
+        const int newBins = rowBinsFor(bins, lines);
+        const int keep = std::min(count, lines);
+        std::vector<float> resized(static_cast<size_t>(lines) * newBins);
+        for (int age = 0; age < keep; ++age) {
+            float* dst = resized.data() + static_cast<size_t>(keep - 1 - age) * newBins;
+            if (newBins == rowBins) {
+                std::copy(row(age), row(age) + rowBins, dst);
+            } else {
+                decimateMax(row(age), rowBins, dst, newBins);
+            }
+        }
+        rows.swap(resized);
+        capacity = lines;
+        rowBins = newBins;
+        sourceBins = bins;
+        count = keep;
+        head = keep > 0 ? keep - 1 : 0;
+    }
+
+    void push(const QVector<double>& spectrum)
+    {
+        head = (head + 1) % capacity;
+        count = std::min(count + 1, capacity);
+        float* dst = rows.data() + static_cast<size_t>(head) * rowBins;
+        if (rowBins == sourceBins) {
+            std::transform(spectrum.constBegin(), spectrum.constEnd(), dst,
+                           [](double v) { return static_cast<float>(v); });
+        } else {
+            decimateMax(spectrum.constData(), sourceBins, dst, rowBins);
+        }
+    }
+
+    // Piksel sütunu -> [bin başlangıcı, sonraki sütunun başlangıcı).
+    // Genişlik, bin sayısı veya görünür aralık değiştiğinde yeniden hesaplanır.
+    std::vector<int> columnBins;
+    int mappedBins{-1};
+    int mappedWidth{-1};
+
+    // Görünür frekans aralığı, tam aralığın oranı olarak (yakınlaştırma/kaydırma)
+    double viewStart{0.0};
+    double viewStop{1.0};
+
+    // Genlik -> LUT indeksi: (amp - minAmp) * lutScale
+    double lutScale{0.0};
+};
+
+WaterfallPlot::WaterfallPlot(QWidget *parent)
+    : QWidget(parent)
+    , pimpl(std::make_unique<Impl>())
+    , maxHistory(1000)
+    , scrollSpeed(1)
+    , timePerLine(100)
+    , startFreq(0)
+    , stopFreq(1e9)
+    , minAmp(-120)
+    , maxAmp(0)
+    , zoomLevel(1.0)
+    , isDragging(false)
+{
+    // Arkaplan rengini siyah yap
+    setBackgroundRole(QPalette::Base);
+    setAutoFillBackground(true);
+
+    QPalette pal = palette();
+    pal.setColor(QPalette::Base, Qt::black);
+    setPalette(pal);
+
+    setMouseTracking(true);
+    initializeColorMap();
+    pimpl->reshape(maxHistory, 0);
+}
+
+WaterfallPlot::~WaterfallPlot() = default;
+
+void WaterfallPlot::addData(const QVector<double>& spectrum)
+{
+    if (spectrum.isEmpty())
+        return;
+
+    // Bin sayısı değiştiyse (yeni ayarlar) eski geçmiş anlamını yitirir
+    if (spectrum.size() != pimpl->sourceBins) {
+        pimpl->count = 0;
+        pimpl->reshape(maxHistory, spectrum.size());
+        updateBuffer();
+    }
+
+    // Halkaya yaz; maliyet geçmiş derinliğinden bağımsız
+    pimpl->push(spectrum);
+
+    // Görüntü halkası bir satır ilerler, yalnızca yeni satır çizilir
+    updateRow(spectrum);
+    update();
+}
+
+void WaterfallPlot::setFrequencyRange(double start, double stop)
+{
+    startFreq = start;
+    stopFreq = stop;
+    update();
+}
+
+void WaterfallPlot::setAmplitudeRange(double min, double max)
+{
+    minAmp = min;
+    maxAmp = max;
+    // LUT ölçeği yeni aralıkla kurulmadan geçmiş yeniden çizilmemeli
+    updateScrollRegion();
+    updateBuffer();
+    update();
+}
+
+void WaterfallPlot::setColorMap(const QVector<QRgb>& map)
+{
+    colorMap = map;
+    initializeColorMap();
+    updateBuffer();
+    update();
+}
+
+void WaterfallPlot::setHistorySize(int size)
+{
+    maxHistory = std::max(size, 1);
+    pimpl->reshape(maxHistory, pimpl->sourceBins);
+    updateBuffer();
+    update();
+}
+
+void WaterfallPlot::setScrollSpeed(int linesPerUpdate)
+{
+    scrollSpeed = std::max(linesPerUpdate, 1);
+    updateBuffer();
+    update();
+}
+
+void WaterfallPlot::setTimePerLine(int ms)
+{
+    timePerLine = std::max(ms, 1);
+}
+
+void WaterfallPlot::clear()
+{
+    pimpl->count = 0;
+    updateBuffer();
+    update();
+}
+
+void WaterfallPlot::setMinLevel(double level)
+{
+    setAmplitudeRange(level, maxAmp);
+}
+
+void WaterfallPlot::setMaxLevel(double level)
+{
+    setAmplitudeRange(minAmp, level);
+}
+
+void WaterfallPlot::setTimeSpan(int seconds)
+{
+    setHistorySize(seconds * 1000 / timePerLine);
+}
+
+void WaterfallPlot::updatePlot(const QVector<double>& frequencies,
+                               const QVector<double>& amplitudes)
+{
+    if (!frequencies.isEmpty()) {
+        startFreq = frequencies.first();
+        stopFreq = frequencies.last();
+    }
+    addData(amplitudes);
+}
+
+void WaterfallPlot::paintEvent(QPaintEvent *)
+{
+    if (buffer.isNull())
+        return;
+
+    // Görüntü halkası: [imageHead, h) üste, [0, imageHead) alta
+    QPainter painter(this);
+    const int w = buffer.width();
+    const int h = buffer.height();
+    painter.drawImage(QPoint(0, 0), buffer, QRect(0, imageHead, w, h - imageHead));
+    if (imageHead > 0)
+        painter.drawImage(QPoint(0, h - imageHead), buffer, QRect(0, 0, w, imageHead));
+}
+
+void WaterfallPlot::resizeEvent(QResizeEvent *)
+{
+    createImage();
+    updateBuffer();
+}
+
+void WaterfallPlot::mousePressEvent(QMouseEvent* event)
+{
+    if (event->button() == Qt::LeftButton) {
+        isDragging = true;
+        lastMousePos = event->position().toPoint();
+    }
+}
+
+void WaterfallPlot::mouseMoveEvent(QMouseEvent* event)
+{
+    const QPoint pos = event->position().toPoint();
+    if (isDragging && (event->buttons() & Qt::LeftButton)) {
+        handlePan(pos);
+    } else {
+        isDragging = false;
+    }
+    emitCursorData(pos);
+}
+
+void WaterfallPlot::wheelEvent(QWheelEvent* event)
+{
+    handleZoom(event->position().toPoint(), event->angleDelta().y());
+    event->accept();
+}
+
+void WaterfallPlot::createImage()
+{
+    buffer = QImage(size(), QImage::Format_RGB32);
+    buffer.fill(Qt::black);
+    imageHead = 0;
+    updateScrollRegion();
+}
+
+void WaterfallPlot::updateBuffer()
+{
+    if (buffer.isNull())
+        return;
+
+    buffer.fill(Qt::black);
+    imageHead = 0;
+
+    // Her geçmiş satırı scrollSpeed piksel satırı kaplar. Eskiden yeniye
+    // çizilir; alttan taşan son satır sarıp yenilerin altında kalır.
+    const int rows = std::min(pimpl->count, (buffer.height() + scrollSpeed - 1) / scrollSpeed);
+    for (int age = rows - 1; age >= 0; --age) {
+        renderLine(pimpl->row(age), age * scrollSpeed);
+    }
+}
+
+void WaterfallPlot::updateRow(const QVector<double>&)
+{
+    if (buffer.isNull())
+        return;
+
+    scrollImage();
+    renderLine(pimpl->row(0), imageHead);
+}
+
+void WaterfallPlot::scrollImage()
+{
+    // Piksel kaydırılmaz; görüntü halkasının başı scrollSpeed satır geri alınır
+    const int h = buffer.height();
+    imageHead = ((imageHead - scrollSpeed) % h + h) % h;
+}
+
+void WaterfallPlot::renderLine(const float* row, int y)
+{
+    const int width = buffer.width();
+    const int height = buffer.height();
+    const int bins = pimpl->rowBins;
+    if (width <= 0 || height <= 0 || bins <= 0)
+        return;
+
+    if (pimpl->mappedBins != bins || pimpl->mappedWidth != width)
+        updateColumnMap(bins);
+
+    // Birden çok bin düşen sütunda en büyük değer alınır; dar spurlar kaybolmaz
+    QRgb* line = reinterpret_cast<QRgb*>(buffer.scanLine(y % height));
+    const int* columns = pimpl->columnBins.data();
+    const QRgb* lut = colorMap.constData();
+    const int lastIndex = colorMap.size() - 1;
+    const float offset = static_cast<float>(minAmp);
+    const float scale = static_cast<float>(pimpl->lutScale);
+
+    for (int x = 0; x < width; ++x) {
+        const int first = std::min(columns[x], bins - 1);
+        const int last = std::max(columns[x + 1], first + 1);
+        float peak = row[first];
+        for (int b = first + 1; b < last; ++b) {
+            peak = std::max(peak, row[b]);
+        }
+        const float level = (peak - offset) * scale;
+        line[x] = lut[level > 0.0f ? (level < lastIndex ? static_cast<int>(level) : lastIndex) : 0];
+    }
+
+    // Satır kalınlığı scrollSpeed'den büyükse ilk satır kopyalanır (halka sarar)
+    const int lines = std::min(scrollSpeed, height);
+    for (int i = 1; i < lines; ++i) {
+        std::memcpy(buffer.scanLine((y + i) % height), line, sizeof(QRgb) * width);
+    }
+}
+
+void WaterfallPlot::updateColumnMap(int bins)
+{
+    const int width = buffer.width();
+    pimpl->columnBins.resize(width + 1);
+    pimpl->mappedBins = bins;
+    pimpl->mappedWidth = width;
+    if (width <= 0 || bins <= 0)
+        return;
+
+    const double start = pimpl->viewStart * bins;
+    const double step = (pimpl->viewStop - pimpl->viewStart) * bins / width;
+    for (int x = 0; x <= width; ++x) {
+        const int bin = static_cast<int>(std::floor(start + x * step));
+        pimpl->columnBins[x] = std::clamp(bin, 0, bins);
+    }
+}
+
+QRgb WaterfallPlot::amplitudeToColor(double amplitude) const
+{
+    const int lastIndex = colorMap.size() - 1;
+    const double level = (amplitude - minAmp) * pimpl->lutScale;
+    return colorMap[level > 0.0 ? (level < lastIndex ? static_cast<int>(level) : lastIndex) : 0];
+}
+
+void WaterfallPlot::initializeColorMap()
+{
+    if (colorMap.isEmpty())
+        createDefaultColorMap();
+    updateScrollRegion();
+}
+
+void WaterfallPlot::createDefaultColorMap()
+{
+    // Sıcak renk haritası (mavi->kırmızı), COLOR_MAP_SIZE girişlik LUT
+    colorMap.resize(COLOR_MAP_SIZE);
+    for (int i = 0; i < COLOR_MAP_SIZE; ++i) {
+        const double normalized = static_cast<double>(i) / (COLOR_MAP_SIZE - 1);
+        if (normalized < 0.25)
+            colorMap[i] = qRgb(0, 0, int(255 * normalized * 4));
+        else if (normalized < 0.5)
+            colorMap[i] = qRgb(0, int(255 * (normalized - 0.25) * 4), 255);
+        else if (normalized < 0.75)
+            colorMap[i] = qRgb(int(255 * (normalized - 0.5) * 4), 255,
+                               int(255 * (1 - (normalized - 0.5) * 4)));
+        else
+            colorMap[i] = qRgb(255, int(255 * (1 - (normalized - 0.75) * 4)), 0);
+    }
+}
+
+void WaterfallPlot::updateScrollRegion()
+{
+    // Sütun haritası ve LUT ölçeği bir sonraki çizimde yeniden kurulur
+    pimpl->mappedBins = -1;
+    const double range = maxAmp - minAmp;
+    pimpl->lutScale = range > 0.0 ? colorMap.size() / range : 0.0;
+}
+
+QPoint WaterfallPlot::dataToScreen(double freq, double time)
+{
+    const double span = stopFreq - startFreq;
+    const double fraction = span != 0.0 ? (freq - startFreq) / span : 0.0;
+    const double x = (fraction - pimpl->viewStart) / (pimpl->viewStop - pimpl->viewStart) * width();
+    const double y = time * 1000.0 / timePerLine * scrollSpeed;
+    return QPoint(static_cast<int>(x), static_cast<int>(y));
+}
+
+void WaterfallPlot::screenToData(const QPoint& pos, double& freq, double& time)
+{
+    const double fraction = pimpl->viewStart
+        + (pimpl->viewStop - pimpl->viewStart) * pos.x() / std::max(width(), 1);
+    freq = startFreq + fraction * (stopFreq - startFreq);
+    time = static_cast<double>(pos.y() / scrollSpeed) * timePerLine / 1000.0;
+}
+
+void WaterfallPlot::handleZoom(const QPoint& pos, int delta)
+{
+    if (delta == 0)
+        return;
+
+    // İmlecin altındaki frekans sabit kalacak şekilde yakınlaştır
+    const double anchor = static_cast<double>(pos.x()) / std::max(width(), 1);
+    const double focus = pimpl->viewStart + anchor * (pimpl->viewStop - pimpl->viewStart);
+
+    zoomLevel = std::clamp(delta > 0 ? zoomLevel * ZOOM_STEP : zoomLevel / ZOOM_STEP, 1.0, MAX_ZOOM);
+    const double visible = 1.0 / zoomLevel;
+    const double start = std::clamp(focus - anchor * visible, 0.0, 1.0 - visible);
+    pimpl->viewStart = start;
+    pimpl->viewStop = start + visible;
+
+    updateScrollRegion();
+    updateBuffer();
+    update();
+}
+
+void WaterfallPlot::handlePan(const QPoint& pos)
+{
+    const int dx = pos.x() - lastMousePos.x();
+    lastMousePos = pos;
+    if (dx == 0 || zoomLevel <= 1.0)
+        return;
+
+    const double visible = pimpl->viewStop - pimpl->viewStart;
+    const double start = std::clamp(pimpl->viewStart - visible * dx / std::max(width(), 1),
+                                    0.0, 1.0 - visible);
+    pimpl->viewStart = start;
+    pimpl->viewStop = start + visible;
+
+    updateScrollRegion();
+    updateBuffer();
+    update();
+}
+
+void WaterfallPlot::emitCursorData(const QPoint& pos)
+{
+    double freq = 0.0;
+    double time = 0.0;
+    screenToData(pos, freq, time);
+    emit frequencyAtCursor(freq);
+    emit timeAtCursor(time);
+
+    // İmlecin altındaki geçmiş satırındaki genlik
+    const int age = pos.y() / scrollSpeed;
+    if (age >= 0 && age < pimpl->count && stopFreq != startFreq) {
+        const double fraction = (freq - startFreq) / (stopFreq - startFreq);
+        const int bin = std::clamp(static_cast<int>(fraction * pimpl->rowBins),
+                                   0, pimpl->rowBins - 1);
+        emit amplitudeAtCursor(pimpl->row(age)[bin]);
+    }
+}
@@ -54,8 +54,9 @@ private:
     std::unique_ptr<Impl> pimpl;
 
     // Görüntüleme parametreleri
+    // Görüntü de halka: en yeni satır imageHead'de, paintEvent iki parça çizer
     QImage buffer;
-    QVector<QVector<double>> history;
+    int imageHead{0};
     QVector<QRgb> colorMap;
     int maxHistory;
     int scrollSpeed;
@@ -72,6 +73,9 @@ private:
     QPoint lastMousePos;
     bool isDragging;
 
+    // Renk LUT'u giriş sayısı
+    static constexpr int COLOR_MAP_SIZE = 1024;
+
     // Yardımcı fonksiyonlar
     void updateBuffer();
     QRgb amplitudeToColor(double amplitude) const;
@@ -90,6 +94,9 @@ private:
     void scrollImage();
     void updateRow(const QVector<double>& amplitudes);
     void createImage();
+    // Tek satırı scanLine üzerine LUT ile yazar
+    void renderLine(const float* row, int y);
+    void updateColumnMap(int bins);
 
 signals:
     void frequencyAtCursor(double freq);